@@ -360,6 +360,11 @@ public:
     // was unable to continue reading!
     Future<Nothing> readerClosed() const;
 
+    // Returns Nothing once all data written so far has been read,
+    // or the read-end of the pipe is closed. This allows writers
+    // to produce data no faster than it is consumed.
+    Future<Nothing> drained();
+
     // Comparison operators useful for checking connection equality.
     bool operator==(const Writer& other) const { return data == other.data; }
     bool operator!=(const Writer& other) const { return !(*this == other); }
@@ -407,6 +412,9 @@ private:
     // empty strings as they serve as a signal for end-of-file.
     std::queue<std::string> writes;
 
+    // Represents writers waiting for the unread writes to be read.
+    std::queue<Owned<Promise<Nothing>>> drains;
+
     // Signals when the read-end is closed before the write-end.
     Promise<Nothing> readerClosure;
 
@@ -0,0 +1,288 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License
+
+
+#ifndef __PROCESS_METRICS_HISTOGRAM_HPP__
+#define __PROCESS_METRICS_HISTOGRAM_HPP__
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+
+#include <process/clock.hpp>
+#include <process/future.hpp>
+#include <process/statistics.hpp>
+
+#include <process/metrics/metric.hpp>
+
+#include <stout/duration.hpp>
+#include <stout/option.hpp>
+
+namespace process {
+namespace metrics {
+
+// A Metric that records the distribution of a value, e.g., a latency,
+// into a fixed number of log-linear buckets. Unlike a Metric with a
+// window, which keeps every sample and sorts them when a snapshot is
+// taken, a Histogram uses constant memory, records values without
+// locking and can be merged with other histograms.
+//
+// Each power of two between 2^MIN_EXPONENT and 2^MAX_EXPONENT is split
+// into SUB_BUCKETS linear buckets, hence the percentiles reported by
+// 'statistics' are within 1/SUB_BUCKETS (relative) of the recorded
+// values. Values below that range are recorded in the first bucket
+// and values above it in the last one.
+//
+// The snapshot exports the mean of the recorded values under the name
+// of the Histogram, and the count, min, max and percentiles under the
+// same prefix (e.g., "<name>/p99").
+class Histogram : public Metric
+{
+public:
+  static constexpr int MIN_EXPONENT = -10;
+  static constexpr int MAX_EXPONENT = 40;
+  static constexpr size_t SUB_BUCKETS = 16;
+  static constexpr size_t BUCKETS =
+    1 + (MAX_EXPONENT - MIN_EXPONENT) * SUB_BUCKETS;
+
+  // 'name' is the unique name for the instance of Histogram being
+  // constructed. It will be the key exposed in the JSON endpoint.
+  explicit Histogram(const std::string& name)
+    : Metric(name, None()),
+      data(new Data()) {}
+
+  virtual ~Histogram() {}
+
+  // Returns the mean of the recorded values.
+  virtual Future<double> value() const
+  {
+    const uint64_t count = data->count.load();
+    if (count == 0) {
+      return Failure("No value");
+    }
+
+    return data->sum.load() / count;
+  }
+
+  virtual Option<Statistics<double>> statistics() const
+  {
+    // Take a copy of the buckets first so that the percentiles are
+    // consistent with the count even if values are being recorded.
+    std::array<uint64_t, BUCKETS> buckets;
+    uint64_t count = 0;
+
+    for (size_t i = 0; i < BUCKETS; i++) {
+      buckets[i] = data->buckets[i].load();
+      count += buckets[i];
+    }
+
+    if (count == 0) {
+      return None();
+    }
+
+    Statistics<double> statistics;
+
+    statistics.count = count;
+
+    statistics.min = data->min.load();
+    statistics.max = data->max.load();
+
+    statistics.p50 = percentile(buckets, count, 0.5, statistics);
+    statistics.p90 = percentile(buckets, count, 0.90, statistics);
+    statistics.p95 = percentile(buckets, count, 0.95, statistics);
+    statistics.p99 = percentile(buckets, count, 0.99, statistics);
+    statistics.p999 = percentile(buckets, count, 0.999, statistics);
+    statistics.p9999 = percentile(buckets, count, 0.9999, statistics);
+
+    return statistics;
+  }
+
+  void record(double value)
+  {
+    if (value < 0.0 || std::isnan(value)) {
+      value = 0.0;
+    }
+
+    data->buckets[bucket(value)].fetch_add(1);
+    data->count.fetch_add(1);
+
+    accumulate(&data->sum, value);
+    minimize(&data->min, value);
+    maximize(&data->max, value);
+  }
+
+  // Records the time it takes for 'future' to complete, in units of
+  // 'T' (e.g., `Milliseconds`).
+  template <typename T, typename U>
+  Future<U> time(const Future<U>& future)
+  {
+    // We need to take a copy of 'this' here to ensure that the
+    // Histogram is not destroyed in the interim.
+    Histogram that(*this);
+    const Time start = Clock::now();
+
+    future
+      .onAny([that, start](const Future<U>&) mutable {
+        that.record(T(Clock::now() - start).value());
+      });
+
+    return future;
+  }
+
+  // Adds the values recorded by 'that' to this Histogram.
+  void merge(const Histogram& that)
+  {
+    uint64_t count = 0;
+
+    for (size_t i = 0; i < BUCKETS; i++) {
+      const uint64_t n = that.data->buckets[i].load();
+      data->buckets[i].fetch_add(n);
+      count += n;
+    }
+
+    if (count == 0) {
+      return;
+    }
+
+    data->count.fetch_add(count);
+
+    accumulate(&data->sum, that.data->sum.load());
+    minimize(&data->min, that.data->min.load());
+    maximize(&data->max, that.data->max.load());
+  }
+
+  void reset()
+  {
+    for (size_t i = 0; i < BUCKETS; i++) {
+      data->buckets[i].store(0);
+    }
+
+    data->count.store(0);
+    data->sum.store(0.0);
+    data->min.store(std::numeric_limits<double>::infinity());
+    data->max.store(0.0);
+  }
+
+private:
+  struct Data
+  {
+    Data()
+      : count(0),
+        sum(0.0),
+        min(std::numeric_limits<double>::infinity()),
+        max(0.0)
+    {
+      for (size_t i = 0; i < BUCKETS; i++) {
+        buckets[i].store(0);
+      }
+    }
+
+    std::array<std::atomic<uint64_t>, BUCKETS> buckets;
+    std::atomic<uint64_t> count;
+    std::atomic<double> sum;
+    std::atomic<double> min;
+    std::atomic<double> max;
+  };
+
+  // Returns the index of the bucket 'value' falls into.
+  static size_t bucket(double value)
+  {
+    if (value < std::ldexp(1.0, MIN_EXPONENT)) {
+      return 0;
+    }
+
+    // 'value' = 'fraction' * 2^'exponent' with 'fraction' in [0.5, 1).
+    int exponent;
+    const double fraction = std::frexp(value, &exponent);
+
+    if (exponent > MAX_EXPONENT) {
+      return BUCKETS - 1;
+    }
+
+    const size_t sub = std::min(
+        static_cast<size_t>((fraction - 0.5) * 2 * SUB_BUCKETS),
+        SUB_BUCKETS - 1);
+
+    return 1 + (exponent - MIN_EXPONENT - 1) * SUB_BUCKETS + sub;
+  }
+
+  // Returns the value in the middle of 'bucket'.
+  static double midpoint(size_t bucket)
+  {
+    if (bucket == 0) {
+      return std::ldexp(0.5, MIN_EXPONENT);
+    }
+
+    const size_t exponent = (bucket - 1) / SUB_BUCKETS;
+    const size_t sub = (bucket - 1) % SUB_BUCKETS;
+
+    return std::ldexp(
+        0.5 + (sub + 0.5) / (2 * SUB_BUCKETS),
+        static_cast<int>(exponent) + MIN_EXPONENT + 1);
+  }
+
+  // Returns the estimated 'percentile' of the values in 'buckets',
+  // bounded by the exact minimum and maximum.
+  static double percentile(
+      const std::array<uint64_t, BUCKETS>& buckets,
+      uint64_t count,
+      double percentile,
+      const Statistics<double>& statistics)
+  {
+    const uint64_t rank = std::max<uint64_t>(
+        1, static_cast<uint64_t>(std::ceil(percentile * count)));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; i++) {
+      seen += buckets[i];
+      if (seen >= rank) {
+        return std::min(
+            std::max(midpoint(i), statistics.min), statistics.max);
+      }
+    }
+
+    return statistics.max;
+  }
+
+  static void accumulate(std::atomic<double>* target, double value)
+  {
+    double current = target->load();
+    while (!target->compare_exchange_weak(current, current + value)) {}
+  }
+
+  static void minimize(std::atomic<double>* target, double value)
+  {
+    double current = target->load();
+    while (value < current &&
+           !target->compare_exchange_weak(current, value)) {}
+  }
+
+  static void maximize(std::atomic<double>* target, double value)
+  {
+    double current = target->load();
+    while (value > current &&
+           !target->compare_exchange_weak(current, value)) {}
+  }
+
+  std::shared_ptr<Data> data;
+};
+
+} // namespace metrics {
+} // namespace process {
+
+#endif // __PROCESS_METRICS_HISTOGRAM_HPP__
@@ -41,7 +41,7 @@ public:
     return data->name;
   }
 
-  Option<Statistics<double>> statistics() const
+  virtual Option<Statistics<double>> statistics() const
   {
     Option<Statistics<double>> statistics = None();
 
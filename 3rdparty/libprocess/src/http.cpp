@@ -422,13 +422,20 @@ Pipe::Writer Pipe::writer() const
 
 Future<string> Pipe::Reader::read()
 {
+  Future<string> future;
+  queue<Owned<Promise<Nothing>>> drains;
+
   synchronized (data->lock) {
     if (data->readEnd == Reader::CLOSED) {
       return Failure("closed");
     } else if (!data->writes.empty()) {
-      Future<string> future = data->writes.front();
+      future = data->writes.front();
       data->writes.pop();
-      return future;
+
+      // Extract the writers waiting for the pipe to be drained.
+      if (data->writes.empty()) {
+        std::swap(data->drains, drains);
+      }
     } else if (data->writeEnd == Writer::CLOSED) {
       return ""; // End-of-file.
     } else if (data->writeEnd == Writer::FAILED) {
@@ -439,6 +446,15 @@ Future<string> Pipe::Reader::read()
       return data->reads.back()->future();
     }
   }
+
+  // NOTE: We set the promises outside the critical section to avoid
+  // triggering callbacks that try to reacquire the lock.
+  while (!drains.empty()) {
+    drains.front()->set(Nothing());
+    drains.pop();
+  }
+
+  return future;
 }
 
 
@@ -468,6 +484,7 @@ bool Pipe::Reader::close()
   bool closed = false;
   bool notify = false;
   queue<Owned<Promise<string>>> reads;
+  queue<Owned<Promise<Nothing>>> drains;
 
   synchronized (data->lock) {
     if (data->readEnd == Reader::OPEN) {
@@ -476,8 +493,10 @@ bool Pipe::Reader::close()
         data->writes.pop();
       }
 
-      // Extract the pending reads so we can fail them.
+      // Extract the pending reads so we can fail them, and the
+      // writers waiting for the pipe to be drained.
       std::swap(data->reads, reads);
+      std::swap(data->drains, drains);
 
       closed = true;
       data->readEnd = Reader::CLOSED;
@@ -495,6 +514,11 @@ bool Pipe::Reader::close()
       reads.pop();
     }
 
+    while (!drains.empty()) {
+      drains.front()->set(Nothing());
+      drains.pop();
+    }
+
     if (notify) {
       data->readerClosure.set(Nothing());
     } else {
@@ -599,6 +623,19 @@ Future<Nothing> Pipe::Writer::readerClosed() const
 }
 
 
+Future<Nothing> Pipe::Writer::drained()
+{
+  synchronized (data->lock) {
+    if (data->writes.empty() || data->readEnd == Reader::CLOSED) {
+      return Nothing();
+    }
+
+    data->drains.push(Owned<Promise<Nothing>>(new Promise<Nothing>()));
+    return data->drains.back()->future();
+  }
+}
+
+
 namespace header {
 
 Try<WWWAuthenticate> WWWAuthenticate::create(const string& value)
@@ -500,6 +500,45 @@ TEST_P(HTTPTest, PipeFailure)
 }
 
 
+TEST(HTTPTest, PipeDrained)
+{
+  http::Pipe pipe;
+  http::Pipe::Reader reader = pipe.reader();
+  http::Pipe::Writer writer = pipe.writer();
+
+  // An empty pipe is drained.
+  EXPECT_TRUE(writer.drained().isReady());
+
+  // The pipe is drained once all the writes have been read.
+  EXPECT_TRUE(writer.write("hello"));
+  EXPECT_TRUE(writer.write("world"));
+
+  Future<Nothing> drained = writer.drained();
+  EXPECT_TRUE(drained.isPending());
+
+  AWAIT_EQ("hello", reader.read());
+  EXPECT_TRUE(drained.isPending());
+
+  AWAIT_EQ("world", reader.read());
+  EXPECT_TRUE(drained.isReady());
+
+  // A write that is handed to a waiting read leaves the pipe drained.
+  Future<string> read = reader.read();
+  EXPECT_TRUE(writer.write("!"));
+  AWAIT_EQ("!", read);
+  EXPECT_TRUE(writer.drained().isReady());
+
+  // Closing the read end also satisfies waiting writers.
+  EXPECT_TRUE(writer.write("unread"));
+
+  drained = writer.drained();
+  EXPECT_TRUE(drained.isPending());
+
+  EXPECT_TRUE(reader.close());
+  EXPECT_TRUE(drained.isReady());
+}
+
+
 TEST(HTTPTest, PipeReadAll)
 {
   {
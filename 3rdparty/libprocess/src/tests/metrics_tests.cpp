@@ -14,6 +14,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include <stout/base64.hpp>
 #include <stout/duration.hpp>
@@ -30,7 +31,9 @@
 
 #include <process/metrics/counter.hpp>
 #include <process/metrics/gauge.hpp>
+#include <process/metrics/histogram.hpp>
 #include <process/metrics/metrics.hpp>
+#include <process/metrics/push_gauge.hpp>
 #include <process/metrics/timer.hpp>
 
 namespace authentication = process::http::authentication;
@@ -47,6 +50,8 @@ using http::Unauthorized;
 
 using metrics::Counter;
 using metrics::Gauge;
+using metrics::Histogram;
+using metrics::PushGauge;
 using metrics::Timer;
 
 using process::Clock;
@@ -61,6 +66,7 @@ using process::UPID;
 
 using std::map;
 using std::string;
+using std::vector;
 
 class GaugeProcess : public Process<GaugeProcess>
 {
@@ -141,6 +147,136 @@ TEST_F(MetricsTest, Counter)
 }
 
 
+TEST_F(MetricsTest, PushGauge)
+{
+  PushGauge gauge("test/push_gauge");
+
+  AWAIT_READY(metrics::add(gauge));
+
+  AWAIT_EXPECT_EQ(0.0, gauge.value());
+
+  ++gauge;
+  AWAIT_EXPECT_EQ(1.0, gauge.value());
+
+  gauge += 42;
+  AWAIT_EXPECT_EQ(43.0, gauge.value());
+
+  --gauge;
+  AWAIT_EXPECT_EQ(42.0, gauge.value());
+
+  gauge -= 42;
+  AWAIT_EXPECT_EQ(0.0, gauge.value());
+
+  gauge = 42;
+  AWAIT_EXPECT_EQ(42.0, gauge.value());
+
+  // Copies share the same value.
+  PushGauge copy = gauge;
+  ++copy;
+  AWAIT_EXPECT_EQ(43.0, gauge.value());
+
+  EXPECT_NONE(gauge.statistics());
+
+  AWAIT_READY(metrics::remove(gauge));
+}
+
+
+TEST_F(MetricsTest, Histogram)
+{
+  Histogram histogram("test/histogram");
+
+  AWAIT_READY(metrics::add(histogram));
+
+  AWAIT_EXPECT_FAILED(histogram.value());
+  EXPECT_NONE(histogram.statistics());
+
+  for (int i = 1; i <= 1000; ++i) {
+    histogram.record(i);
+  }
+
+  AWAIT_EXPECT_EQ(500.5, histogram.value());
+
+  Option<Statistics<double>> statistics = histogram.statistics();
+  ASSERT_SOME(statistics);
+
+  EXPECT_EQ(1000u, statistics->count);
+  EXPECT_DOUBLE_EQ(1.0, statistics->min);
+  EXPECT_DOUBLE_EQ(1000.0, statistics->max);
+
+  // The percentiles are estimated within the relative width of a
+  // bucket.
+  const double error = 1.0 / Histogram::SUB_BUCKETS;
+
+  EXPECT_NEAR(500.0, statistics->p50, 500.0 * error);
+  EXPECT_NEAR(900.0, statistics->p90, 900.0 * error);
+  EXPECT_NEAR(990.0, statistics->p99, 990.0 * error);
+  EXPECT_GE(1000.0, statistics->p9999);
+
+  // Merging a histogram adds its values.
+  Histogram other("test/other");
+  for (int i = 1001; i <= 2000; ++i) {
+    other.record(i);
+  }
+
+  histogram.merge(other);
+
+  statistics = histogram.statistics();
+  ASSERT_SOME(statistics);
+
+  EXPECT_EQ(2000u, statistics->count);
+  EXPECT_DOUBLE_EQ(1.0, statistics->min);
+  EXPECT_DOUBLE_EQ(2000.0, statistics->max);
+  EXPECT_NEAR(1000.0, statistics->p50, 1000.0 * error);
+
+  histogram.reset();
+  EXPECT_NONE(histogram.statistics());
+
+  AWAIT_READY(metrics::remove(histogram));
+}
+
+
+TEST_F(MetricsTest, SnapshotHistogram)
+{
+  UPID upid("metrics", process::address());
+
+  Histogram histogram("test/histogram");
+
+  AWAIT_READY(metrics::add(histogram));
+
+  histogram.record(1.0);
+  histogram.record(3.0);
+
+  Future<Response> response = http::get(upid, "snapshot");
+
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(OK().status, response);
+
+  Try<JSON::Object> responseJSON =
+      JSON::parse<JSON::Object>(response->body);
+
+  ASSERT_SOME(responseJSON);
+
+  // The mean is exported under the name of the histogram.
+  ASSERT_EQ(1u, responseJSON->values.count("test/histogram"));
+  EXPECT_DOUBLE_EQ(
+      2.0,
+      responseJSON->values["test/histogram"].as<JSON::Number>().as<double>());
+
+  const vector<string> suffixes =
+    {"count", "min", "max", "p50", "p90", "p95", "p99", "p999", "p9999"};
+
+  foreach (const string& suffix, suffixes) {
+    EXPECT_EQ(1u, responseJSON->values.count("test/histogram/" + suffix));
+  }
+
+  EXPECT_EQ(
+      2,
+      responseJSON->values["test/histogram/count"]
+        .as<JSON::Number>().as<int64_t>());
+
+  AWAIT_READY(metrics::remove(histogram));
+}
+
+
 TEST_F(MetricsTest, THREADSAFE_Gauge)
 {
   GaugeProcess process;
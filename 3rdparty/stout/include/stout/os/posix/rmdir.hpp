@@ -15,12 +15,18 @@
 
 #include <fts.h>
 #include <unistd.h>
+
+#include <sys/stat.h>
+
 #include <string>
 
 #include <glog/logging.h>
 
 #include <stout/error.hpp>
+#include <stout/lambda.hpp>
+#include <stout/none.hpp>
 #include <stout/nothing.hpp>
+#include <stout/option.hpp>
 #include <stout/path.hpp>
 #include <stout/stringify.hpp>
 #include <stout/try.hpp>
@@ -39,12 +45,17 @@ namespace os {
 // By default rmdir aborts when an error occurs during the deletion of
 // any file but if 'continueOnError' is set to true, rmdir logs the error
 // and continues with the next file.
+// In recursive mode, `removed` is invoked with the path and the status
+// (as obtained before the deletion) of every file and directory that
+// has been deleted, e.g., to account for the freed disk space.
 #ifndef __sun // FTS is not available on Solaris.
 inline Try<Nothing> rmdir(
     const std::string& directory,
     bool recursive = true,
     bool removeRoot = true,
-    bool continueOnError = false)
+    bool continueOnError = false,
+    const Option<lambda::function<
+        void(const std::string&, const struct stat&)>>& removed = None())
 {
   unsigned int errorCount = 0;
 
@@ -79,17 +90,21 @@ inline Try<Nothing> rmdir(
             continue;
           }
 
-          if (::rmdir(node->fts_path) < 0 && errno != ENOENT) {
-            if (continueOnError) {
-              LOG(ERROR) << "Failed to delete directory "
-                         << path::join(directory, node->fts_path)
-                         << ": " << os::strerror(errno);
-              ++errorCount;
-            } else {
-              Error error = ErrnoError();
-              fts_close(tree);
-              return error;
+          if (::rmdir(node->fts_path) < 0) {
+            if (errno != ENOENT) {
+              if (continueOnError) {
+                LOG(ERROR) << "Failed to delete directory "
+                           << path::join(directory, node->fts_path)
+                           << ": " << os::strerror(errno);
+                ++errorCount;
+              } else {
+                Error error = ErrnoError();
+                fts_close(tree);
+                return error;
+              }
             }
+          } else if (removed.isSome()) {
+            removed.get()(node->fts_path, *node->fts_statp);
           }
           break;
         // `FTS_DEFAULT` would include any file type which is not
@@ -100,17 +115,21 @@ inline Try<Nothing> rmdir(
         // `FTS_SLNONE` should never be the case as we don't set
         // `FTS_COMFOLLOW` or `FTS_LOGICAL`. Adding here for completion.
         case FTS_SLNONE:
-          if (::unlink(node->fts_path) < 0 && errno != ENOENT) {
-            if (continueOnError) {
-              LOG(ERROR) << "Failed to delete path "
-                         << path::join(directory, node->fts_path)
-                         << ": " << os::strerror(errno);
-              ++errorCount;
-            } else {
-              Error error = ErrnoError();
-              fts_close(tree);
-              return error;
+          if (::unlink(node->fts_path) < 0) {
+            if (errno != ENOENT) {
+              if (continueOnError) {
+                LOG(ERROR) << "Failed to delete path "
+                           << path::join(directory, node->fts_path)
+                           << ": " << os::strerror(errno);
+                ++errorCount;
+              } else {
+                Error error = ErrnoError();
+                fts_close(tree);
+                return error;
+              }
             }
+          } else if (removed.isSome()) {
+            removed.get()(node->fts_path, *node->fts_statp);
           }
           break;
         default:
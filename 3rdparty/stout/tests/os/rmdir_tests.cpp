@@ -385,6 +385,47 @@ TEST_F(RmdirTest, RemoveDirectoryButPreserveRoot)
 }
 
 
+#ifndef __WINDOWS__
+// This tests that `rmdir` reports every file and directory it deletes
+// when given a callback, except for a preserved root.
+TEST_F(RmdirTest, RemoveDirectoryWithCallback)
+{
+  const string newDirectory = path::join(os::getcwd(), "newDirectory");
+  ASSERT_SOME(os::mkdir(newDirectory));
+
+  const string subDirectory = path::join(newDirectory, "subDirectory");
+  ASSERT_SOME(os::mkdir(subDirectory));
+
+  const string file1 = path::join(newDirectory, "file1");
+  ASSERT_SOME(os::write(file1, "file1"));
+
+  const string file2 = path::join(subDirectory, "file2");
+  ASSERT_SOME(os::touch(file2));
+
+  hashset<string> removed;
+  size_t directories = 0;
+
+  auto callback = [&](const string& path, const struct stat& s) {
+    removed.insert(path);
+    if (S_ISDIR(s.st_mode)) {
+      ++directories;
+    }
+  };
+
+  EXPECT_SOME(os::rmdir(newDirectory, true, false, false, callback));
+  EXPECT_TRUE(os::exists(newDirectory));
+  EXPECT_EQ(hashset<string>({subDirectory, file1, file2}), removed);
+  EXPECT_EQ(1u, directories);
+
+  removed.clear();
+
+  EXPECT_SOME(os::rmdir(newDirectory, true, true, false, callback));
+  EXPECT_FALSE(os::exists(newDirectory));
+  EXPECT_EQ(hashset<string>({newDirectory}), removed);
+}
+#endif // __WINDOWS__
+
+
 #ifdef __linux__
 // This test fixture verifies that `rmdir` behaves correctly
 // with option `continueOnError` and makes sure the undeletable
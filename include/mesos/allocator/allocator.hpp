@@ -41,6 +41,21 @@
 namespace mesos {
 namespace allocator {
 
+/**
+ * The arguments of `Allocator::addSlave()` for a single agent, used to
+ * add multiple agents at once, see `Allocator::addSlaves()`.
+ */
+struct SlaveAddition
+{
+  SlaveID slaveId;
+  SlaveInfo slaveInfo;
+  std::vector<SlaveInfo::Capability> capabilities;
+  Option<Unavailability> unavailability;
+  Resources total;
+  hashmap<FrameworkID, Resources> used;
+};
+
+
 /**
  * Basic model of an allocator: resources are allocated to a framework
  * in the form of offers. A framework can refuse some resources in
@@ -195,6 +210,28 @@ public:
       const Resources& total,
       const hashmap<FrameworkID, Resources>& used) = 0;
 
+  /**
+   * Adds or re-adds multiple agents to the Mesos cluster at once. It is
+   * invoked when many agents re-register at about the same time, e.g.,
+   * after a master failover. This is equivalent to invoking `addSlave()`
+   * for each of the agents in order, which is what the default
+   * implementation does.
+   *
+   * @param slaves The arguments of `addSlave()` for each of the agents.
+   */
+  virtual void addSlaves(const std::vector<SlaveAddition>& slaves)
+  {
+    for (const SlaveAddition& slave : slaves) {
+      addSlave(
+          slave.slaveId,
+          slave.slaveInfo,
+          slave.capabilities,
+          slave.unavailability,
+          slave.total,
+          slave.used);
+    }
+  }
+
   /**
    * Removes an agent from the Mesos cluster. All resources belonging to this
    * agent should be released by the allocator.
@@ -362,6 +399,18 @@ public:
       const Resources& resources,
       const Option<Filters>& filters) = 0;
 
+  /**
+   * Recovers resources of multiple frameworks and agents at once, e.g.,
+   * when all offers on an agent are rescinded. Unlike
+   * `recoverResources()`, the resources of a framework on an agent may
+   * be allocated to multiple roles. No filters are installed.
+   *
+   * The default implementation calls `recoverResources()` for each
+   * framework, agent and role.
+   */
+  virtual void batchRecoverResources(
+      const hashmap<FrameworkID, hashmap<SlaveID, Resources>>& resources);
+
   /**
    * Suppresses offers.
    *
@@ -17,6 +17,8 @@
 #ifndef __MESOS_AUTHORIZER_AUTHORIZER_HPP__
 #define __MESOS_AUTHORIZER_AUTHORIZER_HPP__
 
+#include <vector>
+
 #include <mesos/mesos.hpp>
 
 // ONLY USEFUL AFTER RUNNING PROTOC.
@@ -286,6 +288,21 @@ public:
   virtual process::Future<bool> authorized(
       const authorization::Request& request) = 0;
 
+  /**
+   * Checks a batch of requests with the identity server back end, see
+   * `authorized()`. Back ends which can decide several requests at once
+   * (e.g., with a single network call) should override this method; the
+   * default implementation calls `authorized()` for each request.
+   *
+   * @param requests `authorization::Request` instances to be checked.
+   *
+   * @return One decision per request, in the order of `requests`. A
+   *     failed future indicates a problem processing that request only,
+   *     and it might be retried in the future.
+   */
+  virtual std::vector<process::Future<bool>> batchAuthorized(
+      const std::vector<authorization::Request>& requests);
+
   /**
    * Creates an `ObjectApprover` which can synchronously check authorization on
    * an object.
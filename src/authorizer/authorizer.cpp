@@ -20,6 +20,7 @@
 
 #include <mesos/module/authorizer.hpp>
 
+#include <stout/foreach.hpp>
 #include <stout/path.hpp>
 
 #include "authorizer/local/authorizer.hpp"
@@ -32,6 +33,9 @@
 
 using std::ostream;
 using std::string;
+using std::vector;
+
+using process::Future;
 
 using mesos::internal::LocalAuthorizer;
 
@@ -47,4 +51,16 @@ Try<Authorizer*> Authorizer::create(const ACLs& acls)
   return LocalAuthorizer::create(acls);
 }
 
+
+vector<Future<bool>> Authorizer::batchAuthorized(
+    const vector<authorization::Request>& requests)
+{
+  vector<Future<bool>> authorizations;
+  foreach (const authorization::Request& request, requests) {
+    authorizations.push_back(authorized(request));
+  }
+
+  return authorizations;
+}
+
 } // namespace mesos {
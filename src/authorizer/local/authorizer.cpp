@@ -16,6 +16,9 @@
 
 #include "authorizer/local/authorizer.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -30,10 +33,12 @@
 #include <process/protobuf.hpp>
 
 #include <stout/foreach.hpp>
+#include <stout/hashmap.hpp>
 #include <stout/none.hpp>
 #include <stout/option.hpp>
 #include <stout/path.hpp>
 #include <stout/protobuf.hpp>
+#include <stout/stringify.hpp>
 #include <stout/strings.hpp>
 #include <stout/try.hpp>
 #include <stout/unreachable.hpp>
@@ -42,6 +47,7 @@
 #include "common/parse.hpp"
 #include "common/protobuf_utils.hpp"
 
+using std::shared_ptr;
 using std::string;
 using std::vector;
 
@@ -169,31 +175,275 @@ static bool allows(const ACL::Entity& request, const ACL::Entity& acl)
 }
 
 
+// Returns true if `acl` applies to a role and all roles nested under it,
+// i.e., its only object value ends with `/%`. This interpretation is only
+// used for hierarchical role ACLs.
+static bool isRecursiveACL(const GenericACL& acl)
+{
+  return acl.objects.values_size() == 1 &&
+         strings::endsWith(acl.objects.values(0), "/%");
+}
+
+
+// Returns true if child is a nested hierarchy of parent, i.e. child has more
+// levels of nesting and all the levels of parent are a prefix of the levels
+// of child.
+static bool isNestedHierarchy(const string& parent, const string& child)
+{
+  // Requires that parent ends with `/%`.
+  CHECK(strings::endsWith(parent, "/%"));
+  return strings::startsWith(child, parent.substr(0, parent.size() - 1));
+}
+
+
+static ACL::Entity createSubject(const Option<authorization::Subject>& subject)
+{
+  ACL::Entity entity;
+
+  if (subject.isSome()) {
+    entity.add_values(subject->value());
+    entity.set_type(ACL::Entity::SOME);
+  } else {
+    entity.set_type(ACL::Entity::ANY);
+  }
+
+  return entity;
+}
+
+
+// The ACLs of an action in the order in which they are evaluated,
+// indexed by the principals named in their subjects. These are compiled
+// once when the authorizer is created and shared by all approvers of
+// the action, so that creating an approver only needs to visit the
+// ACLs which can match its subject.
+class CompiledACLs
+{
+public:
+  CompiledACLs(const vector<GenericACL>& _acls, bool _hierarchical)
+    : acls(_acls), hierarchical(_hierarchical)
+  {
+    for (size_t i = 0; i < acls.size(); i++) {
+      const ACL::Entity& subjects = acls[i].subjects;
+
+      if (subjects.type() != ACL::Entity::SOME) {
+        wildcards.push_back(i);
+        continue;
+      }
+
+      foreach (const string& value, subjects.values()) {
+        vector<size_t>& positions = principals[value];
+        if (positions.empty() || positions.back() != i) {
+          positions.push_back(i);
+        }
+      }
+    }
+  }
+
+  // Returns the positions of the ACLs whose subjects match `subject`,
+  // in evaluation order.
+  vector<size_t> matching(const ACL::Entity& subject) const
+  {
+    // ANY matches with ANY or NONE.
+    if (subject.type() == ACL::Entity::ANY) {
+      return wildcards;
+    }
+
+    // A single principal additionally matches the ACLs naming it.
+    if (subject.type() == ACL::Entity::SOME && subject.values_size() == 1) {
+      Option<vector<size_t>> named = principals.get(subject.values(0));
+      if (named.isNone()) {
+        return wildcards;
+      }
+
+      vector<size_t> positions;
+      positions.reserve(wildcards.size() + named->size());
+
+      std::merge(
+          wildcards.begin(),
+          wildcards.end(),
+          named->begin(),
+          named->end(),
+          std::back_inserter(positions));
+
+      return positions;
+    }
+
+    vector<size_t> positions;
+    for (size_t i = 0; i < acls.size(); i++) {
+      if (matches(subject, acls[i].subjects)) {
+        positions.push_back(i);
+      }
+    }
+
+    return positions;
+  }
+
+  const vector<GenericACL> acls;
+
+  // Whether recursive role ACLs (see `isRecursiveACL()`) apply.
+  const bool hierarchical;
+
+private:
+  // Positions of the ACLs for ANY or NONE subjects.
+  vector<size_t> wildcards;
+
+  // Positions of the ACLs naming each principal.
+  hashmap<string, vector<size_t>> principals;
+};
+
+
+// Evaluates the compiled ACLs of an action for a fixed subject.
+//
+// A request is decided by the first ACL matching both its subject and
+// its object. As the subject is fixed, the first matching ACL for a
+// given object value is precomputed (per role prefix for recursive role
+// ACLs), which turns the walk over all ACLs into a few hash lookups.
+class SubjectACLs
+{
+public:
+  SubjectACLs(
+      const shared_ptr<const CompiledACLs>& acls,
+      const ACL::Entity& subject,
+      bool permissive)
+    : acls_(acls),
+      subject_(subject),
+      matching_(acls->matching(subject)),
+      permissive_(permissive)
+  {
+    // Since the ACLs are visited in order, `emplace()` retains the
+    // first ACL for each key.
+    foreach (size_t position, matching_) {
+      const GenericACL& acl = acls_->acls[position];
+      const bool allowed = allows(subject_, acl.subjects);
+
+      if (acls_->hierarchical && isRecursiveACL(acl)) {
+        // Strip the trailing `%` to obtain the prefix of nested roles.
+        const string& role = acl.objects.values(0);
+        recursive_.emplace(
+            role.substr(0, role.size() - 1), Decision{position, allowed});
+      } else if (acl.objects.type() == ACL::Entity::SOME) {
+        foreach (const string& value, acl.objects.values()) {
+          values_.emplace(value, Decision{position, allowed});
+        }
+      } else if (wildcard_.isNone()) {
+        // Objects are only allowed by ANY, never by NONE.
+        wildcard_ = Decision{
+            position, allowed && acl.objects.type() == ACL::Entity::ANY};
+      }
+    }
+  }
+
+  bool approved(const ACL::Entity& object) const
+  {
+    // ANY matches with ANY or NONE.
+    if (object.type() == ACL::Entity::ANY) {
+      return decide(wildcard_);
+    }
+
+    if (object.type() != ACL::Entity::SOME || object.values_size() != 1) {
+      return evaluate(object);
+    }
+
+    const string& value = object.values(0);
+
+    Option<Decision> decision = wildcard_;
+    first(&decision, values_.get(value));
+
+    // A recursive ACL applies to the roles nested under it, i.e., the
+    // roles of which its prefix is a prefix ending in `/`.
+    if (!recursive_.empty()) {
+      for (size_t i = value.find('/');
+           i != string::npos;
+           i = value.find('/', i + 1)) {
+        first(&decision, recursive_.get(value.substr(0, i + 1)));
+      }
+    }
+
+    return decide(decision);
+  }
+
+private:
+  struct Decision
+  {
+    size_t position;
+    bool allowed;
+  };
+
+  static void first(Option<Decision>* decision, const Option<Decision>& other)
+  {
+    if (other.isSome() &&
+        (decision->isNone() || other->position < decision->get().position)) {
+      *decision = other;
+    }
+  }
+
+  bool decide(const Option<Decision>& decision) const
+  {
+    // Use `permissive_` if none of the ACLs match.
+    return decision.isSome() ? decision->allowed : permissive_;
+  }
+
+  // Walks the ACLs matching the subject in order. This is only used for
+  // objects which are not a single value or ANY.
+  bool evaluate(const ACL::Entity& object) const
+  {
+    // This entity is used for recursive hierarchies where we already
+    // validated that the object role is a nested hierarchy of the
+    // acl role.
+    ACL::Entity aclAny;
+    aclAny.set_type(ACL::Entity::ANY);
+
+    foreach (size_t position, matching_) {
+      const GenericACL& acl = acls_->acls[position];
+
+      if (!acls_->hierarchical || !isRecursiveACL(acl)) {
+        // If `acl` is not recursive, treat it as a normal acl.
+        if (matches(object, acl.objects)) {
+          return allows(subject_, acl.subjects) && allows(object, acl.objects);
+        }
+      } else if (object.type() == ACL::Entity::SOME &&
+          isNestedHierarchy(acl.objects.values(0), object.values(0))) {
+        // Partial validation was done when verifying that the object is
+        // a nested hierarchy.
+        return allows(subject_, acl.subjects) && allows(object, aclAny);
+      }
+    }
+
+    return permissive_;
+  }
+
+  const shared_ptr<const CompiledACLs> acls_;
+  const ACL::Entity subject_;
+  const vector<size_t> matching_;
+  const bool permissive_;
+
+  // The first ACL matching any object value, i.e., with ANY or NONE
+  // objects.
+  Option<Decision> wildcard_;
+
+  // The first ACL naming each object value.
+  hashmap<string, Decision> values_;
+
+  // The first recursive ACL for each role prefix, including the
+  // trailing `/`.
+  hashmap<string, Decision> recursive_;
+};
+
+
 class LocalAuthorizerObjectApprover : public ObjectApprover
 {
 public:
   LocalAuthorizerObjectApprover(
-      const vector<GenericACL>& acls,
+      const shared_ptr<const CompiledACLs>& acls,
       const Option<authorization::Subject>& subject,
       const authorization::Action& action,
       bool permissive)
-    : acls_(acls),
-      subject_(subject),
-      action_(action),
-      permissive_(permissive) {}
+    : acls_(acls, createSubject(subject), permissive),
+      action_(action) {}
 
   virtual Try<bool> approved(
       const Option<ObjectApprover::Object>& object) const noexcept override
   {
-    // Construct subject.
-    ACL::Entity aclSubject;
-    if (subject_.isSome()) {
-      aclSubject.add_values(subject_->value());
-      aclSubject.set_type(mesos::ACL::Entity::SOME);
-    } else {
-      aclSubject.set_type(mesos::ACL::Entity::ANY);
-    }
-
     // Construct object.
     ACL::Entity aclObject;
 
@@ -431,29 +681,12 @@ public:
       }
     }
 
-    return approved(acls_, aclSubject, aclObject);
+    return acls_.approved(aclObject);
   }
 
 private:
-  bool approved(
-      const vector<GenericACL>& acls,
-      const ACL::Entity& subject,
-      const ACL::Entity& object) const
-  {
-    // Authorize subject/object.
-    foreach (const GenericACL& acl, acls) {
-      if (matches(subject, acl.subjects) && matches(object, acl.objects)) {
-        return allows(subject, acl.subjects) && allows(object, acl.objects);
-      }
-    }
-
-    return permissive_; // None of the ACLs match.
-  }
-
-  const vector<GenericACL> acls_;
-  const Option<authorization::Subject> subject_;
+  const SubjectACLs acls_;
   const authorization::Action action_;
-  const bool permissive_;
 };
 
 
@@ -461,8 +694,8 @@ class LocalNestedContainerObjectApprover : public ObjectApprover
 {
 public:
   LocalNestedContainerObjectApprover(
-      const vector<GenericACL>& userAcls,
-      const vector<GenericACL>& parentAcls,
+      const shared_ptr<const CompiledACLs>& userAcls,
+      const shared_ptr<const CompiledACLs>& parentAcls,
       const Option<authorization::Subject>& subject,
       const authorization::Action& action,
       bool permissive)
@@ -569,19 +802,13 @@ class LocalHierarchicalRoleApprover : public ObjectApprover
 {
 public:
   LocalHierarchicalRoleApprover(
-      const vector<GenericACL>& acls,
+      const shared_ptr<const CompiledACLs>& acls,
       const Option<authorization::Subject>& subject,
       const authorization::Action& action,
       bool permissive)
-    : acls_(acls), subject_(subject), action_(action), permissive_(permissive)
-  {
-    if (subject_.isSome()) {
-      entitySubject_.set_type(ACL::Entity::SOME);
-      entitySubject_.add_values(subject_->value());
-    } else {
-      entitySubject_.set_type(ACL::Entity::ANY);
-    }
-  }
+    : acls_(acls, createSubject(subject), permissive),
+      action_(action),
+      permissive_(permissive) {}
 
   virtual Try<bool> approved(const Option<ObjectApprover::Object>& object) const
       noexcept override
@@ -679,7 +906,7 @@ public:
           // The framework needs to be allowed to register under
           // all the roles it requests.
           foreach (const ACL::Entity& entity, objects) {
-            if (!approved(acls_, entitySubject_, entity)) {
+            if (!acls_.approved(entity)) {
               return false;
             }
           }
@@ -728,61 +955,13 @@ public:
         entityObject.type() == ACL::Entity::ANY ||
         entityObject.values_size() == 1);
 
-    return approved(acls_, entitySubject_, entityObject);
+    return acls_.approved(entityObject);
   }
 
 private:
-  bool approved(
-      const vector<GenericACL>& acls,
-      const ACL::Entity& subject,
-      const ACL::Entity& object) const
-  {
-    // This entity is used for recursive hierarchies where we already
-    // validated that the object role is a nested hierarchy of the
-    // acl role.
-    ACL::Entity aclAny;
-    aclAny.set_type(ACL::Entity::ANY);
-
-    foreach (const GenericACL& acl, acls) {
-      if (!isRecursiveACL(acl)) {
-        // If `acl` is not recursive, treat it as a normal acl.
-        if (matches(subject, acl.subjects) && matches(object, acl.objects)) {
-          return allows(subject, acl.subjects) && allows(object, acl.objects);
-        }
-      } else if (object.type() == ACL::Entity::SOME &&
-          isNestedHierarchy(acl.objects.values(0), object.values(0))) {
-        // Partial validation was done when verifying that the object is
-        // a nested hierarchy.
-        if (matches(subject, acl.subjects) && matches(object, aclAny)) {
-          return allows(subject, acl.subjects) && allows(object, aclAny);
-        }
-      }
-    }
-
-    return permissive_;
-  }
-
-  static bool isRecursiveACL(const GenericACL& acl)
-  {
-    return acl.objects.values_size() == 1 &&
-           strings::endsWith(acl.objects.values(0), "/%");
-  }
-
-  // Returns true if child is a nested hierarchy of parent, i.e. child has more
-  // levels of nesting and all the levels of parent are a prefix of the levels
-  // of child.
-  static bool isNestedHierarchy(const string& parent, const string& child)
-  {
-    // Requires that parent ends with `/%`.
-    CHECK(strings::endsWith(parent, "/%"));
-    return strings::startsWith(child, parent.substr(0, parent.size() - 1));
-  }
-
-  vector<GenericACL> acls_;
-  Option<authorization::Subject> subject_;
-  authorization::Action action_;
-  bool permissive_;
-  ACL::Entity entitySubject_;
+  const SubjectACLs acls_;
+  const authorization::Action action_;
+  const bool permissive_;
 };
 
 
@@ -790,7 +969,41 @@ class LocalAuthorizerProcess : public ProtobufProcess<LocalAuthorizerProcess>
 {
 public:
   LocalAuthorizerProcess(const ACLs& _acls)
-    : ProcessBase(process::ID::generate("local-authorizer")), acls(_acls) {}
+    : ProcessBase(process::ID::generate("local-authorizer")),
+      acls(_acls),
+      compiledACLs(authorization::Action_ARRAYSIZE)
+  {
+    // Compile the ACLs of each action once, instead of every time an
+    // approver is created.
+    for (int i = authorization::Action_MIN;
+         i <= authorization::Action_MAX;
+         i++) {
+      if (!authorization::Action_IsValid(i)) {
+        continue;
+      }
+
+      const authorization::Action action =
+        static_cast<authorization::Action>(i);
+
+      Option<vector<GenericACL>> hierarchicalRoleACLs =
+        createHierarchicalRoleACLs(action, acls);
+
+      if (hierarchicalRoleACLs.isSome()) {
+        compiledACLs[i] = std::make_shared<const CompiledACLs>(
+            hierarchicalRoleACLs.get(), true);
+        continue;
+      }
+
+      // Actions requiring specialized ACLs yield an error here and are
+      // handled by their respective approvers.
+      Result<vector<GenericACL>> genericACLs = createGenericACLs(action, acls);
+
+      if (genericACLs.isSome()) {
+        compiledACLs[i] = std::make_shared<const CompiledACLs>(
+            genericACLs.get(), false);
+      }
+    }
+  }
 
   Future<bool> authorized(const authorization::Request& request)
   {
@@ -814,6 +1027,51 @@ public:
       });
   }
 
+  vector<Future<bool>> batchAuthorized(
+      const vector<authorization::Request>& requests)
+  {
+    // Requests with the same subject and action share an approver. The
+    // key tags whether a subject is present, so that a request without
+    // a subject does not share the approver of an empty subject.
+    hashmap<string, Future<Owned<ObjectApprover>>> approvers;
+
+    vector<Future<bool>> authorizations;
+    authorizations.reserve(requests.size());
+
+    foreach (const authorization::Request& request, requests) {
+      Option<authorization::Subject> subject;
+      if (request.has_subject()) {
+        subject = request.subject();
+      }
+
+      const string key = stringify(static_cast<int>(request.action())) +
+        (subject.isSome() ? "+" + subject->SerializeAsString() : "-");
+
+      if (!approvers.contains(key)) {
+        approvers[key] = getObjectApprover(subject, request.action());
+      }
+
+      // Each request is decided on its own, so that an error in one
+      // request does not fail the others.
+      authorizations.push_back(approvers.at(key)
+        .then([=](const Owned<ObjectApprover>& objectApprover)
+            -> Future<bool> {
+          Option<ObjectApprover::Object> object = None();
+          if (request.has_object()) {
+            object = ObjectApprover::Object(request.object());
+          }
+
+          Try<bool> result = objectApprover->approved(object);
+          if (result.isError()) {
+            return Failure(result.error());
+          }
+          return result.get();
+        }));
+    }
+
+    return authorizations;
+  }
+
   template <typename SomeACL>
   static vector<GenericACL> createHierarchicalRoleACLs(
       SomeACL&& someACL)
@@ -862,47 +1120,27 @@ public:
     return acls;
   }
 
-  Future<Owned<ObjectApprover>> getHierarchicalRoleApprover(
-      const Option<authorization::Subject>& subject,
-      const authorization::Action& action) const
+  // Returns the hierarchical role ACLs of `action`, or none if the
+  // action is not authorized based on roles.
+  static Option<vector<GenericACL>> createHierarchicalRoleACLs(
+      const authorization::Action& action,
+      const ACLs& acls)
   {
-    vector<GenericACL> hierarchicalRoleACLs;
     switch (action) {
-      case authorization::CREATE_VOLUME: {
-        hierarchicalRoleACLs =
-            createHierarchicalRoleACLs(acls.create_volumes());
-        break;
-      }
-      case authorization::RESERVE_RESOURCES: {
-        hierarchicalRoleACLs =
-            createHierarchicalRoleACLs(acls.reserve_resources());
-        break;
-      }
-      case authorization::UPDATE_WEIGHT: {
-        hierarchicalRoleACLs =
-            createHierarchicalRoleACLs(acls.update_weights());
-        break;
-      }
-      case authorization::VIEW_ROLE: {
-        hierarchicalRoleACLs =
-            createHierarchicalRoleACLs(acls.view_roles());
-        break;
-      }
-      case authorization::GET_QUOTA: {
-        hierarchicalRoleACLs =
-            createHierarchicalRoleACLs(acls.get_quotas());
-        break;
-      }
-      case authorization::REGISTER_FRAMEWORK: {
-        hierarchicalRoleACLs =
-            createHierarchicalRoleACLs(acls.register_frameworks());
-        break;
-      }
-      case authorization::UPDATE_QUOTA: {
-        hierarchicalRoleACLs =
-            createHierarchicalRoleACLs(acls.update_quotas());
-        break;
-      }
+      case authorization::CREATE_VOLUME:
+        return createHierarchicalRoleACLs(acls.create_volumes());
+      case authorization::RESERVE_RESOURCES:
+        return createHierarchicalRoleACLs(acls.reserve_resources());
+      case authorization::UPDATE_WEIGHT:
+        return createHierarchicalRoleACLs(acls.update_weights());
+      case authorization::VIEW_ROLE:
+        return createHierarchicalRoleACLs(acls.view_roles());
+      case authorization::GET_QUOTA:
+        return createHierarchicalRoleACLs(acls.get_quotas());
+      case authorization::REGISTER_FRAMEWORK:
+        return createHierarchicalRoleACLs(acls.register_frameworks());
+      case authorization::UPDATE_QUOTA:
+        return createHierarchicalRoleACLs(acls.update_quotas());
       case authorization::ACCESS_MESOS_LOG:
       case authorization::ACCESS_SANDBOX:
       case authorization::ATTACH_CONTAINER_INPUT:
@@ -937,12 +1175,21 @@ public:
       case authorization::WAIT_NESTED_CONTAINER:
       case authorization::WAIT_STANDALONE_CONTAINER:
       case authorization::MODIFY_RESOURCE_PROVIDER_CONFIG:
-        UNREACHABLE();
+        return None();
     }
 
+    UNREACHABLE();
+  }
+
+  Future<Owned<ObjectApprover>> getHierarchicalRoleApprover(
+      const Option<authorization::Subject>& subject,
+      const authorization::Action& action) const
+  {
+    CHECK(compiledACLs[action]);
+
     return Owned<ObjectApprover>(
         new LocalHierarchicalRoleApprover(
-            hierarchicalRoleACLs, subject, action, acls.permissive()));
+            compiledACLs[action], subject, action, acls.permissive()));
   }
 
   Future<Owned<ObjectApprover>> getNestedContainerObjectApprover(
@@ -995,8 +1242,8 @@ public:
     }
 
     return Owned<ObjectApprover>(new LocalNestedContainerObjectApprover(
-        runAsUserAcls,
-        parentRunningAsUserAcls,
+        std::make_shared<const CompiledACLs>(runAsUserAcls, false),
+        std::make_shared<const CompiledACLs>(parentRunningAsUserAcls, false),
         subject,
         action,
         acls.permissive()));
@@ -1150,19 +1397,20 @@ public:
       case authorization::WAIT_STANDALONE_CONTAINER:
       case authorization::MODIFY_RESOURCE_PROVIDER_CONFIG:
       case authorization::UNKNOWN: {
-        Result<vector<GenericACL>> genericACLs =
-          createGenericACLs(action, acls);
-        if (genericACLs.isError()) {
-          return Failure(genericACLs.error());
-        }
-        if (genericACLs.isNone()) {
+        if (!compiledACLs[action]) {
+          Result<vector<GenericACL>> genericACLs =
+            createGenericACLs(action, acls);
+          if (genericACLs.isError()) {
+            return Failure(genericACLs.error());
+          }
+
           // If we could not create acls, we deny all objects.
           return Owned<ObjectApprover>(new RejectingObjectApprover());
         }
 
         return Owned<ObjectApprover>(
             new LocalAuthorizerObjectApprover(
-                genericACLs.get(), subject, action, acls.permissive()));
+                compiledACLs[action], subject, action, acls.permissive()));
       }
     }
 
@@ -1523,6 +1771,10 @@ private:
   }
 
   ACLs acls;
+
+  // The compiled ACLs of each action, indexed by action. These are not
+  // set for actions requiring specialized ACLs or which have none.
+  vector<shared_ptr<const CompiledACLs>> compiledACLs;
 };
 
 
@@ -1748,6 +2000,26 @@ process::Future<bool> LocalAuthorizer::authorized(
 }
 
 
+vector<Future<bool>> LocalAuthorizer::batchAuthorized(
+    const vector<authorization::Request>& requests)
+{
+  Future<vector<Future<bool>>> batch = dispatch(
+      process,
+      &LocalAuthorizerProcess::batchAuthorized,
+      requests);
+
+  vector<Future<bool>> authorizations;
+  authorizations.reserve(requests.size());
+
+  for (size_t i = 0; i < requests.size(); i++) {
+    authorizations.push_back(batch.then(
+        [i](const vector<Future<bool>>& batch) { return batch[i]; }));
+  }
+
+  return authorizations;
+}
+
+
 Future<Owned<ObjectApprover>> LocalAuthorizer::getObjectApprover(
       const Option<authorization::Subject>& subject,
       const authorization::Action& action)
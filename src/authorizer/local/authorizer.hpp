@@ -17,6 +17,8 @@
 #ifndef __AUTHORIZER_AUTHORIZER_HPP__
 #define __AUTHORIZER_AUTHORIZER_HPP__
 
+#include <vector>
+
 #include <mesos/authorizer/authorizer.hpp>
 
 #include <process/future.hpp>
@@ -65,6 +67,12 @@ public:
   virtual process::Future<bool> authorized(
       const authorization::Request& request);
 
+  // Decides all requests with a single dispatch to the authorizer
+  // process, sharing the object approvers of requests with the same
+  // subject and action.
+  virtual std::vector<process::Future<bool>> batchAuthorized(
+      const std::vector<authorization::Request>& requests);
+
   virtual process::Future<process::Owned<ObjectApprover>> getObjectApprover(
       const Option<authorization::Subject>& subject,
       const authorization::Action& action);
@@ -14,9 +14,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <functional>
 #include <map>
 #include <ostream>
 #include <set>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -32,6 +34,7 @@
 #include <mesos/quota/quota.hpp>
 
 #include <process/authenticator.hpp>
+#include <process/clock.hpp>
 #include <process/dispatch.hpp>
 #include <process/future.hpp>
 #include <process/http.hpp>
@@ -685,33 +688,46 @@ void json(JSON::ObjectWriter* writer, const Resources& resources)
 
 void json(JSON::ObjectWriter* writer, const Task& task)
 {
-  writer->field("id", task.task_id().value());
-  writer->field("name", task.name());
-  writer->field("framework_id", task.framework_id().value());
-  writer->field("executor_id", task.executor_id().value());
-  writer->field("slave_id", task.slave_id().value());
-  writer->field("state", TaskState_Name(task.state()));
-  writer->field("resources", Resources(task.resources()));
+  json(writer, task, FieldSelector());
+}
+
+
+void json(
+    JSON::ObjectWriter* writer,
+    const Task& task,
+    const FieldSelector& fields)
+{
+  fields.field(writer, "id", task.task_id().value());
+  fields.field(writer, "name", task.name());
+  fields.field(writer, "framework_id", task.framework_id().value());
+  fields.field(writer, "executor_id", task.executor_id().value());
+  fields.field(writer, "slave_id", task.slave_id().value());
+  fields.field(writer, "state", TaskState_Name(task.state()));
+
+  if (fields.accept("resources")) {
+    writer->field("resources", Resources(task.resources()));
+  }
 
   // Tasks are not allowed to mix resources allocated to
   // different roles, see MESOS-6636.
-  writer->field("role", task.resources().begin()->allocation_info().role());
+  fields.field(
+      writer, "role", task.resources().begin()->allocation_info().role());
 
-  writer->field("statuses", task.statuses());
+  fields.field(writer, "statuses", task.statuses());
 
   if (task.has_user()) {
-    writer->field("user", task.user());
+    fields.field(writer, "user", task.user());
   }
 
   if (task.has_labels()) {
-    writer->field("labels", task.labels());
+    fields.field(writer, "labels", task.labels());
   }
 
-  if (task.has_discovery()) {
+  if (task.has_discovery() && fields.accept("discovery")) {
     writer->field("discovery", JSON::Protobuf(task.discovery()));
   }
 
-  if (task.has_container()) {
+  if (task.has_container() && fields.accept("container")) {
     writer->field("container", JSON::Protobuf(task.container()));
   }
 }
@@ -1195,6 +1211,134 @@ void logRequest(const process::http::Request& request)
 }
 
 
+process::http::Response streamingJSON(
+    const process::http::Pipe::Reader& reader,
+    const Option<string>& jsonp)
+{
+  process::http::OK ok;
+  ok.type = process::http::Response::PIPE;
+  ok.reader = reader;
+
+  ok.headers["Content-Type"] =
+    jsonp.isSome() ? "text/javascript" : APPLICATION_JSON;
+
+  return ok;
+}
+
+
+namespace {
+
+// Returns whether the `If-None-Match` header of `request` matches `etag`.
+bool notModified(const process::http::Request& request, const string& etag)
+{
+  Option<string> ifNoneMatch = request.headers.get("If-None-Match");
+  if (ifNoneMatch.isNone()) {
+    return false;
+  }
+
+  foreach (string tag, strings::tokenize(ifNoneMatch.get(), ",")) {
+    tag = strings::trim(tag);
+
+    // Weak comparison is sufficient for `If-None-Match`, see RFC 7232.
+    if (strings::startsWith(tag, "W/")) {
+      tag = tag.substr(2);
+    }
+
+    if (tag == "*" || tag == etag) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+
+process::http::Response notModifiedResponse(
+    const process::http::Response& response)
+{
+  process::http::Response notModified;
+  notModified.code = process::http::Status::NOT_MODIFIED;
+  notModified.status =
+    process::http::Status::string(process::http::Status::NOT_MODIFIED);
+  notModified.headers["ETag"] = response.headers.at("ETag");
+
+  return notModified;
+}
+
+} // namespace {
+
+
+Option<process::http::Response> ResponseCache::get(
+    const process::http::Request& request,
+    const Option<Principal>& principal,
+    uint64_t generation)
+{
+  const string key_ = key(request, principal);
+
+  Option<Entry> entry = cache.get(key_);
+  if (entry.isNone()) {
+    return None();
+  }
+
+  if (entry->generation != generation) {
+    cache.erase(key_);
+    return None();
+  }
+
+  if (notModified(request, entry->response.headers.at("ETag"))) {
+    return notModifiedResponse(entry->response);
+  }
+
+  return entry->response;
+}
+
+
+process::http::Response ResponseCache::put(
+    const process::http::Request& request,
+    const Option<Principal>& principal,
+    uint64_t generation,
+    const process::http::Response& response)
+{
+  if (response.code != process::http::Status::OK ||
+      response.type != process::http::Response::BODY) {
+    return response;
+  }
+
+  process::http::Response tagged = response;
+  tagged.headers["ETag"] =
+    "\"" + stringify(std::hash<string>()(response.body)) + "\"";
+
+  cache.put(
+      key(request, principal),
+      Entry{generation, tagged});
+
+  if (notModified(request, tagged.headers.at("ETag"))) {
+    return notModifiedResponse(tagged);
+  }
+
+  return tagged;
+}
+
+
+string ResponseCache::key(
+    const process::http::Request& request,
+    const Option<Principal>& principal)
+{
+  // Sort the query parameters so that their order does not matter.
+  const map<string, string> query(
+      request.url.query.begin(), request.url.query.end());
+
+  std::ostringstream out;
+  out << request.url.path << "?" << stringify(query) << "|";
+
+  if (principal.isSome()) {
+    out << principal.get();
+  }
+
+  return out.str();
+}
+
+
 Future<Owned<AuthorizationAcceptor>> AuthorizationAcceptor::create(
     const Option<Principal>& principal,
     const Option<Authorizer*>& authorizer,
@@ -17,6 +17,8 @@
 #ifndef __COMMON_HTTP_HPP__
 #define __COMMON_HTTP_HPP__
 
+#include <cstdint>
+#include <string>
 #include <vector>
 
 #include <mesos/http.hpp>
@@ -29,12 +31,17 @@
 #include <process/future.hpp>
 #include <process/http.hpp>
 #include <process/owned.hpp>
+#include <process/time.hpp>
 
+#include <stout/cache.hpp>
+#include <stout/duration.hpp>
+#include <stout/foreach.hpp>
 #include <stout/hashmap.hpp>
 #include <stout/hashset.hpp>
 #include <stout/json.hpp>
 #include <stout/jsonify.hpp>
 #include <stout/protobuf.hpp>
+#include <stout/strings.hpp>
 #include <stout/unreachable.hpp>
 
 namespace mesos {
@@ -229,6 +236,55 @@ protected:
 };
 
 
+/**
+ * Used to project the responses of API handlers. Selects the fields of a
+ * JSON object that are included in the response based on a comma separated
+ * list of field names (e.g., the `fields` query parameter). If no list is
+ * provided when the selector is constructed, all fields are selected.
+ */
+class FieldSelector
+{
+public:
+  FieldSelector(const Option<std::string>& fields = None())
+  {
+    if (fields.isSome()) {
+      selected = hashset<std::string>();
+
+      foreach (const std::string& field, strings::tokenize(fields.get(), ",")) {
+        selected->insert(strings::trim(field));
+      }
+    }
+  }
+
+  bool accept(const std::string& field) const
+  {
+    return selected.isNone() || selected->contains(field);
+  }
+
+  // Writes the field `name` into `writer` unless it is not selected.
+  template <typename T>
+  void field(
+      JSON::ObjectWriter* writer,
+      const std::string& name,
+      const T& value) const
+  {
+    if (accept(name)) {
+      writer->field(name, value);
+    }
+  }
+
+protected:
+  Option<hashset<std::string>> selected;
+};
+
+
+// Writes the fields of `task` that are selected by `fields`.
+void json(
+    JSON::ObjectWriter* writer,
+    const Task& task,
+    const FieldSelector& fields);
+
+
 bool approveViewFrameworkInfo(
     const process::Owned<ObjectApprover>& frameworksApprover,
     const FrameworkInfo& frameworkInfo);
@@ -305,6 +361,74 @@ Try<Nothing> initializeHttpAuthenticators(
 // desired request handler to get consistent request logging.
 void logRequest(const process::http::Request& request);
 
+
+// Default size of the chunks in which large JSON documents (e.g., the
+// master's `/state`) are streamed to the client.
+constexpr size_t DEFAULT_JSON_CHUNK_SIZE = 64 * 1024;
+
+
+// Returns a chunked `200 OK` response with the same content type as
+// `process::http::OK(JSON::Proxy&&, jsonp)` whose body is read from
+// `reader`.
+process::http::Response streamingJSON(
+    const process::http::Pipe::Reader& reader,
+    const Option<std::string>& jsonp = None());
+
+
+// Default number of responses kept by a `ResponseCache`.
+constexpr size_t DEFAULT_RESPONSE_CACHE_CAPACITY = 64;
+
+
+/**
+ * Caches the serialized responses of read-only endpoints so that
+ * identical requests do not need to be re-serialized as long as the
+ * state they were computed from has not changed. Responses are cached
+ * per URL path, query and principal, and are tagged with the
+ * `generation` of the state they were computed from; a cached response
+ * is only served if the current generation matches. Cached responses
+ * carry an `ETag` header, allowing clients to issue conditional requests
+ * via `If-None-Match`, which are answered with `304 Not Modified`.
+ *
+ * NOTE: This class is not thread-safe, it is meant to be used from
+ * within a single actor.
+ */
+class ResponseCache
+{
+public:
+  explicit ResponseCache(size_t capacity = DEFAULT_RESPONSE_CACHE_CAPACITY)
+    : cache(capacity) {}
+
+  // Returns the cached response for `request` if it has been computed
+  // from state of the given `generation`, or `304 Not Modified` if the
+  // client already holds that response.
+  Option<process::http::Response> get(
+      const process::http::Request& request,
+      const Option<process::http::authentication::Principal>& principal,
+      uint64_t generation);
+
+  // Caches `response` (only `200 OK` responses with a body are cached)
+  // for `request` and returns it with an `ETag` header set, or
+  // `304 Not Modified` if the client already holds that response.
+  process::http::Response put(
+      const process::http::Request& request,
+      const Option<process::http::authentication::Principal>& principal,
+      uint64_t generation,
+      const process::http::Response& response);
+
+private:
+  struct Entry
+  {
+    uint64_t generation;
+    process::http::Response response;
+  };
+
+  static std::string key(
+      const process::http::Request& request,
+      const Option<process::http::authentication::Principal>& principal);
+
+  Cache<std::string, Entry> cache;
+};
+
 } // namespace mesos {
 
 #endif // __COMMON_HTTP_HPP__
@@ -14,11 +14,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <ctype.h>
 #include <errno.h>
 #include <fts.h>
 #include <signal.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 
 #include <sys/syscall.h>
@@ -35,6 +37,7 @@ extern "C" {
 #include <glog/logging.h>
 
 #include <fstream>
+#include <limits>
 #include <list>
 #include <map>
 #include <set>
@@ -56,6 +59,7 @@ extern "C" {
 #include <stout/hashset.hpp>
 #include <stout/lambda.hpp>
 #include <stout/none.hpp>
+#include <stout/numify.hpp>
 #include <stout/option.hpp>
 #include <stout/os.hpp>
 #include <stout/path.hpp>
@@ -1856,6 +1860,75 @@ Future<bool> _cleanup(const string& hierarchy)
 }
 
 
+namespace internal {
+
+// Parses the contents of a stat file, where each line is expected to
+// be of the format "%s %llu". The contents are scanned in place since
+// this is done for every container each time its usage is collected.
+static Try<hashmap<string, uint64_t>> parseStat(
+    const char* data,
+    size_t size,
+    const string& file)
+{
+  hashmap<string, uint64_t> result;
+
+  const char* end = data + size;
+  const char* line = data;
+
+  while (line < end) {
+    const char* eol =
+      static_cast<const char*>(::memchr(line, '\n', end - line));
+
+    if (eol == nullptr) {
+      eol = end;
+    }
+
+    const char* cursor = line;
+    while (cursor < eol && ::isspace(static_cast<unsigned char>(*cursor))) {
+      ++cursor;
+    }
+
+    // Skip empty lines.
+    if (cursor != eol) {
+      const char* name = cursor;
+      while (cursor < eol && !::isspace(static_cast<unsigned char>(*cursor))) {
+        ++cursor;
+      }
+
+      const char* nameEnd = cursor;
+      while (cursor < eol && ::isspace(static_cast<unsigned char>(*cursor))) {
+        ++cursor;
+      }
+
+      if (cursor == eol || !::isdigit(static_cast<unsigned char>(*cursor))) {
+        return Error(
+            "Unexpected line format in " + file + ": " + string(line, eol));
+      }
+
+      uint64_t value = 0;
+      while (cursor < eol && ::isdigit(static_cast<unsigned char>(*cursor))) {
+        uint64_t digit = *cursor - '0';
+        if (value > (std::numeric_limits<uint64_t>::max() - digit) / 10) {
+          return Error(
+              "Value out of range in " + file + ": " + string(line, eol));
+        }
+
+        value = value * 10 + digit;
+        ++cursor;
+      }
+
+      result[string(name, nameEnd)] = value;
+    }
+
+    line = eol == end ? end : eol + 1;
+  }
+
+  return result;
+}
+
+} // namespace internal {
+
+
 Try<hashmap<string, uint64_t>> stat(
     const string& hierarchy,
     const string& cgroup,
@@ -1867,31 +1940,183 @@ Try<hashmap<string, uint64_t>> stat(
     return Error(contents.error());
   }
 
-  hashmap<string, uint64_t> result;
+  return internal::parseStat(
+      contents->data(), contents->size(), file);
+}
 
-  foreach (const string& line, strings::split(contents.get(), "\n")) {
-    // Skip empty lines.
-    if (strings::trim(line).empty()) {
-      continue;
+
+Try<Owned<ControlReader>> ControlReader::create(
+    const string& hierarchy,
+    const string& cgroup,
+    const string& control)
+{
+  Option<Error> error = verify(hierarchy, cgroup, control);
+  if (error.isSome()) {
+    return error.get();
+  }
+
+  const string file = path::join(hierarchy, cgroup, control);
+
+  Try<int> fd = os::open(file, O_RDONLY | O_CLOEXEC);
+  if (fd.isError()) {
+    return Error("Failed to open '" + file + "': " + fd.error());
+  }
+
+  return Owned<ControlReader>(new ControlReader(fd.get(), file));
+}
+
+
+ControlReader::ControlReader(int _fd, const string& _path)
+  : fd(_fd),
+    path(_path),
+    buffer(os::pagesize()) {}
+
+
+ControlReader::~ControlReader()
+{
+  os::close(fd);
+}
+
+
+Try<string> ControlReader::read()
+{
+  Try<size_t> length = _read();
+  if (length.isError()) {
+    return Error(length.error());
+  }
+
+  return string(buffer.data(), length.get());
+}
+
+
+Try<hashmap<string, uint64_t>> ControlReader::stat()
+{
+  Try<size_t> length = _read();
+  if (length.isError()) {
+    return Error(length.error());
+  }
+
+  return internal::parseStat(
+      buffer.data(), length.get(), Path(path).basename());
+}
+
+
+Try<size_t> ControlReader::_read()
+{
+  // Control files are generated by the kernel on read, so we always
+  // read from the beginning rather than seeking back first.
+  size_t length = 0;
+
+  while (true) {
+    if (length == buffer.size()) {
+      buffer.resize(buffer.size() * 2);
     }
 
-    string name;
-    uint64_t value;
+    ssize_t n = ::pread(
+        fd, buffer.data() + length, buffer.size() - length, length);
 
-    // Expected line format: "%s %llu".
-    istringstream stream(line);
-    stream >> name >> value;
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
 
-    if (stream.fail()) {
-      return Error("Unexpected line format in " + file + ": " + line);
+      return ErrnoError("Failed to read '" + path + "'");
+    } else if (n == 0) {
+      return length;
     }
 
-    result[name] = value;
+    length += n;
   }
+}
 
-  return result;
+
+namespace psi {
+
+Try<Pressure> Pressure::parse(const string& s)
+{
+  Option<Stall> some;
+  Option<Stall> full;
+
+  foreach (const string& line, strings::tokenize(s, "\n")) {
+    // Expected line format:
+    // "{some,full} avg10=%f avg60=%f avg300=%f total=%llu".
+    vector<string> tokens = strings::tokenize(line, " ");
+
+    if (tokens.size() != 5) {
+      return Error("Unexpected line format: " + line);
+    }
+
+    hashmap<string, string> values;
+    for (size_t i = 1; i < tokens.size(); i++) {
+      vector<string> pair = strings::split(tokens[i], "=");
+
+      if (pair.size() != 2) {
+        return Error("Unexpected line format: " + line);
+      }
+
+      values[pair[0]] = pair[1];
+    }
+
+    if (!values.contains("avg10") ||
+        !values.contains("avg60") ||
+        !values.contains("avg300") ||
+        !values.contains("total")) {
+      return Error("Unexpected line format: " + line);
+    }
+
+    Try<double> avg10 = numify<double>(values["avg10"]);
+    Try<double> avg60 = numify<double>(values["avg60"]);
+    Try<double> avg300 = numify<double>(values["avg300"]);
+    Try<uint64_t> total = numify<uint64_t>(values["total"]);
+
+    if (avg10.isError() ||
+        avg60.isError() ||
+        avg300.isError() ||
+        total.isError()) {
+      return Error("Unexpected line format: " + line);
+    }
+
+    Stall stall;
+    stall.avg10 = avg10.get();
+    stall.avg60 = avg60.get();
+    stall.avg300 = avg300.get();
+    stall.total = Microseconds(total.get());
+
+    if (tokens[0] == "some") {
+      some = stall;
+    } else if (tokens[0] == "full") {
+      full = stall;
+    } else {
+      return Error("Unexpected line format: " + line);
+    }
+  }
+
+  if (some.isNone()) {
+    return Error("Missing 'some' line");
+  }
+
+  Pressure pressure;
+  pressure.some = some.get();
+  pressure.full = full;
+
+  return pressure;
+}
+
+
+Try<Pressure> read(ControlReader* reader)
+{
+  CHECK_NOTNULL(reader);
+
+  Try<string> contents = reader->read();
+  if (contents.isError()) {
+    return Error(contents.error());
+  }
+
+  return Pressure::parse(contents.get());
 }
 
+} // namespace psi {
+
 
 namespace internal {
 
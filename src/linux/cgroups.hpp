@@ -27,6 +27,7 @@
 #include <sys/types.h>
 
 #include <process/future.hpp>
+#include <process/owned.hpp>
 #include <process/timeout.hpp>
 
 #include <stout/bytes.hpp>
@@ -401,6 +402,92 @@ Try<hashmap<std::string, uint64_t>> stat(
     const std::string& file);
 
 
+// Reads a control file through a file descriptor that is kept open
+// across reads. Unlike 'cgroups::read', the hierarchy, cgroup and
+// control are only verified once at creation, and each subsequent
+// read is a single 'pread' into a reused buffer. This is intended
+// for control files that are sampled periodically for every
+// container (e.g. 'memory.stat' and 'cpuacct.stat').
+class ControlReader
+{
+public:
+  // Verifies the parameters as 'cgroups::read' does and opens the
+  // control file.
+  // @param   hierarchy   Path to the hierarchy root.
+  // @param   cgroup      Path to the cgroup relative to the hierarchy root.
+  // @param   control     Name of the control file.
+  // @return  The reader if the control file could be opened.
+  //          Error if the parameters are invalid or opening fails.
+  static Try<process::Owned<ControlReader>> create(
+      const std::string& hierarchy,
+      const std::string& cgroup,
+      const std::string& control);
+
+  ~ControlReader();
+
+  // Returns the current contents of the control file.
+  Try<std::string> read();
+
+  // Returns the stat information parsed from the control file. The
+  // contents are parsed in place and not copied out of the buffer.
+  Try<hashmap<std::string, uint64_t>> stat();
+
+private:
+  ControlReader(int fd, const std::string& path);
+
+  ControlReader(const ControlReader&) = delete;
+  ControlReader& operator=(const ControlReader&) = delete;
+
+  // Reads the control file into 'buffer' and returns the number of
+  // bytes read. The buffer is grown if the contents do not fit.
+  Try<size_t> _read();
+
+  const int fd;
+  const std::string path;
+  std::vector<char> buffer;
+};
+
+
+// Pressure stall information (PSI) as reported in the 'cpu.pressure',
+// 'memory.pressure' and 'io.pressure' control files by kernels built
+// with CONFIG_PSI. See Documentation/accounting/psi.txt in the kernel.
+namespace psi {
+
+struct Stall
+{
+  // Percentage of wall time in which tasks were stalled, averaged
+  // over the last 10, 60 and 300 seconds.
+  double avg10;
+  double avg60;
+  double avg300;
+
+  // Accumulated stall time.
+  Duration total;
+};
+
+
+struct Pressure
+{
+  static Try<Pressure> parse(const std::string& s);
+
+  // Time in which at least some tasks were stalled on the resource.
+  Stall some;
+
+  // Time in which all non-idle tasks were stalled at once. Older
+  // kernels do not report this for 'cpu.pressure'.
+  Option<Stall> full;
+};
+
+
+// Reads and parses a pressure control file (e.g. 'memory.pressure').
+// @param   reader      Reader of the pressure control file.
+// @return  The pressure stall information of the cgroup.
+//          Error if reading or parsing fails.
+Try<Pressure> read(ControlReader* reader);
+
+} // namespace psi {
+
+
 // Blkio subsystem.
 namespace blkio {
 
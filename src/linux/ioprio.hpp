@@ -0,0 +1,84 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __LINUX_IOPRIO_HPP__
+#define __LINUX_IOPRIO_HPP__
+
+// This file contains Linux-only OS utilities.
+#ifndef __linux__
+#error "linux/ioprio.hpp is only available on Linux systems."
+#endif
+
+#include <errno.h>
+#include <unistd.h>
+
+#include <sys/syscall.h>
+
+#include <glog/logging.h>
+
+#include <stout/os/strerror.hpp>
+
+namespace ioprio {
+
+// Lowers the I/O priority of the calling thread to the lowest level of
+// the best-effort class (see ioprio_set(2)) for the lifetime of this
+// object, e.g., so that deleting or walking large directories does not
+// starve the I/O of running tasks. The previous priority is restored on
+// destruction since such work usually runs on shared libprocess worker
+// threads.
+class LowIOPriority
+{
+public:
+  LowIOPriority()
+    : previous(::syscall(SYS_ioprio_get, WHO_PROCESS, 0))
+  {
+    if (::syscall(SYS_ioprio_set, WHO_PROCESS, 0, LOWEST) < 0) {
+      LOG(WARNING) << "Failed to lower the I/O priority: "
+                   << os::strerror(errno);
+    }
+  }
+
+  ~LowIOPriority()
+  {
+    if (previous < 0) {
+      return;
+    }
+
+    // A thread without an I/O priority reports the priority derived
+    // from its nice value, which cannot be set back explicitly.
+    if ((previous >> CLASS_SHIFT) == CLASS_NONE) {
+      previous = 0;
+    }
+
+    ::syscall(SYS_ioprio_set, WHO_PROCESS, 0, previous);
+  }
+
+private:
+  LowIOPriority(const LowIOPriority&) = delete;
+  LowIOPriority& operator=(const LowIOPriority&) = delete;
+
+  static constexpr int WHO_PROCESS = 1;
+  static constexpr int CLASS_SHIFT = 13;
+  static constexpr int CLASS_NONE = 0;
+  static constexpr int CLASS_BE = 2;
+  static constexpr int LOWEST = (CLASS_BE << CLASS_SHIFT) | 7;
+
+  long previous;
+};
+
+} // namespace ioprio {
+
+#endif // __LINUX_IOPRIO_HPP__
@@ -18,6 +18,9 @@
 
 #include <mesos/module/allocator.hpp>
 
+#include <stout/foreach.hpp>
+#include <stout/hashmap.hpp>
+
 #include "master/constants.hpp"
 
 #include "master/allocator/mesos/hierarchical.hpp"
@@ -44,5 +47,20 @@ Try<Allocator*> Allocator::create(const string& name)
   return modules::ModuleManager::create<Allocator>(name);
 }
 
+
+void Allocator::batchRecoverResources(
+    const hashmap<FrameworkID, hashmap<SlaveID, Resources>>& resources)
+{
+  foreachkey (const FrameworkID& frameworkId, resources) {
+    foreachpair (const SlaveID& slaveId,
+                 const Resources& recovered,
+                 resources.at(frameworkId)) {
+      foreachvalue (const Resources& allocation, recovered.allocations()) {
+        recoverResources(frameworkId, slaveId, allocation, None());
+      }
+    }
+  }
+}
+
 } // namespace allocator {
 } // namespace mesos {
@@ -23,6 +23,7 @@
 #include <process/future.hpp>
 #include <process/process.hpp>
 
+#include <stout/foreach.hpp>
 #include <stout/hashmap.hpp>
 #include <stout/try.hpp>
 
@@ -94,6 +95,9 @@ public:
       const Resources& total,
       const hashmap<FrameworkID, Resources>& used);
 
+  void addSlaves(
+      const std::vector<mesos::allocator::SlaveAddition>& slaves);
+
   void removeSlave(
       const SlaveID& slaveId);
 
@@ -153,6 +157,9 @@ public:
       const Resources& resources,
       const Option<Filters>& filters);
 
+  void batchRecoverResources(
+      const hashmap<FrameworkID, hashmap<SlaveID, Resources>>& resources);
+
   void suppressOffers(
       const FrameworkID& frameworkId,
       const std::set<std::string>& roles);
@@ -240,6 +247,22 @@ public:
       const Resources& total,
       const hashmap<FrameworkID, Resources>& used) = 0;
 
+  // Adds the agents within a single dispatch, see
+  // `mesos::allocator::Allocator::addSlaves()`.
+  virtual void addSlaves(
+      const std::vector<mesos::allocator::SlaveAddition>& slaves)
+  {
+    foreach (const mesos::allocator::SlaveAddition& slave, slaves) {
+      addSlave(
+          slave.slaveId,
+          slave.slaveInfo,
+          slave.capabilities,
+          slave.unavailability,
+          slave.total,
+          slave.used);
+    }
+  }
+
   virtual void removeSlave(
       const SlaveID& slaveId) = 0;
 
@@ -300,6 +323,9 @@ public:
       const Resources& resources,
       const Option<Filters>& filters) = 0;
 
+  virtual void batchRecoverResources(
+      const hashmap<FrameworkID, hashmap<SlaveID, Resources>>& resources) = 0;
+
   virtual void suppressOffers(
       const FrameworkID& frameworkId,
       const std::set<std::string>& roles) = 0;
@@ -475,6 +501,17 @@ inline void MesosAllocator<AllocatorProcess>::addSlave(
 }
 
 
+template <typename AllocatorProcess>
+inline void MesosAllocator<AllocatorProcess>::addSlaves(
+    const std::vector<mesos::allocator::SlaveAddition>& slaves)
+{
+  process::dispatch(
+      process,
+      &MesosAllocatorProcess::addSlaves,
+      slaves);
+}
+
+
 template <typename AllocatorProcess>
 inline void MesosAllocator<AllocatorProcess>::removeSlave(
     const SlaveID& slaveId)
@@ -655,6 +692,17 @@ inline void MesosAllocator<AllocatorProcess>::recoverResources(
 }
 
 
+template <typename AllocatorProcess>
+inline void MesosAllocator<AllocatorProcess>::batchRecoverResources(
+    const hashmap<FrameworkID, hashmap<SlaveID, Resources>>& resources)
+{
+  process::dispatch(
+      process,
+      &MesosAllocatorProcess::batchRecoverResources,
+      resources);
+}
+
+
 template <typename AllocatorProcess>
 inline void MesosAllocator<AllocatorProcess>::suppressOffers(
     const FrameworkID& frameworkId,
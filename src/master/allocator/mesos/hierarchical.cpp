@@ -1155,46 +1155,7 @@ void HierarchicalAllocatorProcess::recoverResources(
 
   string role = allocations.begin()->first;
 
-  // Updated resources allocated to framework (if framework still
-  // exists, which it might not in the event that we dispatched
-  // Master::offer before we received
-  // MesosAllocatorProcess::removeFramework or
-  // MesosAllocatorProcess::deactivateFramework, in which case we will
-  // have already recovered all of its resources).
-  if (frameworks.contains(frameworkId)) {
-    CHECK(frameworkSorters.contains(role));
-
-    const Owned<Sorter>& frameworkSorter = frameworkSorters.at(role);
-
-    if (frameworkSorter->contains(frameworkId.value())) {
-      untrackAllocatedResources(slaveId, frameworkId, resources);
-
-      // Stop tracking the framework under this role if it's no longer
-      // subscribed and no longer has resources allocated to the role.
-      if (frameworks.at(frameworkId).roles.count(role) == 0 &&
-          frameworkSorter->allocation(frameworkId.value()).empty()) {
-        untrackFrameworkUnderRole(frameworkId, role);
-      }
-    }
-  }
-
-  // Update resources allocated on slave (if slave still exists,
-  // which it might not in the event that we dispatched Master::offer
-  // before we received Allocator::removeSlave).
-  if (slaves.contains(slaveId)) {
-    Slave& slave = slaves.at(slaveId);
-
-    CHECK(slave.allocated.contains(resources))
-      << slave.allocated << " does not contain " << resources;
-
-    slave.allocated -= resources;
-
-    VLOG(1) << "Recovered " << resources
-            << " (total: " << slave.total
-            << ", allocated: " << slave.allocated << ")"
-            << " on agent " << slaveId
-            << " from framework " << frameworkId;
-  }
+  recoverAllocatedResources(frameworkId, slaveId, resources);
 
   // No need to install the filter if 'filters' is none.
   if (filters.isNone()) {
@@ -1280,6 +1241,23 @@ void HierarchicalAllocatorProcess::recoverResources(
 }
 
 
+void HierarchicalAllocatorProcess::batchRecoverResources(
+    const hashmap<FrameworkID, hashmap<SlaveID, Resources>>& resources)
+{
+  CHECK(initialized);
+
+  foreachkey (const FrameworkID& frameworkId, resources) {
+    foreachpair (const SlaveID& slaveId,
+                 const Resources& recovered,
+                 resources.at(frameworkId)) {
+      if (!recovered.empty()) {
+        recoverAllocatedResources(frameworkId, slaveId, recovered);
+      }
+    }
+  }
+}
+
+
 void HierarchicalAllocatorProcess::suppressOffers(
     const FrameworkID& frameworkId,
     const set<string>& roles_)
@@ -2790,6 +2768,58 @@ void HierarchicalAllocatorProcess::untrackAllocatedResources(
   }
 }
 
+
+void HierarchicalAllocatorProcess::recoverAllocatedResources(
+    const FrameworkID& frameworkId,
+    const SlaveID& slaveId,
+    const Resources& resources)
+{
+  // Updated resources allocated to framework (if framework still
+  // exists, which it might not in the event that we dispatched
+  // Master::offer before we received
+  // MesosAllocatorProcess::removeFramework or
+  // MesosAllocatorProcess::deactivateFramework, in which case we will
+  // have already recovered all of its resources).
+  if (frameworks.contains(frameworkId)) {
+    foreachpair (const string& role,
+                 const Resources& allocation,
+                 resources.allocations()) {
+      CHECK(frameworkSorters.contains(role));
+
+      const Owned<Sorter>& frameworkSorter = frameworkSorters.at(role);
+
+      if (frameworkSorter->contains(frameworkId.value())) {
+        untrackAllocatedResources(slaveId, frameworkId, allocation);
+
+        // Stop tracking the framework under this role if it's no longer
+        // subscribed and no longer has resources allocated to the role.
+        if (frameworks.at(frameworkId).roles.count(role) == 0 &&
+            frameworkSorter->allocation(frameworkId.value()).empty()) {
+          untrackFrameworkUnderRole(frameworkId, role);
+        }
+      }
+    }
+  }
+
+  // Update resources allocated on slave (if slave still exists,
+  // which it might not in the event that we dispatched Master::offer
+  // before we received Allocator::removeSlave).
+  if (slaves.contains(slaveId)) {
+    Slave& slave = slaves.at(slaveId);
+
+    CHECK(slave.allocated.contains(resources))
+      << slave.allocated << " does not contain " << resources;
+
+    slave.allocated -= resources;
+
+    VLOG(1) << "Recovered " << resources
+            << " (total: " << slave.total
+            << ", allocated: " << slave.allocated << ")"
+            << " on agent " << slaveId
+            << " from framework " << frameworkId;
+  }
+}
+
 } // namespace internal {
 } // namespace allocator {
 } // namespace master {
@@ -198,6 +198,9 @@ public:
       const Resources& resources,
       const Option<Filters>& filters);
 
+  void batchRecoverResources(
+      const hashmap<FrameworkID, hashmap<SlaveID, Resources>>& resources);
+
   void suppressOffers(
       const FrameworkID& frameworkId,
       const std::set<std::string>& roles);
@@ -596,6 +599,13 @@ private:
       const FrameworkID& frameworkId,
       const Resources& allocated);
 
+  // Helper to recover resources, which may be allocated to several
+  // roles, without installing any filters.
+  void recoverAllocatedResources(
+      const FrameworkID& frameworkId,
+      const SlaveID& slaveId,
+      const Resources& resources);
+
   // Helper that removes all existing offer filters for the given slave
   // id.
   void removeFilters(const SlaveID& slaveId);
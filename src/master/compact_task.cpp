@@ -0,0 +1,176 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "master/compact_task.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <string>
+
+#include <glog/logging.h>
+
+#include <stout/foreach.hpp>
+
+using std::shared_ptr;
+using std::string;
+using std::vector;
+using std::weak_ptr;
+
+namespace mesos {
+namespace internal {
+namespace master {
+
+// The number of hashes added since the last sweep which triggers the
+// next sweep, in addition to the number of hashes retained by the
+// last sweep. This amortizes the cost of sweeping over many interned
+// shapes.
+static const size_t SWEEP_THRESHOLD = 1024;
+
+
+shared_ptr<const Task> TaskShapes::intern(Task&& shape)
+{
+  // NOTE: Shapes lack required fields of `Task` (e.g., the task ID),
+  // hence the partial serialization.
+  const string serialized = shape.SerializePartialAsString();
+
+  vector<weak_ptr<const Task>>& candidates =
+    shapes[std::hash<string>()(serialized)];
+
+  auto it = candidates.begin();
+  while (it != candidates.end()) {
+    shared_ptr<const Task> candidate = it->lock();
+
+    if (!candidate) {
+      it = candidates.erase(it);
+      continue;
+    }
+
+    if (candidate->SerializePartialAsString() == serialized) {
+      return candidate;
+    }
+
+    ++it;
+  }
+
+  Task* task = new Task();
+  task->Swap(&shape);
+
+  shared_ptr<const Task> interned(task);
+  candidates.push_back(interned);
+
+  if (shapes.size() > swept + SWEEP_THRESHOLD) {
+    sweep();
+  }
+
+  return interned;
+}
+
+
+size_t TaskShapes::spaceUsed() const
+{
+  size_t bytes = 0;
+
+  foreachvalue (const vector<weak_ptr<const Task>>& candidates, shapes) {
+    foreach (const weak_ptr<const Task>& candidate, candidates) {
+      shared_ptr<const Task> shape = candidate.lock();
+      if (shape) {
+        bytes += shape->SpaceUsedLong();
+      }
+    }
+  }
+
+  return bytes;
+}
+
+
+void TaskShapes::sweep()
+{
+  auto it = shapes.begin();
+  while (it != shapes.end()) {
+    vector<weak_ptr<const Task>>& candidates = it->second;
+
+    candidates.erase(
+        std::remove_if(
+            candidates.begin(),
+            candidates.end(),
+            [](const weak_ptr<const Task>& candidate) {
+              return candidate.expired();
+            }),
+        candidates.end());
+
+    if (candidates.empty()) {
+      it = shapes.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  swept = shapes.size();
+}
+
+
+CompactTask::CompactTask(Task&& task, TaskShapes* shapes)
+{
+  CHECK_NOTNULL(shapes);
+
+  // Move the fields which vary between tasks out of `task`, the
+  // remainder of which is its shape.
+  fields.mutable_task_id()->Swap(task.mutable_task_id());
+  fields.mutable_slave_id()->Swap(task.mutable_slave_id());
+  fields.set_state(task.state());
+  fields.mutable_statuses()->Swap(task.mutable_statuses());
+
+  if (task.has_executor_id()) {
+    fields.mutable_executor_id()->Swap(task.mutable_executor_id());
+  }
+
+  if (task.has_status_update_state()) {
+    fields.set_status_update_state(task.status_update_state());
+  }
+
+  if (task.has_status_update_uuid()) {
+    fields.mutable_status_update_uuid()->swap(
+        *task.mutable_status_update_uuid());
+  }
+
+  task.clear_task_id();
+  task.clear_slave_id();
+  task.clear_state();
+  task.clear_statuses();
+  task.clear_executor_id();
+  task.clear_status_update_state();
+  task.clear_status_update_uuid();
+
+  shape = shapes->intern(std::move(task));
+}
+
+
+Task CompactTask::materialize() const
+{
+  Task task(*shape);
+  task.MergeFrom(fields);
+  return task;
+}
+
+
+size_t CompactTask::spaceUsed() const
+{
+  return sizeof(*this) - sizeof(fields) + fields.SpaceUsedLong();
+}
+
+} // namespace master {
+} // namespace internal {
+} // namespace mesos {
@@ -0,0 +1,100 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __MASTER_COMPACT_TASK_HPP__
+#define __MASTER_COMPACT_TASK_HPP__
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include <mesos/mesos.hpp>
+
+#include <stout/hashmap.hpp>
+
+namespace mesos {
+namespace internal {
+namespace master {
+
+// Interns the "shapes" of tasks, i.e., the fields which are usually
+// identical for all tasks of an application (name, resources, labels,
+// container, etc.), so that tasks with the same shape share a single
+// copy of these fields.
+class TaskShapes
+{
+public:
+  TaskShapes() : swept(0) {}
+
+  // Returns a shape equal to `shape`, reusing an existing one if possible.
+  std::shared_ptr<const Task> intern(Task&& shape);
+
+  // Returns the approximate number of bytes used by the shapes which
+  // are currently referenced by tasks.
+  size_t spaceUsed() const;
+
+private:
+  // Removes the shapes which are no longer referenced by any task.
+  void sweep();
+
+  // Shapes by the hash of their serialization. These do not keep the
+  // shapes alive; unreferenced shapes are removed when a shape with the
+  // same hash is interned, or by a periodic `sweep()`.
+  hashmap<size_t, std::vector<std::weak_ptr<const Task>>> shapes;
+
+  // The number of hashes after the last sweep.
+  size_t swept;
+};
+
+
+// A terminal task stored in compact form: only the fields which vary
+// between the tasks of an application (IDs, state and status updates)
+// are stored per task, while the remaining fields are shared with other
+// tasks of the same shape (see `TaskShapes`). The `Task` is only
+// materialized when needed, e.g., to serialize it in an endpoint.
+class CompactTask
+{
+public:
+  CompactTask(Task&& task, TaskShapes* shapes);
+
+  Task materialize() const;
+
+  const TaskID& task_id() const { return fields.task_id(); }
+  const FrameworkID& framework_id() const { return shape->framework_id(); }
+  const SlaveID& slave_id() const { return fields.slave_id(); }
+  TaskState state() const { return fields.state(); }
+
+  const google::protobuf::RepeatedPtrField<TaskStatus>& statuses() const
+  {
+    return fields.statuses();
+  }
+
+  // Returns the approximate number of bytes used by this task,
+  // excluding its shared shape.
+  size_t spaceUsed() const;
+
+private:
+  std::shared_ptr<const Task> shape;
+
+  // The fields of the task which are not part of its shape.
+  Task fields;
+};
+
+} // namespace master {
+} // namespace internal {
+} // namespace mesos {
+
+#endif // __MASTER_COMPACT_TASK_HPP__
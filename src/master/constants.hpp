@@ -83,6 +83,19 @@ constexpr double RECOVERY_AGENT_REMOVAL_PERCENT_LIMIT = 1.0; // 100%.
 // Maximum number of removed slaves to store in the cache.
 constexpr size_t MAX_REMOVED_SLAVES = 100000;
 
+// Maximum number of events sent to operator API subscribers that are
+// kept in memory to allow subscribers to resume their streams.
+constexpr size_t MAX_SUBSCRIBER_EVENTS = 10000;
+
+// Maximum number of snapshots of the cluster state kept in memory to be
+// shared between operator API subscribers.
+constexpr size_t MAX_SUBSCRIBER_SNAPSHOTS = 16;
+
+// Duration for which events are still recorded after the last operator
+// API subscriber has disconnected, so that it is able to resume its
+// stream if it reconnects within this duration.
+constexpr Duration SUBSCRIBER_RESUME_WINDOW = Minutes(5);
+
 // Default maximum number of completed frameworks to store in the cache.
 constexpr size_t DEFAULT_MAX_COMPLETED_FRAMEWORKS = 50;
 
@@ -94,6 +107,15 @@ constexpr size_t DEFAULT_MAX_COMPLETED_TASKS_PER_FRAMEWORK = 1000;
 // to store in the cache.
 constexpr size_t DEFAULT_MAX_UNREACHABLE_TASKS_PER_FRAMEWORK = 1000;
 
+// Maximum number of distinct task resources per framework whose
+// validation results are cached.
+constexpr size_t MAX_VALIDATED_RESOURCES_PER_FRAMEWORK = 100;
+
+// Maximum number of reconciliation updates the master sends to a
+// framework before yielding to other events. Larger reconciliations
+// continue in subsequent batches.
+constexpr size_t RECONCILIATION_BATCH_SIZE = 1000;
+
 // Time interval to check for updated watchers list.
 constexpr Duration WHITELIST_WATCH_INTERVAL = Seconds(5);
 
@@ -15,6 +15,7 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <deque>
 #include <iomanip>
 #include <map>
 #include <memory>
@@ -37,6 +38,7 @@
 #include <mesos/v1/master/master.hpp>
 
 #include <process/collect.hpp>
+#include <process/dispatch.hpp>
 #include <process/defer.hpp>
 #include <process/help.hpp>
 #include <process/logging.hpp>
@@ -344,13 +346,15 @@ struct FullFrameworkWriter {
     });
 
     writer->field("completed_tasks", [this](JSON::ArrayWriter* writer) {
-      foreach (const Owned<Task>& task, framework_->completedTasks) {
+      foreach (const CompactTask& compactTask, framework_->completedTasks) {
+        const Task task = compactTask.materialize();
+
         // Skip unauthorized tasks.
-        if (!authorizeTask_->accept(*task, framework_->info)) {
+        if (!authorizeTask_->accept(task, framework_->info)) {
           continue;
         }
 
-        writer->element(*task);
+        writer->element(task);
       }
 
       // Unreachable tasks belonging to a non-partition-aware framework
@@ -853,12 +857,41 @@ Future<Response> Master::Http::subscribe(
         master->authorizer,
         authorization::VIEW_ROLE);
 
+  // The acceptors below are only used to filter the missed events
+  // when the subscriber resumes its stream.
+  Future<Owned<AuthorizationAcceptor>> authorizeFramework =
+    AuthorizationAcceptor::create(
+        principal,
+        master->authorizer,
+        authorization::VIEW_FRAMEWORK);
+
+  Future<Owned<AuthorizationAcceptor>> authorizeTask =
+    AuthorizationAcceptor::create(
+        principal,
+        master->authorizer,
+        authorization::VIEW_TASK);
+
+  Future<Owned<AuthorizationAcceptor>> authorizeExecutor =
+    AuthorizationAcceptor::create(
+        principal,
+        master->authorizer,
+        authorization::VIEW_EXECUTOR);
+
   return collect(
-      frameworksApprover, tasksApprover, executorsApprover, rolesAcceptor)
+      frameworksApprover,
+      tasksApprover,
+      executorsApprover,
+      rolesAcceptor,
+      authorizeFramework,
+      authorizeTask,
+      authorizeExecutor)
     .then(defer(master->self(),
         [=](const tuple<Owned<ObjectApprover>,
                         Owned<ObjectApprover>,
                         Owned<ObjectApprover>,
+                        Owned<AuthorizationAcceptor>,
+                        Owned<AuthorizationAcceptor>,
+                        Owned<AuthorizationAcceptor>,
                         Owned<AuthorizationAcceptor>>& approvers)
             -> Future<Response> {
           // Get approver from tuple.
@@ -866,10 +899,16 @@ Future<Response> Master::Http::subscribe(
           Owned<ObjectApprover> tasksApprover;
           Owned<ObjectApprover> executorsApprover;
           Owned<AuthorizationAcceptor> rolesAcceptor;
+          Owned<AuthorizationAcceptor> authorizeFramework;
+          Owned<AuthorizationAcceptor> authorizeTask;
+          Owned<AuthorizationAcceptor> authorizeExecutor;
           tie(frameworksApprover,
               tasksApprover,
               executorsApprover,
-              rolesAcceptor) = approvers;
+              rolesAcceptor,
+              authorizeFramework,
+              authorizeTask,
+              authorizeExecutor) = approvers;
 
           Pipe pipe;
           OK ok;
@@ -878,22 +917,55 @@ Future<Response> Master::Http::subscribe(
           ok.type = Response::PIPE;
           ok.reader = pipe.reader();
 
-          HttpConnection http{pipe.writer(), contentType, id::UUID::random()};
-          master->subscribe(http, principal);
+          // Determine the events missed by the subscriber if it asked to
+          // resume its previous stream. The stream can only be resumed if
+          // it was sent by this master and the missed events have not yet
+          // been dropped, otherwise we fall back to sending a snapshot.
+          Option<vector<mesos::master::Event>> missed;
 
-          mesos::master::Event event;
-          event.set_type(mesos::master::Event::SUBSCRIBED);
-          *event.mutable_subscribed()->mutable_get_state() =
-              _getState(
-                  frameworksApprover,
-                  tasksApprover,
-                  executorsApprover,
-                  rolesAcceptor);
+          if (call.subscribe().has_resume() &&
+              call.subscribe().resume().master_id() == master->info().id()) {
+            missed =
+              master->subscribers.since(call.subscribe().resume().sequence());
+          }
 
-          event.mutable_subscribed()->set_heartbeat_interval_seconds(
-              DEFAULT_HEARTBEAT_INTERVAL.secs());
+          HttpConnection http{pipe.writer(), contentType, id::UUID::random()};
+          master->subscribe(http, principal);
 
-          http.send<mesos::master::Event, v1::master::Event>(event);
+          if (missed.isSome()) {
+            mesos::master::Event event;
+            event.set_type(mesos::master::Event::SUBSCRIBED);
+            event.mutable_subscribed()->set_heartbeat_interval_seconds(
+                DEFAULT_HEARTBEAT_INTERVAL.secs());
+            event.mutable_subscribed()->set_master_id(master->info().id());
+            event.mutable_subscribed()->set_sequence(
+                call.subscribe().resume().sequence());
+            event.mutable_subscribed()->set_resumed(true);
+
+            http.send<mesos::master::Event, v1::master::Event>(event);
+
+            // NOTE: The missed events are sent synchronously so that they
+            // precede any event sent to the subscriber from now on.
+            const Owned<Subscribers::Subscriber>& subscriber =
+              master->subscribers.subscribed.at(http.streamId);
+
+            foreach (const mesos::master::Event& event, missed.get()) {
+              subscriber->send(
+                  event,
+                  rolesAcceptor,
+                  authorizeFramework,
+                  authorizeTask,
+                  authorizeExecutor);
+            }
+          } else {
+            http.writer.write(subscribed(
+                principal,
+                contentType,
+                frameworksApprover,
+                tasksApprover,
+                executorsApprover,
+                rolesAcceptor));
+          }
 
           mesos::master::Event heartbeatEvent;
           heartbeatEvent.set_type(mesos::master::Event::HEARTBEAT);
@@ -904,6 +976,59 @@ Future<Response> Master::Http::subscribe(
 }
 
 
+string Master::Http::subscribed(
+    const Option<Principal>& principal,
+    ContentType contentType,
+    const Owned<ObjectApprover>& frameworksApprover,
+    const Owned<ObjectApprover>& tasksApprover,
+    const Owned<ObjectApprover>& executorsApprover,
+    const Owned<AuthorizationAcceptor>& rolesAcceptor) const
+{
+  // Subscribers with the same principal are authorized to view the same
+  // state, hence they can share the snapshot.
+  const string key =
+    (principal.isSome() ? stringify(principal.get()) : "") + "|" +
+    stringify(contentType);
+
+  Option<Subscribers::Snapshot> snapshot =
+    master->subscribers.snapshots.get(key);
+
+  if (snapshot.isSome() &&
+      snapshot->stateGeneration == master->stateGeneration &&
+      snapshot->sequence == master->subscribers.sequence) {
+    return snapshot->record;
+  }
+
+  mesos::master::Event event;
+  event.set_type(mesos::master::Event::SUBSCRIBED);
+  *event.mutable_subscribed()->mutable_get_state() =
+      _getState(
+          frameworksApprover,
+          tasksApprover,
+          executorsApprover,
+          rolesAcceptor);
+
+  event.mutable_subscribed()->set_heartbeat_interval_seconds(
+      DEFAULT_HEARTBEAT_INTERVAL.secs());
+  event.mutable_subscribed()->set_master_id(master->info().id());
+  event.mutable_subscribed()->set_sequence(master->subscribers.sequence);
+
+  ::recordio::Encoder<v1::master::Event> encoder(lambda::bind(
+      serialize, contentType, lambda::_1));
+
+  const string record = encoder.encode(evolve(event));
+
+  master->subscribers.snapshots.put(
+      key,
+      Subscribers::Snapshot{
+          master->stateGeneration,
+          master->subscribers.sequence,
+          record});
+
+  return record;
+}
+
+
 // TODO(ijimenez): Add some information or pointers to help
 // users understand the HTTP Event/Call API.
 string Master::Http::SCHEDULER_HELP()
@@ -942,8 +1067,6 @@ Future<Response> Master::Http::scheduler(
 
   // TODO(vinod): Add metrics for rejected requests.
 
-  // TODO(vinod): Add support for rate limiting.
-
   // When current master is not the leader, redirect to the leading master.
   // Note that this could happen if the scheduler realizes this is the
   // leading master before the master itself realizes it, e.g., due to
@@ -1106,6 +1229,41 @@ Future<Response> Master::Http::scheduler(
         + framework->id().value());
   }
 
+  // Calls are throttled by the same rate limiter as the messages of
+  // schedulers using the driver (see the `--rate_limits` flag).
+  Option<Future<Nothing>> throttled = master->throttle(framework);
+
+  if (throttled.isNone()) {
+    return ServiceUnavailable(
+        "Call dropped because the framework exceeded its capacity");
+  }
+
+  if (throttled->isReady()) {
+    return _scheduler(call, streamId);
+  }
+
+  return throttled->then(defer(master->self(), [=]() {
+    return _scheduler(call, streamId);
+  }));
+}
+
+
+Future<Response> Master::Http::_scheduler(
+    const scheduler::Call& call,
+    const string& streamId) const
+{
+  // The framework might have been removed or might have resubscribed
+  // while the call was throttled.
+  Framework* framework = master->getFramework(call.framework_id());
+
+  if (framework == nullptr ||
+      !framework->connected() ||
+      framework->http.isNone() ||
+      framework->http->streamId.toString() != streamId) {
+    return Forbidden(
+        "Framework is no longer subscribed with stream ID '" + streamId + "'");
+  }
+
   switch (call.type()) {
     case scheduler::Call::SUBSCRIBE:
       // SUBSCRIBE call should have been handled above.
@@ -1599,6 +1757,8 @@ Future<Response> Master::Http::frameworks(
                                     Owned<AuthorizationAcceptor>,
                                     IDAcceptor<FrameworkID>>& acceptors)
           -> Response {
+      master->readOnly();
+
       // This lambda is consumed before the outer lambda
       // returns, hence capture by reference is fine here.
       auto frameworks = [this, &acceptors](JSON::ObjectWriter* writer) {
@@ -2566,6 +2726,8 @@ Future<Response> Master::Http::slaves(
         [master, jsonp](const tuple<Owned<AuthorizationAcceptor>,
                                     IDAcceptor<SlaveID>>& acceptors)
           -> Future<Response> {
+      master->readOnly();
+
       Owned<AuthorizationAcceptor> authorizeRole;
       IDAcceptor<SlaveID> selectSlaveId;
       tie(authorizeRole, selectSlaveId) = acceptors;
@@ -2783,6 +2945,32 @@ string Master::Http::STATE_HELP()
         "The information shown might be filtered based on the user",
         "accessing the endpoint.",
         "",
+        "The response is streamed to the client using chunked transfer",
+        "encoding while it is being generated. The next chunk is only",
+        "generated once the client has consumed the previous one. Hence",
+        "each agent and framework reflects a consistent state, but",
+        "different agents and frameworks might reflect the master at",
+        "slightly different points in time.",
+        "",
+        "Query parameters:",
+        "",
+        ">        cursor=VALUE         Starts the agent and framework lists "
+        "right after the last agent or framework of a previous response, "
+        "as identified by the 'next_cursor' field of that response.",
+        ">        fields=VALUE         Comma separated list of the top level "
+        "fields to include (e.g., 'frameworks,slaves'). All fields are "
+        "included by default.",
+        ">        jsonp=VALUE          Name of the JSONP callback to wrap "
+        "the response into.",
+        ">        limit=VALUE          Maximum number of agents and "
+        "frameworks returned, across the 'slaves', 'recovered_slaves', "
+        "'frameworks' and 'completed_frameworks' fields (in this order). "
+        "All of them are returned by default.",
+        "",
+        "If more agents or frameworks are available than returned, the",
+        "response contains a 'next_cursor' field which can be used to",
+        "retrieve the next page.",
+        "",
         "Example (**Note**: this is not exhaustive):",
         "",
         "```",
@@ -2861,6 +3049,117 @@ string Master::Http::STATE_HELP()
 }
 
 
+// The sections of the '/state' endpoint that list agents and frameworks,
+// in the order in which they are written and paginated.
+static const char* const STATE_SECTIONS[] = {
+  "slaves",
+  "recovered_slaves",
+  "frameworks",
+  "completed_frameworks"
+};
+
+
+// Position of an agent or framework within the sections of the '/state'
+// endpoint. This is what the opaque pagination cursor of the endpoint
+// encodes, so that a page can be resumed even if the last agent or
+// framework of the previous page has been removed in the meantime.
+struct StatePosition
+{
+  StatePosition(size_t _section, const string& _id)
+    : section(_section), id(_id) {}
+
+  string cursor() const
+  {
+    JSON::Array array;
+    array.values.push_back(STATE_SECTIONS[section]);
+    array.values.push_back(id);
+
+    return base64::encode_url_safe(stringify(array), false);
+  }
+
+  static Try<StatePosition> parse(const string& cursor)
+  {
+    Try<string> decoded = base64::decode_url_safe(cursor);
+    if (decoded.isError()) {
+      return Error(decoded.error());
+    }
+
+    Try<JSON::Array> array = JSON::parse<JSON::Array>(decoded.get());
+    if (array.isError()) {
+      return Error(array.error());
+    }
+
+    const vector<JSON::Value>& values = array->values;
+
+    if (values.size() != 2 ||
+        !values[0].is<JSON::String>() ||
+        !values[1].is<JSON::String>()) {
+      return Error("Unexpected cursor format");
+    }
+
+    const string& name = values[0].as<JSON::String>().value;
+
+    for (size_t i = 0; i < utils::arraySize(STATE_SECTIONS); i++) {
+      if (name == STATE_SECTIONS[i]) {
+        return StatePosition(i, values[1].as<JSON::String>().value);
+      }
+    }
+
+    return Error("Unknown section '" + name + "'");
+  }
+
+  size_t section;
+  string id;
+};
+
+
+// A '/state' response which is being written, see `Master::Http::_state`.
+struct Master::Http::StateStream
+{
+  explicit StateStream(const Pipe::Writer& _writer) : writer(_writer) {}
+
+  Owned<AuthorizationAcceptor> authorizeRole;
+  Owned<AuthorizationAcceptor> authorizeFrameworkInfo;
+  Owned<AuthorizationAcceptor> authorizeTask;
+  Owned<AuthorizationAcceptor> authorizeExecutorInfo;
+  Owned<AuthorizationAcceptor> authorizeFlags;
+
+  FieldSelector fields;
+  Option<string> jsonp;
+  Pipe::Writer writer;
+
+  // Maximum number of agents and frameworks that remain to be written.
+  Option<size_t> limit;
+
+  // Position after which agents and frameworks are written.
+  Option<StatePosition> cursor;
+
+  // Whether the first chunk has been written.
+  bool started = false;
+
+  // Whether a field has already been written, i.e., whether the next
+  // field has to be preceded by a comma.
+  bool separate = false;
+
+  // IDs of the agents and frameworks to be written per section.
+  vector<vector<string>> ids;
+
+  // Position of the next agent or framework to write.
+  size_t section = 0;
+  size_t index = 0;
+
+  // Whether the array of the current section has been opened, and the
+  // number of elements written into it so far.
+  bool opened = false;
+  size_t elements = 0;
+
+  // Positions of the last agent or framework written, and of the one
+  // after which the next page starts.
+  Option<StatePosition> last;
+  Option<StatePosition> next;
+};
+
+
 Future<Response> Master::Http::state(
     const Request& request,
     const Option<Principal>& principal) const
@@ -2895,6 +3194,34 @@ Future<Response> Master::Http::state(
     AuthorizationAcceptor::create(
         principal, master->authorizer, authorization::VIEW_FLAGS);
 
+  FieldSelector fields(request.url.query.get("fields"));
+  Option<string> jsonp = request.url.query.get("jsonp");
+
+  Option<size_t> limit;
+  if (request.url.query.contains("limit")) {
+    Try<size_t> number = numify<size_t>(request.url.query.at("limit"));
+    if (number.isError() || number.get() == 0) {
+      return BadRequest(
+          "Failed to parse query parameter 'limit': Expecting a positive "
+          "integer");
+    }
+
+    limit = number.get();
+  }
+
+  Option<StatePosition> cursor;
+  if (request.url.query.contains("cursor")) {
+    Try<StatePosition> position =
+      StatePosition::parse(request.url.query.at("cursor"));
+
+    if (position.isError()) {
+      return BadRequest(
+          "Failed to parse query parameter 'cursor': " + position.error());
+    }
+
+    cursor = position.get();
+  }
+
   return collect(
       authorizeRole,
       authorizeFrameworkInfo,
@@ -2903,174 +3230,369 @@ Future<Response> Master::Http::state(
       authorizeFlags)
     .then(defer(
         master->self(),
-        [this, request](const tuple<Owned<AuthorizationAcceptor>,
-                                    Owned<AuthorizationAcceptor>,
-                                    Owned<AuthorizationAcceptor>,
-                                    Owned<AuthorizationAcceptor>,
-                                    Owned<AuthorizationAcceptor>>& acceptors)
+        [this, fields, jsonp, limit, cursor](
+            const tuple<Owned<AuthorizationAcceptor>,
+                        Owned<AuthorizationAcceptor>,
+                        Owned<AuthorizationAcceptor>,
+                        Owned<AuthorizationAcceptor>,
+                        Owned<AuthorizationAcceptor>>& acceptors)
           -> Response {
-      // This lambda is consumed before the outer lambda
-      // returns, hence capture by reference is fine here.
-      auto state = [this, &acceptors](JSON::ObjectWriter* writer) {
-        Owned<AuthorizationAcceptor> authorizeRole;
-        Owned<AuthorizationAcceptor> authorizeFrameworkInfo;
-        Owned<AuthorizationAcceptor> authorizeTask;
-        Owned<AuthorizationAcceptor> authorizeExecutorInfo;
-        Owned<AuthorizationAcceptor> authorizeFlags;
-        tie(authorizeRole,
-            authorizeFrameworkInfo,
-            authorizeTask,
-            authorizeExecutorInfo,
-            authorizeFlags) = acceptors;
+      master->readOnly();
+
+      Pipe pipe;
+
+      std::shared_ptr<StateStream> stream(new StateStream(pipe.writer()));
+      tie(stream->authorizeRole,
+          stream->authorizeFrameworkInfo,
+          stream->authorizeTask,
+          stream->authorizeExecutorInfo,
+          stream->authorizeFlags) = acceptors;
+      stream->fields = fields;
+      stream->jsonp = jsonp;
+      stream->limit = limit;
+      stream->cursor = cursor;
+
+      // Only the first chunk is written here, the remaining ones are
+      // written once the client has consumed the previous one.
+      _state(stream);
+
+      return streamingJSON(pipe.reader(), jsonp);
+    }));
+}
 
-        writer->field("version", MESOS_VERSION);
 
-        if (build::GIT_SHA.isSome()) {
-          writer->field("git_sha", build::GIT_SHA.get());
-        }
+void Master::Http::_state(const std::shared_ptr<StateStream>& stream) const
+{
+  master->readOnly();
 
-        if (build::GIT_BRANCH.isSome()) {
-          writer->field("git_branch", build::GIT_BRANCH.get());
-        }
+  string chunk;
 
-        if (build::GIT_TAG.isSome()) {
-          writer->field("git_tag", build::GIT_TAG.get());
-        }
+  // The first chunk starts with the fields of the document other than
+  // the agents and frameworks, which fit into a single chunk anyway.
+  // This is also when the agents and frameworks to be written are
+  // determined. Agents and frameworks added afterwards are not written,
+  // those removed in the meantime are skipped.
+  if (!stream->started) {
+    stream->started = true;
 
-        writer->field("build_date", build::DATE);
-        writer->field("build_time", build::TIME);
-        writer->field("build_user", build::USER);
-        writer->field("start_time", master->startTime.secs());
+    if (stream->jsonp.isSome()) {
+      chunk += stream->jsonp.get() + "(";
+    }
 
-        if (master->electedTime.isSome()) {
-          writer->field("elected_time", master->electedTime.get().secs());
-        }
+    const FieldSelector& fields = stream->fields;
+    const Owned<AuthorizationAcceptor>& authorizeFlags =
+      stream->authorizeFlags;
 
-        writer->field("id", master->info().id());
-        writer->field("pid", string(master->self()));
-        writer->field("hostname", master->info().hostname());
-        writer->field("capabilities", master->info().capabilities());
-        writer->field("activated_slaves", master->_slaves_active());
-        writer->field("deactivated_slaves", master->_slaves_inactive());
-        writer->field("unreachable_slaves", master->_slaves_unreachable());
+    auto header = [this, &fields, &authorizeFlags](JSON::ObjectWriter* writer) {
+      fields.field(writer, "version", MESOS_VERSION);
 
-        if (master->info().has_domain()) {
-          writer->field("domain", master->info().domain());
-        }
+      if (build::GIT_SHA.isSome()) {
+        fields.field(writer, "git_sha", build::GIT_SHA.get());
+      }
 
-        // TODO(haosdent): Deprecated this in favor of `leader_info` below.
-        if (master->leader.isSome()) {
-          writer->field("leader", master->leader->pid());
-        }
+      if (build::GIT_BRANCH.isSome()) {
+        fields.field(writer, "git_branch", build::GIT_BRANCH.get());
+      }
 
-        if (master->leader.isSome()) {
-          writer->field("leader_info", [this](JSON::ObjectWriter* writer) {
-            json(writer, master->leader.get());
-          });
-        }
+      if (build::GIT_TAG.isSome()) {
+        fields.field(writer, "git_tag", build::GIT_TAG.get());
+      }
 
-        if (authorizeFlags->accept()) {
-          if (master->flags.cluster.isSome()) {
-            writer->field("cluster", master->flags.cluster.get());
-          }
+      fields.field(writer, "build_date", build::DATE);
+      fields.field(writer, "build_time", build::TIME);
+      fields.field(writer, "build_user", build::USER);
+      fields.field(writer, "start_time", master->startTime.secs());
 
-          if (master->flags.log_dir.isSome()) {
-            writer->field("log_dir", master->flags.log_dir.get());
-          }
+      if (master->electedTime.isSome()) {
+        fields.field(writer, "elected_time", master->electedTime.get().secs());
+      }
 
-          if (master->flags.external_log_file.isSome()) {
-            writer->field("external_log_file",
-                          master->flags.external_log_file.get());
-          }
+      fields.field(writer, "id", master->info().id());
+      fields.field(writer, "pid", string(master->self()));
+      fields.field(writer, "hostname", master->info().hostname());
+      fields.field(writer, "capabilities", master->info().capabilities());
+      fields.field(writer, "activated_slaves", master->_slaves_active());
+      fields.field(writer, "deactivated_slaves", master->_slaves_inactive());
+      fields.field(writer, "unreachable_slaves", master->_slaves_unreachable());
 
-          writer->field("flags", [this](JSON::ObjectWriter* writer) {
-              foreachvalue (const flags::Flag& flag, master->flags) {
-                Option<string> value = flag.stringify(master->flags);
-                if (value.isSome()) {
-                  writer->field(flag.effective_name().value, value.get());
-                }
-              }
+      if (master->info().has_domain()) {
+        fields.field(writer, "domain", master->info().domain());
+      }
+
+      // TODO(haosdent): Deprecated this in favor of `leader_info` below.
+      if (master->leader.isSome()) {
+        fields.field(writer, "leader", master->leader->pid());
+      }
+
+      if (master->leader.isSome()) {
+        fields.field(
+            writer,
+            "leader_info",
+            [this](JSON::ObjectWriter* writer) {
+              json(writer, master->leader.get());
             });
+      }
+
+      if (authorizeFlags->accept()) {
+        if (master->flags.cluster.isSome()) {
+          fields.field(writer, "cluster", master->flags.cluster.get());
+        }
+
+        if (master->flags.log_dir.isSome()) {
+          fields.field(writer, "log_dir", master->flags.log_dir.get());
+        }
+
+        if (master->flags.external_log_file.isSome()) {
+          fields.field(
+              writer,
+              "external_log_file",
+              master->flags.external_log_file.get());
         }
 
-        // Model all of the registered slaves.
-        writer->field("slaves",
-          [this, &authorizeRole](JSON::ArrayWriter* writer) {
-            foreachvalue (Slave* slave, master->slaves.registered) {
-              writer->element(SlaveWriter(*slave, authorizeRole));
+        fields.field(writer, "flags", [this](JSON::ObjectWriter* writer) {
+            foreachvalue (const flags::Flag& flag, master->flags) {
+              Option<string> value = flag.stringify(master->flags);
+              if (value.isSome()) {
+                writer->field(flag.effective_name().value, value.get());
+              }
             }
           });
+      }
+    };
 
-        // Model all of the recovered slaves.
-        writer->field("recovered_slaves", [this](JSON::ArrayWriter* writer) {
-          foreachvalue (const SlaveInfo& slaveInfo, master->slaves.recovered) {
-            writer->element([&slaveInfo](JSON::ObjectWriter* writer) {
-              json(writer, slaveInfo);
-            });
-          }
-        });
+    // The closing brace of the object is only written once all of the
+    // sections below have been written.
+    string object = jsonify(header);
+    object.pop_back();
 
-        // Model all of the frameworks.
-        writer->field(
-            "frameworks",
-            [this,
-             &authorizeFrameworkInfo,
-             &authorizeTask,
-             &authorizeExecutorInfo](JSON::ArrayWriter* writer) {
-          foreachvalue (
-              Framework* framework,
-              master->frameworks.registered) {
-            // Skip unauthorized frameworks.
-            if (!authorizeFrameworkInfo->accept(framework->info)) {
-              continue;
-            }
+    stream->separate = object.size() > 1;
+    chunk += object;
 
-            auto frameworkWriter = FullFrameworkWriter(
-                authorizeTask,
-                authorizeExecutorInfo,
-                framework);
+    // Determine the agents and frameworks to be written, in the order
+    // in which they are paginated.
+    stream->ids.resize(utils::arraySize(STATE_SECTIONS));
 
-            writer->element(frameworkWriter);
-          }
-        });
+    foreachkey (const SlaveID& slaveId, master->slaves.registered) {
+      stream->ids[0].push_back(slaveId.value());
+    }
 
-        // Model all of the completed frameworks.
-        writer->field(
-            "completed_frameworks",
-            [this,
-             &authorizeFrameworkInfo,
-             &authorizeTask,
-             &authorizeExecutorInfo](JSON::ArrayWriter* writer) {
-          foreachvalue (const Owned<Framework>& framework,
-                        master->frameworks.completed) {
-            // Skip unauthorized frameworks.
-            if (!authorizeFrameworkInfo->accept(framework->info)) {
-              continue;
-            }
+    foreachkey (const SlaveID& slaveId, master->slaves.recovered) {
+      stream->ids[1].push_back(slaveId.value());
+    }
 
-            auto frameworkWriter = FullFrameworkWriter(
-                authorizeTask,
-                authorizeExecutorInfo,
-                framework.get());
+    foreachkey (const FrameworkID& frameworkId, master->frameworks.registered) {
+      stream->ids[2].push_back(frameworkId.value());
+    }
 
-            writer->element(frameworkWriter);
-          }
-        });
+    foreachkey (const FrameworkID& frameworkId, master->frameworks.completed) {
+      stream->ids[3].push_back(frameworkId.value());
+    }
 
-        // Orphan tasks are no longer possible. We emit an empty array
-        // for the sake of backward compatibility.
-        writer->field("orphan_tasks", [](JSON::ArrayWriter*) {});
+    for (size_t section = 0; section < stream->ids.size(); section++) {
+      vector<string>& ids = stream->ids[section];
 
-        // Unregistered frameworks are no longer possible. We emit an
-        // empty array for the sake of backward compatibility.
-        writer->field("unregistered_frameworks", [](JSON::ArrayWriter*) {});
-      };
+      if (!stream->fields.accept(STATE_SECTIONS[section])) {
+        ids.clear();
+        continue;
+      }
+
+      std::sort(ids.begin(), ids.end());
+
+      // Skip the agents and frameworks up to and including the position
+      // of the cursor.
+      if (stream->cursor.isSome()) {
+        if (section < stream->cursor->section) {
+          ids.clear();
+        } else if (section == stream->cursor->section) {
+          ids.erase(
+              ids.begin(),
+              std::upper_bound(ids.begin(), ids.end(), stream->cursor->id));
+        }
+      }
+    }
+  }
+
+  while (chunk.size() < DEFAULT_JSON_CHUNK_SIZE &&
+         stream->section < stream->ids.size()) {
+    const size_t section = stream->section;
+    const vector<string>& ids = stream->ids[section];
+
+    if (!stream->fields.accept(STATE_SECTIONS[section])) {
+      stream->section++;
+      continue;
+    }
+
+    if (stream->index == 0 && !stream->opened) {
+      if (stream->separate) {
+        chunk += ",";
+      }
+
+      chunk += "\"" + string(STATE_SECTIONS[section]) + "\":[";
+
+      stream->separate = true;
+      stream->opened = true;
+      stream->elements = 0;
+    }
+
+    if (stream->index < ids.size() &&
+        (stream->limit.isNone() || stream->limit.get() > 0)) {
+      const string& id = ids[stream->index++];
+
+      Option<string> element = stateElement(*stream, section, id);
+      if (element.isNone()) {
+        continue;
+      }
+
+      if (stream->elements > 0) {
+        chunk += ",";
+      }
+
+      chunk += element.get();
+
+      stream->elements++;
+      stream->last = StatePosition(section, id);
+
+      if (stream->limit.isSome()) {
+        stream->limit = stream->limit.get() - 1;
+      }
+
+      continue;
+    }
+
+    chunk += "]";
+
+    // Once the limit has been reached, the remaining sections are
+    // written as empty arrays and the position of the last agent or
+    // framework written allows the client to request the next page.
+    if (stream->index < ids.size()) {
+      CHECK_SOME(stream->last);
+      stream->next = stream->last;
+    }
+
+    stream->section++;
+    stream->index = 0;
+    stream->opened = false;
+  }
+
+  const bool done = stream->section == stream->ids.size();
+
+  if (done) {
+    // Orphan tasks are no longer possible. We emit an empty array
+    // for the sake of backward compatibility.
+    if (stream->fields.accept("orphan_tasks")) {
+      chunk += string(stream->separate ? "," : "") + "\"orphan_tasks\":[]";
+      stream->separate = true;
+    }
+
+    // Unregistered frameworks are no longer possible. We emit an
+    // empty array for the sake of backward compatibility.
+    if (stream->fields.accept("unregistered_frameworks")) {
+      chunk += string(stream->separate ? "," : "") +
+        "\"unregistered_frameworks\":[]";
+      stream->separate = true;
+    }
 
-      return OK(jsonify(state), request.url.query.get("jsonp"));
+    if (stream->next.isSome()) {
+      chunk += string(stream->separate ? "," : "") +
+        "\"next_cursor\":" + stringify(JSON::String(stream->next->cursor()));
+    }
+
+    chunk += "}";
+
+    if (stream->jsonp.isSome()) {
+      chunk += ");";
+    }
+  }
+
+  // Stop writing if the client has gone away.
+  if (!stream->writer.write(chunk)) {
+    return;
+  }
+
+  if (done) {
+    stream->writer.close();
+    return;
+  }
+
+  // The next chunk is only produced once the client has consumed
+  // this one, which bounds the amount of memory used per response
+  // and spreads the work over multiple dispatches so that other
+  // events can be processed by the master in between.
+  stream->writer.drained()
+    .onAny(defer(master->self(), [this, stream](const Future<Nothing>&) {
+      _state(stream);
     }));
 }
 
 
+Option<string> Master::Http::stateElement(
+    const StateStream& stream,
+    size_t section,
+    const string& id) const
+{
+  switch (section) {
+    case 0: {
+      SlaveID slaveId;
+      slaveId.set_value(id);
+
+      Slave* slave = master->slaves.registered.get(slaveId);
+      if (slave == nullptr) {
+        return None();
+      }
+
+      return string(jsonify(SlaveWriter(*slave, stream.authorizeRole)));
+    }
+    case 1: {
+      SlaveID slaveId;
+      slaveId.set_value(id);
+
+      if (!master->slaves.recovered.contains(slaveId)) {
+        return None();
+      }
+
+      const SlaveInfo& slaveInfo = master->slaves.recovered.at(slaveId);
+
+      return string(jsonify([&slaveInfo](JSON::ObjectWriter* writer) {
+        json(writer, slaveInfo);
+      }));
+    }
+    case 2:
+    case 3: {
+      FrameworkID frameworkId;
+      frameworkId.set_value(id);
+
+      const Framework* framework = nullptr;
+
+      if (section == 2) {
+        if (master->frameworks.registered.contains(frameworkId)) {
+          framework = master->frameworks.registered.at(frameworkId);
+        }
+      } else {
+        Option<Owned<Framework>> completed =
+          master->frameworks.completed.get(frameworkId);
+
+        if (completed.isSome()) {
+          framework = completed->get();
+        }
+      }
+
+      // Skip removed and unauthorized frameworks.
+      if (framework == nullptr ||
+          !stream.authorizeFrameworkInfo->accept(framework->info)) {
+        return None();
+      }
+
+      return string(jsonify(FullFrameworkWriter(
+          stream.authorizeTask,
+          stream.authorizeExecutorInfo,
+          framework)));
+    }
+  }
+
+  UNREACHABLE();
+}
+
+
 Future<Response> Master::Http::readFile(
     const mesos::master::Call& call,
     const Option<Principal>& principal,
@@ -3148,9 +3670,9 @@ public:
         slavesToFrameworks[task->slave_id()].insert(frameworkId);
       }
 
-      foreach (const Owned<Task>& task, framework->completedTasks) {
-        frameworksToSlaves[frameworkId].insert(task->slave_id());
-        slavesToFrameworks[task->slave_id()].insert(frameworkId);
+      foreach (const CompactTask& task, framework->completedTasks) {
+        frameworksToSlaves[frameworkId].insert(task.slave_id());
+        slavesToFrameworks[task.slave_id()].insert(frameworkId);
       }
     }
   }
@@ -3202,7 +3724,12 @@ struct TaskStateSummary
   // Account for the state of the given task.
   void count(const Task& task)
   {
-    switch (task.state()) {
+    count(task.state());
+  }
+
+  void count(const TaskState& state)
+  {
+    switch (state) {
       case TASK_STAGING: { ++staging; break; }
       case TASK_STARTING: { ++starting; break; }
       case TASK_RUNNING: { ++running; break; }
@@ -3269,9 +3796,9 @@ public:
         slaveTaskSummaries[task->slave_id()].count(*task);
       }
 
-      foreach (const Owned<Task>& task, framework->completedTasks) {
-        frameworkTaskSummaries[frameworkId].count(*task);
-        slaveTaskSummaries[task->slave_id()].count(*task);
+      foreach (const CompactTask& task, framework->completedTasks) {
+        frameworkTaskSummaries[frameworkId].count(task.state());
+        slaveTaskSummaries[task.slave_id()].count(task.state());
       }
     }
   }
@@ -3351,9 +3878,23 @@ Future<Response> Master::Http::stateSummary(
 
   return collect(authorizeRole, authorizeFrameworkInfo).then(defer(
       master->self(),
-      [this, request](const tuple<Owned<AuthorizationAcceptor>,
-                                  Owned<AuthorizationAcceptor>>& acceptors)
+      [this, request, principal](
+          const tuple<Owned<AuthorizationAcceptor>,
+                      Owned<AuthorizationAcceptor>>& acceptors)
           -> Response {
+        master->readOnly();
+
+        // Serve the cached response if the master's state has not
+        // changed since it was computed.
+        const uint64_t generation = master->stateGeneration;
+
+        Option<Response> cached =
+          stateSummaryCache.get(request, principal, generation);
+
+        if (cached.isSome()) {
+          return cached.get();
+        }
+
         auto stateSummary = [this, &acceptors](JSON::ObjectWriter* writer) {
           Owned<AuthorizationAcceptor> authorizeRole;
           Owned<AuthorizationAcceptor> authorizeFrameworkInfo;
@@ -3490,7 +4031,11 @@ Future<Response> Master::Http::stateSummary(
               });
         };
 
-        return OK(jsonify(stateSummary), request.url.query.get("jsonp"));
+        return stateSummaryCache.put(
+            request,
+            principal,
+            generation,
+            OK(jsonify(stateSummary), request.url.query.get("jsonp")));
       }));
 }
 
@@ -3580,6 +4125,8 @@ Future<vector<string>> Master::Http::_roles(
     .then(defer(master->self(),
         [this](const Owned<ObjectApprover>& rolesApprover)
           -> vector<string> {
+      master->readOnly();
+
       JSON::Object object;
 
       // Compute the role names to return results for. When an explicit
@@ -3643,6 +4190,8 @@ Future<Response> Master::Http::roles(
     .then(defer(master->self(),
         [this, request](const vector<string>& filteredRoles)
           -> Response {
+      master->readOnly();
+
       JSON::Object object;
 
       {
@@ -3912,46 +4461,196 @@ Future<Response> Master::Http::teardown(
 }
 
 
-struct TaskComparator
+// Position of a task within the order used by the '/tasks' endpoint.
+// This is what the opaque pagination cursor of the endpoint encodes,
+// so that a page can be resumed even if the last task of the previous
+// page has been removed in the meantime.
+struct TaskPosition
 {
-  static bool ascending(const Task* lhs, const Task* rhs)
+  // Works for both `Task` and `CompactTask`.
+  template <typename T>
+  explicit TaskPosition(const T& task)
+    : frameworkId(task.framework_id().value()),
+      taskId(task.task_id().value())
+  {
+    if (task.statuses().size() > 0) {
+      timestamp = task.statuses().Get(0).timestamp();
+    }
+  }
+
+  TaskPosition(
+      const Option<double>& _timestamp,
+      const string& _frameworkId,
+      const string& _taskId)
+    : timestamp(_timestamp), frameworkId(_frameworkId), taskId(_taskId) {}
+
+  string cursor() const
+  {
+    JSON::Array array;
+
+    // NOTE: The timestamp is encoded as a string with enough digits to
+    // survive the round trip, which is not the case for JSON numbers.
+    if (timestamp.isSome()) {
+      array.values.push_back(strings::format("%.17g", timestamp.get()).get());
+    } else {
+      array.values.push_back(JSON::Null());
+    }
+
+    array.values.push_back(frameworkId);
+    array.values.push_back(taskId);
+
+    return base64::encode_url_safe(stringify(array), false);
+  }
+
+  static Try<TaskPosition> parse(const string& cursor)
   {
-    size_t lhsSize = lhs->statuses().size();
-    size_t rhsSize = rhs->statuses().size();
+    Try<string> decoded = base64::decode_url_safe(cursor);
+    if (decoded.isError()) {
+      return Error(decoded.error());
+    }
 
-    if ((lhsSize == 0) && (rhsSize == 0)) {
-      return false;
+    Try<JSON::Array> array = JSON::parse<JSON::Array>(decoded.get());
+    if (array.isError()) {
+      return Error(array.error());
     }
 
-    if (lhsSize == 0) {
-      return true;
+    const vector<JSON::Value>& values = array->values;
+
+    if (values.size() != 3 ||
+        !(values[0].is<JSON::String>() || values[0].is<JSON::Null>()) ||
+        !values[1].is<JSON::String>() ||
+        !values[2].is<JSON::String>()) {
+      return Error("Unexpected cursor format");
     }
 
-    if (rhsSize == 0) {
-      return false;
+    Option<double> timestamp;
+    if (values[0].is<JSON::String>()) {
+      Try<double> number =
+        numify<double>(values[0].as<JSON::String>().value);
+
+      if (number.isError()) {
+        return Error("Invalid timestamp: " + number.error());
+      }
+
+      timestamp = number.get();
     }
 
-    return (lhs->statuses(0).timestamp() < rhs->statuses(0).timestamp());
+    return TaskPosition(
+        timestamp,
+        values[1].as<JSON::String>().value,
+        values[2].as<JSON::String>().value);
   }
 
-  static bool descending(const Task* lhs, const Task* rhs)
+  Option<double> timestamp;
+  string frameworkId;
+  string taskId;
+};
+
+
+// Orders tasks by the timestamp of their earliest status. Tasks without
+// any status are considered to be the oldest. Ties are broken by the
+// framework ID and task ID in order to make the order total, which is
+// required for cursor based pagination.
+// A task listed by the '/tasks' endpoint. Exactly one of `task` and
+// `completedTask` is set. Completed tasks are kept in compact form while
+// the list is sorted and paged, and only materialized if they are part
+// of the response (or have to be authorized).
+struct TaskEntry
+{
+  const Framework* framework;
+  const Task* task;
+  const CompactTask* completedTask;
+};
+
+
+struct TaskComparator
+{
+  static bool ascending(const TaskEntry& lhs, const TaskEntry& rhs)
   {
-    size_t lhsSize = lhs->statuses().size();
-    size_t rhsSize = rhs->statuses().size();
+    return compare(lhs, rhs) < 0;
+  }
 
-    if ((lhsSize == 0) && (rhsSize == 0)) {
-      return false;
+  static bool descending(const TaskEntry& lhs, const TaskEntry& rhs)
+  {
+    return compare(lhs, rhs) > 0;
+  }
+
+  template <typename L, typename R>
+  static int compare(const L& lhs, const R& rhs)
+  {
+    const Option<double> lhsTimestamp = timestamp(lhs);
+    const Option<double> rhsTimestamp = timestamp(rhs);
+
+    if (lhsTimestamp.isNone() != rhsTimestamp.isNone()) {
+      return lhsTimestamp.isNone() ? -1 : 1;
     }
 
-    if (rhsSize == 0) {
-      return true;
+    if (lhsTimestamp.isSome() && lhsTimestamp.get() != rhsTimestamp.get()) {
+      return lhsTimestamp.get() < rhsTimestamp.get() ? -1 : 1;
     }
 
-    if (lhsSize == 0) {
-      return false;
+    int result = frameworkId(lhs).compare(frameworkId(rhs));
+    if (result != 0) {
+      return result;
     }
 
-    return (lhs->statuses(0).timestamp() > rhs->statuses(0).timestamp());
+    return taskId(lhs).compare(taskId(rhs));
+  }
+
+private:
+  // Works for both `Task` and `CompactTask`.
+  template <typename T>
+  static Option<double> timestamp(const T& task)
+  {
+    if (task.statuses().size() == 0) {
+      return None();
+    }
+
+    return task.statuses().Get(0).timestamp();
+  }
+
+  static Option<double> timestamp(const TaskEntry& entry)
+  {
+    return entry.task != nullptr
+      ? timestamp(*entry.task)
+      : timestamp(*entry.completedTask);
+  }
+
+  static Option<double> timestamp(const TaskPosition& position)
+  {
+    return position.timestamp;
+  }
+
+  static const string& frameworkId(const Task& task)
+  {
+    return task.framework_id().value();
+  }
+
+  static const string& frameworkId(const TaskPosition& position)
+  {
+    return position.frameworkId;
+  }
+
+  static const string& frameworkId(const TaskEntry& entry)
+  {
+    return entry.framework->id().value();
+  }
+
+  static const string& taskId(const Task& task)
+  {
+    return task.task_id().value();
+  }
+
+  static const string& taskId(const TaskPosition& position)
+  {
+    return position.taskId;
+  }
+
+  static const string& taskId(const TaskEntry& entry)
+  {
+    return entry.task != nullptr
+      ? entry.task->task_id().value()
+      : entry.completedTask->task_id().value();
   }
 };
 
@@ -3976,6 +4675,13 @@ string Master::Http::TASKS_HELP()
         "",
         "Query parameters:",
         "",
+        ">        cursor=VALUE         Starts task list right after the "
+        "last task of a previous response, as identified by the "
+        "'next_cursor' field of that response. Unlike 'offset' this is "
+        "stable while tasks are being added or removed.",
+        ">        fields=VALUE         Comma separated list of the task "
+        "fields to include (e.g., 'id,state'). All fields are included "
+        "by default.",
         ">        framework_id=VALUE   Only return tasks belonging to the "
         "framework with this ID.",
         ">        limit=VALUE          Maximum number of tasks returned "
@@ -3983,8 +4689,13 @@ string Master::Http::TASKS_HELP()
         ">        offset=VALUE         Starts task list at offset.",
         ">        order=(asc|desc)     Ascending or descending sort order "
         "(default is descending).",
+        ">        state=VALUE          Only return tasks in this state "
+        "(e.g., 'TASK_RUNNING').",
         ">        task_id=VALUE        Only return tasks with this ID "
-        "(should be used together with parameter 'framework_id')."
+        "(should be used together with parameter 'framework_id').",
+        "",
+        "If more tasks are available than returned, the response contains",
+        "a 'next_cursor' field which can be used to retrieve the next page."
         ""),
     AUTHENTICATION(true),
     AUTHORIZATION(
@@ -4023,6 +4734,32 @@ Future<Response> Master::Http::tasks(
   Option<string> order = request.url.query.get("order");
   string _order = order.isSome() && (order.get() == "asc") ? "asc" : "des";
 
+  Option<TaskPosition> cursor;
+  if (request.url.query.contains("cursor")) {
+    Try<TaskPosition> position =
+      TaskPosition::parse(request.url.query.at("cursor"));
+
+    if (position.isError()) {
+      return BadRequest(
+          "Failed to parse query parameter 'cursor': " + position.error());
+    }
+
+    cursor = position.get();
+  }
+
+  Option<TaskState> state;
+  if (request.url.query.contains("state")) {
+    TaskState _state;
+    if (!TaskState_Parse(request.url.query.at("state"), &_state)) {
+      return BadRequest(
+          "Unknown task state '" + request.url.query.at("state") + "'");
+    }
+
+    state = _state;
+  }
+
+  FieldSelector fields(request.url.query.get("fields"));
+
   Future<Owned<AuthorizationAcceptor>> authorizeFrameworkInfo =
     AuthorizationAcceptor::create(
         principal,
@@ -4049,6 +4786,8 @@ Future<Response> Master::Http::tasks(
                         Owned<AuthorizationAcceptor>,
                         IDAcceptor<FrameworkID>,
                         IDAcceptor<TaskID>>& acceptors)-> Future<Response> {
+          master->readOnly();
+
           Owned<AuthorizationAcceptor> authorizeFrameworkInfo;
           Owned<AuthorizationAcceptor> authorizeTask;
           IDAcceptor<FrameworkID> selectFrameworkId;
@@ -4085,39 +4824,44 @@ Future<Response> Master::Http::tasks(
 
           // Construct task list with both running,
           // completed and unreachable tasks.
-          vector<const Task*> tasks;
+          vector<TaskEntry> tasks;
           foreach (const Framework* framework, frameworks) {
             foreachvalue (Task* task, framework->tasks) {
               CHECK_NOTNULL(task);
-              // Skip unauthorized tasks or tasks without matching task ID.
+              // Skip unauthorized tasks or tasks without matching task ID
+              // or state.
               if (!selectTaskId.accept(task->task_id()) ||
+                  (state.isSome() && task->state() != state.get()) ||
                   !authorizeTask->accept(*task, framework->info)) {
                 continue;
               }
 
-              tasks.push_back(task);
+              tasks.push_back({framework, task, nullptr});
             }
 
             foreachvalue (
                 const Owned<Task>& task,
                 framework->unreachableTasks) {
-              // Skip unauthorized tasks or tasks without matching task ID.
+              // Skip unauthorized tasks or tasks without matching task ID
+              // or state.
               if (!selectTaskId.accept(task->task_id()) ||
+                  (state.isSome() && task->state() != state.get()) ||
                   !authorizeTask->accept(*task, framework->info)) {
                 continue;
               }
 
-              tasks.push_back(task.get());
+              tasks.push_back({framework, task.get(), nullptr});
             }
 
-            foreach (const Owned<Task>& task, framework->completedTasks) {
-              // Skip unauthorized tasks or tasks without matching task ID.
-              if (!selectTaskId.accept(task->task_id()) ||
-                  !authorizeTask->accept(*task, framework->info)) {
+            foreach (const CompactTask& task, framework->completedTasks) {
+              // Skip tasks without matching task ID or state. These are
+              // authorized below, once materialized.
+              if (!selectTaskId.accept(task.task_id()) ||
+                  (state.isSome() && task.state() != state.get())) {
                 continue;
               }
 
-              tasks.push_back(task.get());
+              tasks.push_back({framework, nullptr, &task});
             }
           }
 
@@ -4130,16 +4874,79 @@ Future<Response> Master::Http::tasks(
             sort(tasks.begin(), tasks.end(), TaskComparator::descending);
           }
 
+          // Resume right after the position encoded in the cursor.
+          size_t begin = 0;
+          if (cursor.isSome()) {
+            auto after = [&_order](
+                const TaskPosition& position,
+                const TaskEntry& task) {
+              int result = TaskComparator::compare(position, task);
+              return _order == "asc" ? result < 0 : result > 0;
+            };
+
+            begin = std::upper_bound(
+                tasks.begin(),
+                tasks.end(),
+                cursor.get(),
+                after) - tasks.begin();
+          }
+
+          // Collect 'limit' number of authorized tasks starting from
+          // 'offset'. Completed tasks are materialized one at a time to
+          // be authorized, and only kept if they are part of the page.
+          // Materialized tasks are stored in `completedTasks`, which must
+          // outlive `page`.
+          std::deque<Task> completedTasks;
+          vector<const Task*> page;
+          size_t skip = offset;
+          bool more = false;
+
+          for (size_t i = begin; i < tasks.size(); i++) {
+            const TaskEntry& entry = tasks[i];
+
+            const Task* task = entry.task;
+            if (task == nullptr) {
+              completedTasks.push_back(entry.completedTask->materialize());
+              task = &completedTasks.back();
+
+              // Skip unauthorized tasks.
+              if (!authorizeTask->accept(*task, entry.framework->info)) {
+                completedTasks.pop_back();
+                continue;
+              }
+            }
+
+            if (page.size() == limit) {
+              more = true;
+              break;
+            }
+
+            if (skip > 0) {
+              if (entry.task == nullptr) {
+                completedTasks.pop_back();
+              }
+
+              skip--;
+              continue;
+            }
+
+            page.push_back(task);
+          }
+
           auto tasksWriter =
-            [&tasks, limit, offset](JSON::ObjectWriter* writer) {
+            [&page, &fields, more](JSON::ObjectWriter* writer) {
             writer->field("tasks",
-                          [&tasks, limit, offset](JSON::ArrayWriter* writer) {
-              // Collect 'limit' number of tasks starting from 'offset'.
-              size_t end = std::min(offset + limit, tasks.size());
-              for (size_t i = offset; i < end; i++) {
-                writer->element(*tasks[i]);
+                          [&page, &fields](JSON::ArrayWriter* writer) {
+              foreach (const Task* task, page) {
+                writer->element([task, &fields](JSON::ObjectWriter* writer) {
+                  json(writer, *task, fields);
+                });
               }
             });
+
+            if (more && !page.empty()) {
+              writer->field("next_cursor", TaskPosition(*page.back()).cursor());
+            }
           };
 
           return OK(jsonify(tasksWriter), request.url.query.get("jsonp"));
@@ -4262,13 +5069,15 @@ mesos::master::Response::GetTasks Master::Http::_getTasks(
     }
 
     // Completed tasks.
-    foreach (const Owned<Task>& task, framework->completedTasks) {
+    foreach (const CompactTask& compactTask, framework->completedTasks) {
+      Task task = compactTask.materialize();
+
       // Skip unauthorized tasks.
-      if (!approveViewTask(tasksApprover, *task, framework->info)) {
+      if (!approveViewTask(tasksApprover, task, framework->info)) {
         continue;
       }
 
-      getTasks.add_completed_tasks()->CopyFrom(*task);
+      getTasks.add_completed_tasks()->Swap(&task);
     }
   }
 
@@ -4488,9 +5297,9 @@ Future<Response> Master::Http::___updateMaintenanceSchedule(
     }
   }
 
-  // NOTE: Copies are needed because `updateUnavailability()` in this loop
-  // modifies the container.
-  foreachkey (const MachineID& id, utils::copy(master->machines)) {
+  // NOTE: The keys are copied because `updateUnavailability()` in this
+  // loop modifies the container.
+  foreach (const MachineID& id, master->machines.keys()) {
     // Update the `unavailability` for each existing machine, except for
     // machines going from `UP` to `DRAINING` (handled in the next loop).
     // Each machine will only be touched by 1 of the 2 loops here to
@@ -4507,6 +5316,14 @@ Future<Response> Master::Http::___updateMaintenanceSchedule(
       continue;
     }
 
+    // Machines which are `UP` without an unavailability are not affected
+    // by the schedule. Skipping them avoids rescinding all offers in the
+    // cluster whenever the schedule changes.
+    if (master->machines[id].info.mode() == MachineInfo::UP &&
+        !master->machines[id].info.has_unavailability()) {
+      continue;
+    }
+
     // Transition each removed machine back to the `UP` mode and remove the
     // unavailability.
     master->machines[id].info.set_mode(MachineInfo::UP);
@@ -99,6 +99,7 @@
 using google::protobuf::RepeatedPtrField;
 
 using std::list;
+using std::pair;
 using std::reference_wrapper;
 using std::set;
 using std::shared_ptr;
@@ -320,7 +321,9 @@ Master::Master(
     frameworks(flags),
     authenticator(None()),
     metrics(new Metrics(*this)),
-    electedTime(None())
+    electedTime(None()),
+    stateGeneration(0),
+    readOnlyEvent(false)
 {
   slaves.limiter = _slaveRemovalLimiter;
 
@@ -902,7 +905,8 @@ void Master::initialize()
         [this](const process::http::Request& request,
                const Option<Principal>& principal) {
           logRequest(request);
-          return http.api(request, principal);
+          return metrics->http_api_latency.time<Milliseconds>(
+              http.api(request, principal));
         });
   route("/api/v1/scheduler",
         DEFAULT_HTTP_FRAMEWORK_AUTHENTICATION_REALM,
@@ -910,7 +914,8 @@ void Master::initialize()
         [this](const process::http::Request& request,
                const Option<Principal>& principal) {
           logRequest(request);
-          return http.scheduler(request, principal);
+          return metrics->http_api_latency.time<Milliseconds>(
+              http.scheduler(request, principal));
         });
   route("/create-volumes",
         READWRITE_HTTP_AUTHENTICATION_REALM,
@@ -1154,6 +1159,10 @@ void Master::finalize()
   // TODO(vinod): Fix the above race by changing the allocator
   // interface to return a stream of offer events.
 
+  // Return the resources of removable tasks to the allocator before
+  // the slaves are removed from it.
+  _recoverTaskResources();
+
   // Remove the slaves.
   foreachvalue (Slave* slave, slaves.registered) {
     // We first remove the slave from the allocator so that any
@@ -1461,6 +1470,29 @@ Future<bool> Master::authorizeLogAccess(const Option<Principal>& principal)
 }
 
 
+void Master::serve(process::Event&& event)
+{
+  // Any event might change the state exposed by the read-only endpoints,
+  // hence `stateGeneration` is advanced here once per event rather than
+  // by each of the handlers changing the state, which would be easy to
+  // miss when adding a handler. Only events which are known to merely
+  // read the state do not advance it: HTTP requests which are read-only
+  // by their method, and events marked via `readOnly()`.
+  readOnlyEvent = false;
+
+  if (event.is<process::HttpEvent>()) {
+    const string& method = event.as<process::HttpEvent>().request->method;
+    readOnlyEvent = method == "GET" || method == "HEAD";
+  }
+
+  ProcessBase::serve(std::move(event));
+
+  if (!readOnlyEvent) {
+    stateGeneration++;
+  }
+}
+
+
 void Master::consume(MessageEvent&& event)
 {
   // There are three cases about the message's UPID with respect to
@@ -1533,6 +1565,10 @@ void Master::consume(MessageEvent&& event)
 
     if (limiter->capacity.isNone() ||
         limiter->messages < limiter->capacity.get()) {
+      Counter messages_throttled =
+        metrics->frameworks.get(principal.get()).get()->messages_throttled;
+      ++messages_throttled;
+
       limiter->messages++;
       limiter->limiter->acquire()
         .onReady(defer(self(), &Self::throttled, std::move(event), principal));
@@ -1549,6 +1585,12 @@ void Master::consume(MessageEvent&& event)
     if (frameworks.defaultLimiter.get()->capacity.isNone() ||
         frameworks.defaultLimiter.get()->messages <
           frameworks.defaultLimiter.get()->capacity.get()) {
+      if (principal.isSome() && metrics->frameworks.contains(principal.get())) {
+        Counter messages_throttled =
+          metrics->frameworks.get(principal.get()).get()->messages_throttled;
+        ++messages_throttled;
+      }
+
       frameworks.defaultLimiter.get()->messages++;
       frameworks.defaultLimiter.get()->limiter->acquire()
         .onReady(defer(self(), &Self::throttled, std::move(event), None()));
@@ -1653,6 +1695,12 @@ void Master::exceededCapacity(
                << (principal.isSome() ? "(" + principal.get() + ")" : "")
                << ": capacity(" << capacity << ") exceeded";
 
+  if (principal.isSome() && metrics->frameworks.contains(principal.get())) {
+    Counter messages_dropped =
+      metrics->frameworks.get(principal.get()).get()->messages_dropped;
+    ++messages_dropped;
+  }
+
   // Send an error to the framework which will abort the scheduler
   // driver.
   // NOTE: The scheduler driver will send back a
@@ -1667,6 +1715,61 @@ void Master::exceededCapacity(
 }
 
 
+Option<Future<Nothing>> Master::throttle(Framework* framework)
+{
+  CHECK_NOTNULL(framework);
+
+  const Option<string> principal = framework->info.has_principal()
+    ? Option<string>(framework->info.principal())
+    : Option<string>::none();
+
+  // Pick the RateLimiter in the same way as `consume()` does for
+  // messages from a registered framework.
+  BoundedRateLimiter* limiter = nullptr;
+  if (principal.isSome() && frameworks.limiters.contains(principal.get())) {
+    if (frameworks.limiters.at(principal.get()).isSome()) {
+      limiter = frameworks.limiters.at(principal.get())->get();
+    }
+  } else if (frameworks.defaultLimiter.isSome()) {
+    limiter = frameworks.defaultLimiter->get();
+  }
+
+  if (limiter == nullptr) {
+    return Future<Nothing>(Nothing());
+  }
+
+  Metrics::Frameworks* frameworkMetrics = nullptr;
+  if (principal.isSome() && metrics->frameworks.contains(principal.get())) {
+    frameworkMetrics = metrics->frameworks.at(principal.get()).get();
+  }
+
+  if (limiter->capacity.isSome() &&
+      limiter->messages >= limiter->capacity.get()) {
+    LOG(WARNING) << "Dropping call from framework " << *framework
+                 << ": capacity(" << limiter->capacity.get() << ") exceeded";
+
+    if (frameworkMetrics != nullptr) {
+      ++frameworkMetrics->messages_dropped;
+    }
+
+    return None();
+  }
+
+  if (frameworkMetrics != nullptr) {
+    ++frameworkMetrics->messages_throttled;
+  }
+
+  // NOTE: The limiters live as long as the master, hence it is safe to
+  // refer to them after the call was throttled.
+  limiter->messages++;
+  return limiter->limiter->acquire()
+    .then(defer(self(), [limiter]() {
+      limiter->messages--;
+      return Nothing();
+    }));
+}
+
+
 void Master::_consume(ExitedEvent&& event)
 {
   Process<Master>::consume(std::move(event));
@@ -2765,7 +2868,7 @@ void Master::_subscribe(
     // Start the heartbeat after sending SUBSCRIBED event.
     framework->heartbeat();
 
-    if (!subscribers.subscribed.empty()) {
+    if (subscribers.active()) {
       subscribers.send(
           protobuf::master::event::createFrameworkAdded(*framework));
     }
@@ -2816,7 +2919,7 @@ void Master::_subscribe(
     }
   }
 
-  if (!subscribers.subscribed.empty()) {
+  if (subscribers.active()) {
     subscribers.send(
         protobuf::master::event::createFrameworkUpdated(*framework));
   }
@@ -3070,7 +3173,7 @@ void Master::_subscribe(
     message.mutable_master_info()->MergeFrom(info_);
     framework->send(message);
 
-    if (!subscribers.subscribed.empty()) {
+    if (subscribers.active()) {
       subscribers.send(
           protobuf::master::event::createFrameworkAdded(*framework));
     }
@@ -3147,7 +3250,7 @@ void Master::_subscribe(
       LOG(INFO) << "Framework " << *framework << " failed over";
       failoverFramework(framework, from);
 
-      if (!subscribers.subscribed.empty()) {
+      if (subscribers.active()) {
         subscribers.send(
             protobuf::master::event::createFrameworkUpdated(*framework));
       }
@@ -3159,14 +3262,7 @@ void Master::_subscribe(
       // NOTE: We need to do this because the scheduler might have
       // replied to the offers but the driver might have dropped
       // those messages since it wasn't connected to the master.
-      foreach (Offer* offer, utils::copy(framework->offers)) {
-        allocator->recoverResources(
-            offer->framework_id(),
-            offer->slave_id(),
-            offer->resources(),
-            None());
-        removeOffer(offer, true); // Rescind.
-      }
+      removeOffers(framework->offers, true); // Rescind.
 
       // Also remove inverse offers.
       foreach (InverseOffer* inverseOffer,
@@ -3199,7 +3295,7 @@ void Master::_subscribe(
       message.mutable_master_info()->MergeFrom(info_);
       framework->send(message);
 
-      if (!subscribers.subscribed.empty()) {
+      if (subscribers.active()) {
         subscribers.send(
             protobuf::master::event::createFrameworkUpdated(*framework));
       }
@@ -3220,7 +3316,7 @@ void Master::_subscribe(
       return;
     }
 
-    if (!subscribers.subscribed.empty()) {
+    if (subscribers.active()) {
       subscribers.send(
           protobuf::master::event::createFrameworkUpdated(*framework));
     }
@@ -3333,15 +3429,7 @@ void Master::deactivate(Framework* framework, bool rescind)
   allocator->deactivateFramework(framework->id());
 
   // Remove the framework's offers.
-  foreach (Offer* offer, utils::copy(framework->offers)) {
-    allocator->recoverResources(
-        offer->framework_id(),
-        offer->slave_id(),
-        offer->resources(),
-        None());
-
-    removeOffer(offer, rescind);
-  }
+  removeOffers(framework->offers, rescind);
 
   // Remove the framework's inverse offers.
   foreach (InverseOffer* inverseOffer, utils::copy(framework->inverseOffers)) {
@@ -3388,15 +3476,7 @@ void Master::deactivate(Slave* slave)
   allocator->deactivateSlave(slave->id);
 
   // Remove and rescind offers.
-  foreach (Offer* offer, utils::copy(slave->offers)) {
-    allocator->recoverResources(
-        offer->framework_id(),
-        slave->id,
-        offer->resources(),
-        None());
-
-    removeOffer(offer, true); // Rescind!
-  }
+  removeOffers(slave->offers, true); // Rescind!
 
   // Remove and rescind inverse offers.
   foreach (InverseOffer* inverseOffer, utils::copy(slave->inverseOffers)) {
@@ -3573,8 +3653,50 @@ Future<bool> Master::authorizeTask(
 {
   CHECK_NOTNULL(framework);
 
+  return authorize({authorizationRequests(task, framework)}).front();
+}
+
+
+Future<bool> Master::authorizeReserveResources(
+    const Offer::Operation::Reserve& reserve,
+    const Option<Principal>& principal)
+{
+  return authorize({authorizationRequests(reserve, principal)}).front();
+}
+
+
+Future<bool> Master::authorizeUnreserveResources(
+    const Offer::Operation::Unreserve& unreserve,
+    const Option<Principal>& principal)
+{
+  return authorize({authorizationRequests(unreserve, principal)}).front();
+}
+
+
+Future<bool> Master::authorizeCreateVolume(
+    const Offer::Operation::Create& create,
+    const Option<Principal>& principal)
+{
+  return authorize({authorizationRequests(create, principal)}).front();
+}
+
+
+Future<bool> Master::authorizeDestroyVolume(
+    const Offer::Operation::Destroy& destroy,
+    const Option<Principal>& principal)
+{
+  return authorize({authorizationRequests(destroy, principal)}).front();
+}
+
+
+vector<authorization::Request> Master::authorizationRequests(
+    const TaskInfo& task,
+    const Framework* framework) const
+{
+  CHECK_NOTNULL(framework);
+
   if (authorizer.isNone()) {
-    return true; // Authorization is disabled.
+    return {}; // Authorization is disabled.
   }
 
   // Authorize the task.
@@ -3596,16 +3718,16 @@ Future<bool> Master::authorizeTask(
     << (framework->info.has_principal() ? framework->info.principal() : "ANY")
     << "' to launch task " << task.task_id();
 
-  return authorizer.get()->authorized(request);
+  return {request};
 }
 
 
-Future<bool> Master::authorizeReserveResources(
+vector<authorization::Request> Master::authorizationRequests(
     const Offer::Operation::Reserve& reserve,
-    const Option<Principal>& principal)
+    const Option<Principal>& principal) const
 {
   if (authorizer.isNone()) {
-    return true; // Authorization is disabled.
+    return {}; // Authorization is disabled.
   }
 
   authorization::Request request;
@@ -3620,7 +3742,7 @@ Future<bool> Master::authorizeReserveResources(
   // reservations for all roles included in `reserve.resources`.
   // Add an element to `request.roles` for each unique role in the resources.
   hashset<string> roles;
-  list<Future<bool>> authorizations;
+  vector<authorization::Request> requests;
   foreach (const Resource& resource, reserve.resources()) {
     // NOTE: Since authorization happens __before__ validation and resource
     // format conversion, we must look for roles that may appear in both
@@ -3645,7 +3767,7 @@ Future<bool> Master::authorizeReserveResources(
 
       request.mutable_object()->mutable_resource()->CopyFrom(resource);
       request.mutable_object()->set_value(role);
-      authorizations.push_back(authorizer.get()->authorized(request));
+      requests.push_back(request);
     }
   }
 
@@ -3658,30 +3780,20 @@ Future<bool> Master::authorizeReserveResources(
   // the validation occur and the case must be considered non erroneous.
   // TODO(arojas): Consider ensuring that `validate()` is called before
   // `authorizeReserveResources` so a `CHECK(!roles.empty())` can be added.
-  if (authorizations.empty()) {
-    return authorizer.get()->authorized(request);
+  if (requests.empty()) {
+    requests.push_back(request);
   }
 
-  return await(authorizations)
-      .then([](const list<Future<bool>>& authorizations)
-            -> Future<bool> {
-        // Compute a disjunction.
-        foreach (const Future<bool>& authorization, authorizations) {
-          if (!authorization.get()) {
-            return false;
-          }
-        }
-        return true;
-      });
+  return requests;
 }
 
 
-Future<bool> Master::authorizeUnreserveResources(
+vector<authorization::Request> Master::authorizationRequests(
     const Offer::Operation::Unreserve& unreserve,
-    const Option<Principal>& principal)
+    const Option<Principal>& principal) const
 {
   if (authorizer.isNone()) {
-    return true; // Authorization is disabled.
+    return {}; // Authorization is disabled.
   }
 
   authorization::Request request;
@@ -3692,7 +3804,7 @@ Future<bool> Master::authorizeUnreserveResources(
     request.mutable_subject()->CopyFrom(subject.get());
   }
 
-  list<Future<bool>> authorizations;
+  vector<authorization::Request> requests;
   foreach (const Resource& resource, unreserve.resources()) {
     // NOTE: Since authorization happens __before__ validation and resource
     // format conversion, we must look for the principal that may appear in
@@ -3713,7 +3825,7 @@ Future<bool> Master::authorizeUnreserveResources(
       request.mutable_object()->mutable_resource()->CopyFrom(resource);
       request.mutable_object()->set_value(principal.get());
 
-      authorizations.push_back(authorizer.get()->authorized(request));
+      requests.push_back(request);
     }
   }
 
@@ -3721,30 +3833,20 @@ Future<bool> Master::authorizeUnreserveResources(
             << (principal.isSome() ? stringify(principal.get()) : "ANY")
             << "' to unreserve resources '" << unreserve.resources() << "'";
 
-  if (authorizations.empty()) {
-    return authorizer.get()->authorized(request);
+  if (requests.empty()) {
+    requests.push_back(request);
   }
 
-  return await(authorizations)
-      .then([](const list<Future<bool>>& authorizations)
-            -> Future<bool> {
-        // Compute a disjunction.
-        foreach (const Future<bool>& authorization, authorizations) {
-          if (!authorization.get()) {
-            return false;
-          }
-        }
-        return true;
-      });
+  return requests;
 }
 
 
-Future<bool> Master::authorizeCreateVolume(
+vector<authorization::Request> Master::authorizationRequests(
     const Offer::Operation::Create& create,
-    const Option<Principal>& principal)
+    const Option<Principal>& principal) const
 {
   if (authorizer.isNone()) {
-    return true; // Authorization is disabled.
+    return {}; // Authorization is disabled.
   }
 
   authorization::Request request;
@@ -3759,7 +3861,7 @@ Future<bool> Master::authorizeCreateVolume(
   // volumes for all roles included in `create.volumes`.
   // Add an element to `request.roles` for each unique role in the volumes.
   hashset<string> roles;
-  list<Future<bool>> authorizations;
+  vector<authorization::Request> requests;
   foreach (const Resource& volume, create.volumes()) {
     string role;
     if (volume.reservations_size() > 0) {
@@ -3780,7 +3882,7 @@ Future<bool> Master::authorizeCreateVolume(
 
       request.mutable_object()->mutable_resource()->CopyFrom(volume);
       request.mutable_object()->set_value(role);
-      authorizations.push_back(authorizer.get()->authorized(request));
+      requests.push_back(request);
     }
   }
 
@@ -3788,30 +3890,20 @@ Future<bool> Master::authorizeCreateVolume(
             << (principal.isSome() ? stringify(principal.get()) : "ANY")
             << "' to create volumes '" << create.volumes() << "'";
 
-  if (authorizations.empty()) {
-    return authorizer.get()->authorized(request);
+  if (requests.empty()) {
+    requests.push_back(request);
   }
 
-  return await(authorizations)
-      .then([](const list<Future<bool>>& authorizations)
-            -> Future<bool> {
-        // Compute a disjunction.
-        foreach (const Future<bool>& authorization, authorizations) {
-          if (!authorization.get()) {
-            return false;
-          }
-        }
-        return true;
-      });
+  return requests;
 }
 
 
-Future<bool> Master::authorizeDestroyVolume(
+vector<authorization::Request> Master::authorizationRequests(
     const Offer::Operation::Destroy& destroy,
-    const Option<Principal>& principal)
+    const Option<Principal>& principal) const
 {
   if (authorizer.isNone()) {
-    return true; // Authorization is disabled.
+    return {}; // Authorization is disabled.
   }
 
   authorization::Request request;
@@ -3822,7 +3914,7 @@ Future<bool> Master::authorizeDestroyVolume(
     request.mutable_subject()->CopyFrom(subject.get());
   }
 
-  list<Future<bool>> authorizations;
+  vector<authorization::Request> requests;
   foreach (const Resource& volume, destroy.volumes()) {
     // NOTE: Since validation of this operation may be performed after
     // authorization, we must check here that this resource is a persistent
@@ -3832,7 +3924,7 @@ Future<bool> Master::authorizeDestroyVolume(
       request.mutable_object()->set_value(
           volume.disk().persistence().principal());
 
-      authorizations.push_back(authorizer.get()->authorized(request));
+      requests.push_back(request);
     }
   }
 
@@ -3840,21 +3932,57 @@ Future<bool> Master::authorizeDestroyVolume(
             << (principal.isSome() ? stringify(principal.get()) : "ANY")
             << "' to destroy volumes '" << destroy.volumes() << "'";
 
-  if (authorizations.empty()) {
-    return authorizer.get()->authorized(request);
+  if (requests.empty()) {
+    requests.push_back(request);
   }
 
-  return await(authorizations)
-      .then([](const list<Future<bool>>& authorizations)
-            -> Future<bool> {
-        // Compute a disjunction.
-        foreach (const Future<bool>& authorization, authorizations) {
-          if (!authorization.get()) {
-            return false;
-          }
-        }
-        return true;
-      });
+  return requests;
+}
+
+
+list<Future<bool>> Master::authorize(
+    const vector<vector<authorization::Request>>& requests)
+{
+  list<Future<bool>> authorizations;
+
+  vector<authorization::Request> batch;
+  foreach (const vector<authorization::Request>& requests_, requests) {
+    batch.insert(batch.end(), requests_.begin(), requests_.end());
+  }
+
+  if (batch.empty()) {
+    // Authorization is disabled.
+    authorizations.resize(requests.size(), true);
+    return authorizations;
+  }
+
+  CHECK_SOME(authorizer);
+
+  const vector<Future<bool>> decisions =
+    authorizer.get()->batchAuthorized(batch);
+
+  CHECK_EQ(batch.size(), decisions.size());
+
+  size_t begin = 0;
+  foreach (const vector<authorization::Request>& requests_, requests) {
+    const size_t end = begin + requests_.size();
+
+    // A task or operation is authorized if all of its requests are. It
+    // only fails if one of its own requests fails.
+    const list<Future<bool>> decisions_(
+        decisions.begin() + begin,
+        decisions.begin() + end);
+
+    authorizations.push_back(collect(decisions_)
+      .then([](const list<bool>& decisions) -> Future<bool> {
+        return std::find(decisions.begin(), decisions.end(), false) ==
+          decisions.end();
+      }));
+
+    begin = end;
+  }
+
+  return authorizations;
 }
 
 
@@ -4274,7 +4402,9 @@ void Master::accept(
   LOG(INFO) << "Processing ACCEPT call for offers: " << accept.offer_ids()
             << " on agent " << *slave << " for framework " << *framework;
 
-  list<Future<bool>> futures;
+  // The authorization requests of each task and operation, which are
+  // sent to the authorizer in a single batch.
+  vector<vector<authorization::Request>> requests;
   foreach (const Offer::Operation& operation, accept.operations()) {
     switch (operation.type()) {
       case Offer::Operation::LAUNCH:
@@ -4291,7 +4421,7 @@ void Master::accept(
         // Authorize the tasks. A task is in 'framework->pendingTasks'
         // and 'slave->pendingTasks' before it is authorized.
         foreach (const TaskInfo& task, tasks) {
-          futures.push_back(authorizeTask(task, framework));
+          requests.push_back(authorizationRequests(task, framework));
 
           // Add to the framework's list of pending tasks.
           //
@@ -4304,6 +4434,7 @@ void Master::accept(
           // a TASK_ERROR after a TASK_KILLED (see _accept())!
           if (!framework->pendingTasks.contains(task.task_id())) {
             framework->pendingTasks[task.task_id()] = task;
+            ++metrics->tasks_staging;
           }
 
           // Add to the slave's list of pending tasks.
@@ -4327,9 +4458,8 @@ void Master::accept(
           ? Principal(framework->info.principal())
           : Option<Principal>::none();
 
-        futures.push_back(
-            authorizeReserveResources(
-                operation.reserve(), principal));
+        requests.push_back(
+            authorizationRequests(operation.reserve(), principal));
 
         break;
       }
@@ -4340,9 +4470,8 @@ void Master::accept(
           ? Principal(framework->info.principal())
           : Option<Principal>::none();
 
-        futures.push_back(
-            authorizeUnreserveResources(
-                operation.unreserve(), principal));
+        requests.push_back(
+            authorizationRequests(operation.unreserve(), principal));
 
         break;
       }
@@ -4353,9 +4482,8 @@ void Master::accept(
           ? Principal(framework->info.principal())
           : Option<Principal>::none();
 
-        futures.push_back(
-            authorizeCreateVolume(
-                operation.create(), principal));
+        requests.push_back(
+            authorizationRequests(operation.create(), principal));
 
         break;
       }
@@ -4366,9 +4494,8 @@ void Master::accept(
           ? Principal(framework->info.principal())
           : Option<Principal>::none();
 
-        futures.push_back(
-            authorizeDestroyVolume(
-                operation.destroy(), principal));
+        requests.push_back(
+            authorizationRequests(operation.destroy(), principal));
 
         break;
       }
@@ -4402,7 +4529,7 @@ void Master::accept(
   }
 
   // Wait for all the tasks to be authorized.
-  await(futures)
+  await(authorize(requests))
     .onAny(defer(self(),
                  &Master::_accept,
                  framework->id(),
@@ -4464,7 +4591,9 @@ void Master::_accept(
 
       foreach (const TaskInfo& task, tasks) {
         // Remove the task from being pending.
-        framework->pendingTasks.erase(task.task_id());
+        if (framework->pendingTasks.erase(task.task_id()) > 0) {
+          --metrics->tasks_staging;
+        }
         if (slave != nullptr) {
           slave->pendingTasks[framework->id()].erase(task.task_id());
           if (slave->pendingTasks[framework->id()].empty()) {
@@ -4872,8 +5001,10 @@ void Master::_accept(
           // if a task was killed (removed from `pendingTasks`) *and*
           // the task is invalid or unauthorized here.
 
-          bool pending = framework->pendingTasks.contains(task.task_id());
-          framework->pendingTasks.erase(task.task_id());
+          bool pending = framework->pendingTasks.erase(task.task_id()) > 0;
+          if (pending) {
+            --metrics->tasks_staging;
+          }
           slave->pendingTasks[framework->id()].erase(task.task_id());
           if (slave->pendingTasks[framework->id()].empty()) {
             slave->pendingTasks.erase(framework->id());
@@ -5044,8 +5175,10 @@ void Master::_accept(
         // Remove all the tasks from being pending.
         hashset<TaskID> killed;
         foreach (const TaskInfo& task, taskGroup.tasks()) {
-          bool pending = framework->pendingTasks.contains(task.task_id());
-          framework->pendingTasks.erase(task.task_id());
+          bool pending = framework->pendingTasks.erase(task.task_id()) > 0;
+          if (pending) {
+            --metrics->tasks_staging;
+          }
           slave->pendingTasks[framework->id()].erase(task.task_id());
           if (slave->pendingTasks[framework->id()].empty()) {
             slave->pendingTasks.erase(framework->id());
@@ -5666,6 +5799,7 @@ void Master::kill(Framework* framework, const scheduler::Call::Kill& kill)
   if (framework->pendingTasks.contains(taskId)) {
     // Remove from pending tasks.
     framework->pendingTasks.erase(taskId);
+    --metrics->tasks_staging;
 
     if (slaveId.isSome()) {
       Slave* slave = slaves.registered.get(slaveId.get());
@@ -6646,8 +6780,7 @@ void Master::_reregisterSlave(
     VLOG(1) << "Consulting registry about agent " << slaveInfo.id()
             << " at " << pid << "(" << slaveInfo.hostname() << ")";
 
-    registrar->apply(Owned<RegistryOperation>(
-        new MarkSlaveReachable(slaveInfo)))
+    markReachable(slaveInfo)
       .onAny(defer(self(),
           &Self::__reregisterSlave,
           pid,
@@ -6657,6 +6790,38 @@ void Master::_reregisterSlave(
 }
 
 
+Future<bool> Master::markReachable(const SlaveInfo& slaveInfo)
+{
+  // The first agent of a batch schedules the registry operation. Since
+  // it is dispatched, all agents whose re-registration is processed
+  // before the operation is applied are included in the batch.
+  if (slaves.markingReachable.empty()) {
+    slaves.markedReachable.reset(new Promise<bool>());
+    dispatch(self(), &Self::_markReachable);
+  }
+
+  slaves.markingReachable.push_back(slaveInfo);
+
+  return slaves.markedReachable->future();
+}
+
+
+void Master::_markReachable()
+{
+  CHECK(!slaves.markingReachable.empty());
+
+  VLOG(1) << "Marking " << slaves.markingReachable.size()
+          << " agents reachable in the registry";
+
+  slaves.markedReachable->associate(
+      registrar->apply(Owned<RegistryOperation>(
+          new MarkSlaveReachable(slaves.markingReachable))));
+
+  slaves.markingReachable.clear();
+  slaves.markedReachable.reset();
+}
+
+
 void Master::__reregisterSlave(
     const UPID& pid,
     ReregisterSlaveMessage&& reregisterSlaveMessage,
@@ -6677,12 +6842,69 @@ void Master::__reregisterSlave(
   // should ever fail.
   CHECK(future.get());
 
+  // The first agent of a batch schedules the re-admission. Since it is
+  // dispatched, all agents whose registry update completes before the
+  // batch is processed are re-admitted with it.
+  if (slaves.readmitting.empty()) {
+    dispatch(self(), &Self::readmitSlaves);
+  }
+
+  slaves.readmitting.emplace_back(pid, std::move(reregisterSlaveMessage));
+}
+
+
+void Master::readmitSlaves()
+{
+  vector<pair<UPID, ReregisterSlaveMessage>> readmitting;
+  std::swap(readmitting, slaves.readmitting);
+
+  VLOG(1) << "Re-admitting " << readmitting.size() << " agents";
+
+  vector<mesos::allocator::SlaveAddition> additions;
+  vector<pair<Slave*, vector<FrameworkInfo>>> agents;
+
+  foreach (auto& entry, readmitting) {
+    Slave* slave = readmitSlave(entry.first, &entry.second);
+    if (slave == nullptr) {
+      continue;
+    }
+
+    additions.push_back(slaveAddition(*slave));
+    agents.emplace_back(
+        slave,
+        google::protobuf::convert(
+            std::move(*entry.second.mutable_frameworks())));
+  }
+
+  if (agents.empty()) {
+    return;
+  }
+
+  _recoverTaskResources();
+
+  allocator->addSlaves(additions);
+
+  updateSlaveFrameworks(agents);
+
+  foreach (const auto& agent, agents) {
+    slaves.reregistering.erase(agent.first->id);
+  }
+}
+
+
+Slave* Master::readmitSlave(
+    const UPID& pid,
+    ReregisterSlaveMessage* reregisterSlaveMessage)
+{
+  const SlaveInfo& slaveInfo = reregisterSlaveMessage->slave();
+  CHECK(slaves.reregistering.contains(slaveInfo.id()));
+
   if (slaves.markingGone.contains(slaveInfo.id())) {
     LOG(INFO)
       << "Ignoring re-register agent message from agent "
       << slaveInfo.id() << " at " << pid << " ("
       << slaveInfo.hostname() << ") as a gone operation is already in progress";
-    return;
+    return nullptr;
   }
 
   if (slaves.gone.contains(slaveInfo.id())) {
@@ -6692,7 +6914,7 @@ void Master::__reregisterSlave(
     ShutdownMessage message;
     message.set_message("Agent has been marked gone");
     send(pid, message);
-    return;
+    return nullptr;
   }
 
   VLOG(1) << "Re-admitted agent " << slaveInfo.id() << " at " << pid
@@ -6721,7 +6943,7 @@ void Master::__reregisterSlave(
   };
 
   vector<SlaveInfo::Capability> agentCapabilities =
-    google::protobuf::convert(reregisterSlaveMessage.agent_capabilities());
+    google::protobuf::convert(reregisterSlaveMessage->agent_capabilities());
 
   // Adjust the agent's task and executor infos to ensure
   // compatibility with old agents without certain capabilities.
@@ -6732,11 +6954,11 @@ void Master::__reregisterSlave(
     hashmap<FrameworkID, reference_wrapper<const FrameworkInfo>> frameworks;
 
     foreach (const FrameworkInfo& framework,
-             reregisterSlaveMessage.frameworks()) {
+             reregisterSlaveMessage->frameworks()) {
       frameworks.emplace(framework.id(), framework);
     }
 
-    foreach (Task& task, *reregisterSlaveMessage.mutable_tasks()) {
+    foreach (Task& task, *reregisterSlaveMessage->mutable_tasks()) {
       CHECK(frameworks.contains(task.framework_id()));
 
       injectAllocationInfo(
@@ -6745,7 +6967,7 @@ void Master::__reregisterSlave(
     }
 
     foreach (ExecutorInfo& executor,
-             *reregisterSlaveMessage.mutable_executor_infos()) {
+             *reregisterSlaveMessage->mutable_executor_infos()) {
       CHECK(frameworks.contains(executor.framework_id()));
 
       injectAllocationInfo(
@@ -6757,19 +6979,19 @@ void Master::__reregisterSlave(
   // Currently, The agent always downgrades the resources such that
   // a 1.4.0 agent can speak to a pre-1.4.0 master. We therefore
   // unconditionally upgrade the resources back here.
-  foreach (Task& task, *reregisterSlaveMessage.mutable_tasks()) {
+  foreach (Task& task, *reregisterSlaveMessage->mutable_tasks()) {
     convertResourceFormat(
         task.mutable_resources(), POST_RESERVATION_REFINEMENT);
   }
 
   foreach (ExecutorInfo& executor,
-           *reregisterSlaveMessage.mutable_executor_infos()) {
+           *reregisterSlaveMessage->mutable_executor_infos()) {
     convertResourceFormat(
         executor.mutable_resources(), POST_RESERVATION_REFINEMENT);
   }
 
   foreach (Archive::Framework& completedFramework,
-           *reregisterSlaveMessage.mutable_completed_frameworks()) {
+           *reregisterSlaveMessage->mutable_completed_frameworks()) {
     foreach (Task& task, *completedFramework.mutable_tasks()) {
       convertResourceFormat(
           task.mutable_resources(), POST_RESERVATION_REFINEMENT);
@@ -6785,7 +7007,7 @@ void Master::__reregisterSlave(
   hashset<FrameworkID> partitionAwareFrameworks;
 
   foreach (const FrameworkInfo& framework,
-           reregisterSlaveMessage.frameworks()) {
+           reregisterSlaveMessage->frameworks()) {
     if (protobuf::frameworkHasCapability(
             framework, FrameworkInfo::Capability::PARTITION_AWARE)) {
       partitionAwareFrameworks.insert(framework.id());
@@ -6796,7 +7018,7 @@ void Master::__reregisterSlave(
   // master (those tasks were previously marked "unreachable", so they
   // should be removed from that collection).
   vector<Task> recoveredTasks;
-  foreach (Task& task, *reregisterSlaveMessage.mutable_tasks()) {
+  foreach (Task& task, *reregisterSlaveMessage->mutable_tasks()) {
     const FrameworkID& frameworkId = task.framework_id();
 
     // Don't re-add tasks whose framework has been shutdown at the
@@ -6848,14 +7070,14 @@ void Master::__reregisterSlave(
   }
 
   vector<Resource> checkpointedResources = google::protobuf::convert(
-      std::move(*reregisterSlaveMessage.mutable_checkpointed_resources()));
+      std::move(*reregisterSlaveMessage->mutable_checkpointed_resources()));
   vector<ExecutorInfo> executorInfos = google::protobuf::convert(
-      std::move(*reregisterSlaveMessage.mutable_executor_infos()));
+      std::move(*reregisterSlaveMessage->mutable_executor_infos()));
 
   Option<id::UUID> resourceVersion;
-  if (reregisterSlaveMessage.has_resource_version_uuid()) {
+  if (reregisterSlaveMessage->has_resource_version_uuid()) {
     Try<id::UUID> uuid = id::UUID::fromBytes(
-        reregisterSlaveMessage.resource_version_uuid().value());
+        reregisterSlaveMessage->resource_version_uuid().value());
 
     CHECK_SOME(uuid);
     resourceVersion = uuid.get();
@@ -6868,7 +7090,7 @@ void Master::__reregisterSlave(
       slaveInfo,
       pid,
       machineId,
-      reregisterSlaveMessage.version(),
+      reregisterSlaveMessage->version(),
       std::move(agentCapabilities),
       Clock::now(),
       std::move(checkpointedResources),
@@ -6884,9 +7106,9 @@ void Master::__reregisterSlave(
   slaves.unreachable.erase(slave->id);
 
   vector<Archive::Framework> completedFrameworks = google::protobuf::convert(
-      std::move(*reregisterSlaveMessage.mutable_completed_frameworks()));
+      std::move(*reregisterSlaveMessage->mutable_completed_frameworks()));
 
-  addSlave(slave, std::move(completedFrameworks));
+  _addSlave(slave, std::move(completedFrameworks));
 
   Duration pingTimeout =
     flags.agent_ping_timeout * flags.max_agent_ping_timeouts;
@@ -6912,7 +7134,7 @@ void Master::__reregisterSlave(
   // number of completed frameworks. A proper fix likely involves
   // storing framework information in the registry (MESOS-1719).
   foreach (const FrameworkInfo& framework,
-           reregisterSlaveMessage.frameworks()) {
+           reregisterSlaveMessage->frameworks()) {
     if (isCompletedFramework(framework.id())) {
       LOG(INFO) << "Shutting down framework " << framework.id()
                 << " at re-registered agent " << *slave
@@ -6924,15 +7146,7 @@ void Master::__reregisterSlave(
     }
   }
 
-  // TODO(bmahler): Consider moving this in to `updateSlaveFrameworks`,
-  // would be helpful when there are a large total number of frameworks
-  // in the cluster.
-  const vector<FrameworkInfo> frameworks = google::protobuf::convert(
-      std::move(*reregisterSlaveMessage.mutable_frameworks()));
-
-  updateSlaveFrameworks(slave, frameworks);
-
-  slaves.reregistering.erase(slaveInfo.id());
+  return slave;
 }
 
 
@@ -7123,12 +7337,60 @@ void Master::updateSlaveFrameworks(
 {
   CHECK_NOTNULL(slave);
 
-  // Send the latest framework pids to the slave.
-  foreach (const FrameworkInfo& frameworkInfo, frameworks) {
-    CHECK(frameworkInfo.has_id());
-    Framework* framework = getFramework(frameworkInfo.id());
+  updateSlaveFrameworks({std::make_pair(slave, frameworks)});
+}
+
+
+void Master::updateSlaveFrameworks(
+    const vector<pair<Slave*, vector<FrameworkInfo>>>& agents)
+{
+  // The agents may be running frameworks that the master doesn't know
+  // about. Recover these frameworks using the `FrameworkInfo` supplied
+  // by the first agent reporting them, see `recoverFrameworks()`.
+  vector<FrameworkInfo> unknown;
+  hashmap<FrameworkID, Slave*> recoveredFrom;
+
+  foreach (const auto& agent, agents) {
+    Slave* slave = CHECK_NOTNULL(agent.first);
+
+    foreach (const FrameworkInfo& frameworkInfo, agent.second) {
+      CHECK(frameworkInfo.has_id());
+
+      // We skip recovering the framework if it has already been
+      // marked completed at the master. In this situation, the master
+      // has already told the agent to shutdown the framework in
+      // `readmitSlave`.
+      if (getFramework(frameworkInfo.id()) != nullptr ||
+          recoveredFrom.contains(frameworkInfo.id()) ||
+          isCompletedFramework(frameworkInfo.id())) {
+        continue;
+      }
+
+      LOG(INFO) << "Recovering framework " << frameworkInfo.id()
+                << " from re-registering agent " << *slave;
+
+      unknown.push_back(frameworkInfo);
+      recoveredFrom[frameworkInfo.id()] = slave;
+    }
+  }
+
+  recoverFrameworks(unknown, {});
+
+  // Send the latest framework pids to the agents.
+  foreach (const auto& agent, agents) {
+    Slave* slave = agent.first;
+
+    foreach (const FrameworkInfo& frameworkInfo, agent.second) {
+      Framework* framework = getFramework(frameworkInfo.id());
+
+      // Skip completed frameworks as well as the agent a framework has
+      // just been recovered from, since it reported the latest info.
+      if (framework == nullptr ||
+          (recoveredFrom.contains(frameworkInfo.id()) &&
+           recoveredFrom.at(frameworkInfo.id()) == slave)) {
+        continue;
+      }
 
-    if (framework != nullptr) {
       // TODO(bmahler): Copying the framework info here can be
       // expensive, consider only sending this message when
       // there has been a change vs what the agent reported.
@@ -7142,23 +7404,6 @@ void Master::updateSlaveFrameworks(
       message.set_pid(framework->pid.getOrElse(UPID()));
 
       send(slave->pid, message);
-    } else {
-      // The agent is running a framework that the master doesn't know
-      // about. Recover the framework using the `FrameworkInfo`
-      // supplied by the agent.
-
-      // We skip recovering the framework if it has already been
-      // marked completed at the master. In this situation, the master
-      // has already told the agent to shutdown the framework in
-      // `__reregisterSlave`.
-      if (isCompletedFramework(frameworkInfo.id())) {
-        continue;
-      }
-
-      LOG(INFO) << "Recovering framework " << frameworkInfo.id()
-                << " from re-registering agent " << *slave;
-
-      recoverFramework(frameworkInfo, {});
     }
   }
 }
@@ -7201,21 +7446,17 @@ void Master::updateFramework(
   allocator->updateFramework(framework->id(), frameworkInfo, suppressedRoles);
 
   // First, remove the offers allocated to roles being removed.
-  foreach (Offer* offer, utils::copy(framework->offers)) {
-    set<string> newRoles = protobuf::framework::getRoles(frameworkInfo);
-    if (newRoles.count(offer->allocation_info().role()) > 0) {
-      continue;
-    }
-
-    allocator->recoverResources(
-        offer->framework_id(),
-        offer->slave_id(),
-        offer->resources(),
-        None());
+  const set<string> newRoles = protobuf::framework::getRoles(frameworkInfo);
 
-    removeOffer(offer, true); // Rescind!
+  hashset<Offer*> removedOffers;
+  foreach (Offer* offer, framework->offers) {
+    if (newRoles.count(offer->allocation_info().role()) == 0) {
+      removedOffers.insert(offer);
+    }
   }
 
+  removeOffers(removedOffers, true); // Rescind!
+
   framework->update(frameworkInfo);
 }
 
@@ -7690,8 +7931,8 @@ void Master::updateSlave(UpdateSlaveMessage&& message)
   allocator->updateSlave(slaveId, slave->info, slave->totalResources);
 
   // Then rescind outstanding offers affected by the update.
-  // NOTE: Need a copy of offers because the offers are removed inside the loop.
-  foreach (Offer* offer, utils::copy(slave->offers)) {
+  hashset<Offer*> rescindedOffers;
+  foreach (Offer* offer, slave->offers) {
     bool rescind = false;
 
     const Resources& offered = offer->resources();
@@ -7718,19 +7959,13 @@ void Master::updateSlave(UpdateSlaveMessage&& message)
       rescind = true;
     }
 
-    if (!rescind) {
-      continue;
+    if (rescind) {
+      rescindedOffers.insert(offer);
     }
-
-    allocator->recoverResources(
-        offer->framework_id(),
-        offer->slave_id(),
-        offered,
-        None());
-
-    removeOffer(offer, true); // Rescind.
   }
 
+  removeOffers(rescindedOffers, true); // Rescind.
+
   // NOTE: We don't need to rescind inverse offers here as they are unrelated to
   // oversubscription.
 }
@@ -7771,12 +8006,7 @@ void Master::updateUnavailability(
 
       // Remove and rescind offers since we want to inform frameworks of the
       // unavailability change as soon as possible.
-      foreach (Offer* offer, utils::copy(slave->offers)) {
-        allocator->recoverResources(
-            offer->framework_id(), slave->id, offer->resources(), None());
-
-        removeOffer(offer, true); // Rescind!
-      }
+      removeOffers(slave->offers, true); // Rescind!
 
       // Remove and rescind inverse offers since the allocator will send new
       // inverse offers for the updated unavailability.
@@ -7808,8 +8038,6 @@ void Master::updateUnavailability(
 
 // TODO(vinod): Since 0.22.0, we can use 'from' instead of 'pid'
 // because the status updates will be sent by the slave.
-//
-// TODO(vinod): Add a benchmark test for status update handling.
 void Master::statusUpdate(StatusUpdate update, const UPID& pid)
 {
   CHECK_NE(pid, UPID());
@@ -8324,77 +8552,61 @@ void Master::_reconcileTasks(
 
   ++metrics->messages_reconcile_tasks;
 
-  if (statuses.empty()) {
-    // Implicit reconciliation.
+  // Implicit reconciliation is performed as an explicit reconciliation
+  // of all the tasks known to the master. Both are sent in batches to
+  // avoid blocking the master while reconciling large frameworks.
+  shared_ptr<vector<TaskStatus>> statuses_ =
+    std::make_shared<vector<TaskStatus>>();
+
+  const bool implicit = statuses.empty();
+
+  if (implicit) {
     LOG(INFO) << "Performing implicit task state reconciliation"
                  " for framework " << *framework;
 
-    foreachvalue (const TaskInfo& task, framework->pendingTasks) {
-      const StatusUpdate& update = protobuf::createStatusUpdate(
-          framework->id(),
-          task.slave_id(),
-          task.task_id(),
-          TASK_STAGING,
-          TaskStatus::SOURCE_MASTER,
-          None(),
-          "Reconciliation: Latest task state",
-          TaskStatus::REASON_RECONCILIATION);
+    statuses_->reserve(framework->pendingTasks.size() +
+                       framework->tasks.size());
 
-      VLOG(1) << "Sending implicit reconciliation state "
-              << update.status().state()
-              << " for task " << update.status().task_id()
-              << " of framework " << *framework;
-
-      // TODO(bmahler): Consider using forward(); might lead to too
-      // much logging.
-      StatusUpdateMessage message;
-      message.mutable_update()->CopyFrom(update);
-      framework->send(message);
+    foreachvalue (const TaskInfo& task, framework->pendingTasks) {
+      TaskStatus status;
+      status.mutable_task_id()->CopyFrom(task.task_id());
+      status.mutable_slave_id()->CopyFrom(task.slave_id());
+      status.set_state(TASK_STAGING); // Dummy status.
+      statuses_->push_back(status);
     }
 
     foreachvalue (Task* task, framework->tasks) {
-      const TaskState& state = task->has_status_update_state()
-          ? task->status_update_state()
-          : task->state();
-
-      const Option<ExecutorID>& executorId = task->has_executor_id()
-          ? Option<ExecutorID>(task->executor_id())
-          : None();
+      TaskStatus status;
+      status.mutable_task_id()->CopyFrom(task->task_id());
+      status.mutable_slave_id()->CopyFrom(task->slave_id());
+      status.set_state(TASK_RUNNING); // Dummy status.
+      statuses_->push_back(status);
+    }
+  } else {
+    LOG(INFO) << "Performing explicit task state reconciliation for "
+              << statuses.size() << " tasks of framework " << *framework;
 
-      const StatusUpdate& update = protobuf::createStatusUpdate(
-          framework->id(),
-          task->slave_id(),
-          task->task_id(),
-          state,
-          TaskStatus::SOURCE_MASTER,
-          None(),
-          "Reconciliation: Latest task state",
-          TaskStatus::REASON_RECONCILIATION,
-          executorId,
-          protobuf::getTaskHealth(*task),
-          protobuf::getTaskCheckStatus(*task),
-          None(),
-          protobuf::getTaskContainerStatus(*task));
+    *statuses_ = statuses;
+  }
 
-      VLOG(1) << "Sending implicit reconciliation state "
-              << update.status().state()
-              << " for task " << update.status().task_id()
-              << " of framework " << *framework;
+  __reconcileTasks(framework->id(), statuses_, 0, implicit);
+}
 
-      // TODO(bmahler): Consider using forward(); might lead to too
-      // much logging.
-      StatusUpdateMessage message;
-      message.mutable_update()->CopyFrom(update);
-      framework->send(message);
-    }
 
+void Master::__reconcileTasks(
+    const FrameworkID& frameworkId,
+    const shared_ptr<const vector<TaskStatus>>& statuses,
+    size_t offset,
+    bool implicit)
+{
+  Framework* framework = getFramework(frameworkId);
+  if (framework == nullptr || !framework->connected()) {
+    LOG(INFO) << "Dropping reconciliation of "
+              << statuses->size() - offset << " tasks of framework "
+              << frameworkId << " because it is not connected";
     return;
   }
 
-  // Explicit reconciliation.
-  LOG(INFO) << "Performing explicit task state reconciliation for "
-            << statuses.size() << " tasks of framework " << *framework;
-
   // Explicit reconciliation occurs for the following cases:
   //   (1) Task is known, but pending: TASK_STAGING.
   //   (2) Task is known: send the latest state.
@@ -8404,20 +8616,39 @@ void Master::_reconcileTasks(
   //   (6) Task is unknown, slave is gone: TASK_GONE_BY_OPERATOR.
   //   (7) Task is unknown, slave is unknown: TASK_UNKNOWN.
   //
+  // For implicit reconciliation only cases (1) and (2) apply.
+  //
   // For cases (3), (5), (6) and (7) TASK_LOST is sent instead if the
   // framework has not opted-in to the PARTITION_AWARE capability.
-  foreach (const TaskStatus& status, statuses) {
+
+  const size_t end =
+    std::min(statuses->size(), offset + RECONCILIATION_BATCH_SIZE);
+
+  for (size_t i = offset; i < end; i++) {
+    const TaskStatus& status = statuses->at(i);
+
     Option<SlaveID> slaveId = None();
     if (status.has_slave_id()) {
       slaveId = status.slave_id();
     }
 
     Option<StatusUpdate> update = None();
-    Task* task = framework->getTask(status.task_id());
 
-    if (framework->pendingTasks.contains(status.task_id())) {
+    // Look up each task only once, reconciliation is performed for
+    // hundreds of thousands of tasks at a time.
+    auto pendingTask = framework->pendingTasks.find(status.task_id());
+
+    Task* task = nullptr;
+    if (pendingTask == framework->pendingTasks.end()) {
+      auto knownTask = framework->tasks.find(status.task_id());
+      if (knownTask != framework->tasks.end()) {
+        task = knownTask->second;
+      }
+    }
+
+    if (pendingTask != framework->pendingTasks.end()) {
       // (1) Task is known, but pending: TASK_STAGING.
-      const TaskInfo& task_ = framework->pendingTasks[status.task_id()];
+      const TaskInfo& task_ = pendingTask->second;
       update = protobuf::createStatusUpdate(
           framework->id(),
           task_.slave_id(),
@@ -8451,6 +8682,10 @@ void Master::_reconcileTasks(
           protobuf::getTaskCheckStatus(*task),
           None(),
           protobuf::getTaskContainerStatus(*task));
+    } else if (implicit) {
+      // The task was removed since the implicit reconciliation was
+      // started, its terminal update has been sent already.
+      continue;
     } else if (slaveId.isSome() && slaves.registered.contains(slaveId.get())) {
       // (3) Task is unknown, slave is registered: TASK_GONE. If the
       // framework does not have the PARTITION_AWARE capability, send
@@ -8540,7 +8775,8 @@ void Master::_reconcileTasks(
     }
 
     if (update.isSome()) {
-      VLOG(1) << "Sending explicit reconciliation state "
+      VLOG(1) << "Sending " << (implicit ? "implicit" : "explicit")
+              << " reconciliation state "
               << update.get().status().state()
               << " for task " << update.get().status().task_id()
               << " of framework " << *framework;
@@ -8552,6 +8788,16 @@ void Master::_reconcileTasks(
       framework->send(message);
     }
   }
+
+  if (end < statuses->size()) {
+    dispatch(
+        self(),
+        &Master::__reconcileTasks,
+        frameworkId,
+        statuses,
+        end,
+        implicit);
+  }
 }
 
 
@@ -8698,6 +8944,7 @@ void Master::offer(
       }
 
       offers[offer->id()] = offer;
+      ++metrics->outstanding_offers;
 
       framework->addOffer(offer);
       slave->addOffer(offer);
@@ -9167,6 +9414,10 @@ void Master::addFramework(
   // There should be no offered resources yet!
   CHECK_EQ(Resources(), framework->totalOfferedResources);
 
+  // The allocator must not see the resources of removable tasks as
+  // used by the framework, since they are no longer in `usedResources`.
+  _recoverTaskResources();
+
   allocator->addFramework(
       framework->id(),
       framework->info,
@@ -9202,31 +9453,66 @@ void Master::recoverFramework(
     const FrameworkInfo& info,
     const set<string>& suppressedRoles)
 {
-  CHECK(!frameworks.registered.contains(info.id()));
+  recoverFrameworks({info}, suppressedRoles);
+}
 
-  Framework* framework = new Framework(this, flags, info);
 
-  // Add active tasks and executors to the framework.
+void Master::recoverFrameworks(
+    const vector<FrameworkInfo>& infos,
+    const set<string>& suppressedRoles)
+{
+  if (infos.empty()) {
+    return;
+  }
+
+  hashmap<FrameworkID, Framework*> recovered;
+
+  foreach (const FrameworkInfo& info, infos) {
+    CHECK(!frameworks.registered.contains(info.id()));
+    CHECK(!recovered.contains(info.id()));
+
+    recovered[info.id()] = new Framework(this, flags, info);
+  }
+
+  // Add active tasks, executors and operations to the frameworks. We
+  // only look up the frameworks each agent is running, rather than
+  // visiting every agent once per framework.
   foreachvalue (Slave* slave, slaves.registered) {
-    if (slave->tasks.contains(framework->id())) {
-      foreachvalue (Task* task, slave->tasks.at(framework->id())) {
-        framework->addTask(task);
+    foreachpair (const FrameworkID& frameworkId,
+                 const auto& tasks,
+                 slave->tasks) {
+      if (recovered.contains(frameworkId)) {
+        Framework* framework = recovered.at(frameworkId);
+
+        foreachvalue (Task* task, tasks) {
+          framework->addTask(task);
+        }
       }
     }
 
-    if (slave->executors.contains(framework->id())) {
-      foreachvalue (const ExecutorInfo& executor,
-                    slave->executors.at(framework->id())) {
-        framework->addExecutor(slave->id, executor);
+    foreachpair (const FrameworkID& frameworkId,
+                 const auto& executors,
+                 slave->executors) {
+      if (recovered.contains(frameworkId)) {
+        Framework* framework = recovered.at(frameworkId);
+
+        foreachvalue (const ExecutorInfo& executor, executors) {
+          framework->addExecutor(slave->id, executor);
+        }
       }
     }
 
     foreachvalue (Operation* operation, slave->operations) {
-      framework->addOperation(operation);
+      if (operation->has_framework_id() &&
+          recovered.contains(operation->framework_id())) {
+        recovered.at(operation->framework_id())->addOperation(operation);
+      }
     }
   }
 
-  addFramework(framework, suppressedRoles);
+  foreach (const FrameworkInfo& info, infos) {
+    addFramework(recovered.at(info.id()), suppressedRoles);
+  }
 }
 
 
@@ -9392,12 +9678,7 @@ void Master::failoverFramework(Framework* framework, const UPID& newPid)
 void Master::_failoverFramework(Framework* framework)
 {
   // Remove the framework's offers (if they weren't removed before).
-  foreach (Offer* offer, utils::copy(framework->offers)) {
-    allocator->recoverResources(
-        offer->framework_id(), offer->slave_id(), offer->resources(), None());
-
-    removeOffer(offer);
-  }
+  removeOffers(framework->offers);
 
   // Also remove the inverse offers.
   foreach (InverseOffer* inverseOffer, utils::copy(framework->inverseOffers)) {
@@ -9471,6 +9752,7 @@ void Master::removeFramework(Framework* framework)
   }
 
   // Remove the pending tasks from the framework.
+  metrics->tasks_staging -= framework->pendingTasks.size();
   framework->pendingTasks.clear();
 
   // Remove pointers to the framework's tasks in slaves and mark those
@@ -9608,7 +9890,7 @@ void Master::removeFramework(Framework* framework)
   // The framework pointer is now owned by `frameworks.completed`.
   frameworks.completed.set(framework->id(), Owned<Framework>(framework));
 
-  if (!subscribers.subscribed.empty()) {
+  if (subscribers.active()) {
     subscribers.send(
         protobuf::master::event::createFrameworkRemoved(framework->info));
   }
@@ -9667,6 +9949,26 @@ void Master::removeFramework(Slave* slave, Framework* framework)
 void Master::addSlave(
     Slave* slave,
     vector<Archive::Framework>&& completedFrameworks)
+{
+  _addSlave(CHECK_NOTNULL(slave), std::move(completedFrameworks));
+
+  const mesos::allocator::SlaveAddition addition = slaveAddition(*slave);
+
+  _recoverTaskResources();
+
+  allocator->addSlave(
+      addition.slaveId,
+      addition.slaveInfo,
+      addition.capabilities,
+      addition.unavailability,
+      addition.total,
+      addition.used);
+}
+
+
+void Master::_addSlave(
+    Slave* slave,
+    vector<Archive::Framework>&& completedFrameworks)
 {
   CHECK_NOTNULL(slave);
   CHECK(!slaves.registered.contains(slave->id));
@@ -9701,8 +10003,8 @@ void Master::addSlave(
     // If the framework has not re-registered yet and this is the
     // first agent to re-register that is running the framework, we
     // skip adding the framework's executors here. Instead, the
-    // framework will be recovered in `__reregisterSlave` and its
-    // executors will be added by `recoverFramework`.
+    // framework will be recovered in `readmitSlaves` and its
+    // executors will be added by `recoverFrameworks`.
     if (framework == nullptr) {
       continue;
     }
@@ -9720,8 +10022,8 @@ void Master::addSlave(
     // If the framework has not re-registered yet and this is the
     // first agent to re-register that is running the framework, we
     // skip adding the framework's tasks here. Instead, the framework
-    // will be recovered in `__reregisterSlave` and its tasks will be
-    // added by `recoverFramework`.
+    // will be recovered in `readmitSlaves` and its tasks will be
+    // added by `recoverFrameworks`.
     if (framework == nullptr) {
       continue;
     }
@@ -9762,25 +10064,32 @@ void Master::addSlave(
     }
   }
 
-  CHECK(machines.contains(slave->machineId));
+  if (subscribers.active()) {
+    subscribers.send(protobuf::master::event::createAgentAdded(*slave));
+  }
+}
+
+
+mesos::allocator::SlaveAddition Master::slaveAddition(const Slave& slave)
+{
+  CHECK(machines.contains(slave.machineId));
+
+  mesos::allocator::SlaveAddition addition;
+  addition.slaveId = slave.id;
+  addition.slaveInfo = slave.info;
+  addition.capabilities =
+    google::protobuf::convert(slave.capabilities.toRepeatedPtrField());
 
   // Only set unavailability if the protobuf has one set.
-  Option<Unavailability> unavailability = None();
-  if (machines[slave->machineId].info.has_unavailability()) {
-    unavailability = machines[slave->machineId].info.unavailability();
+  if (machines.at(slave.machineId).info.has_unavailability()) {
+    addition.unavailability =
+      machines.at(slave.machineId).info.unavailability();
   }
 
-  allocator->addSlave(
-      slave->id,
-      slave->info,
-      google::protobuf::convert(slave->capabilities.toRepeatedPtrField()),
-      unavailability,
-      slave->totalResources,
-      slave->usedResources);
+  addition.total = slave.totalResources;
+  addition.used = slave.usedResources;
 
-  if (!subscribers.subscribed.empty()) {
-    subscribers.send(protobuf::master::event::createAgentAdded(*slave));
-  }
+  return addition;
 }
 
 
@@ -9872,6 +10181,8 @@ void Master::_removeSlave(
   // only within recoverResources() (see MESOS-621). The calls to
   // recoverResources() below are therefore required, even though
   // the slave is already removed.
+  _recoverTaskResources();
+
   allocator->removeSlave(slave->id);
 
   // Transition the tasks to lost and remove them.
@@ -9913,15 +10224,11 @@ void Master::_removeSlave(
     }
   }
 
-  foreach (Offer* offer, utils::copy(slave->offers)) {
-    // TODO(vinod): We don't need to call 'Allocator::recoverResources'
-    // once MESOS-621 is fixed.
-    allocator->recoverResources(
-        offer->framework_id(), slave->id, offer->resources(), None());
-
-    // Remove and rescind offers.
-    removeOffer(offer, true); // Rescind!
-  }
+  // Remove and rescind offers.
+  //
+  // TODO(vinod): We don't need to recover the resources of the
+  // offers in the allocator once MESOS-621 is fixed.
+  removeOffers(slave->offers, true); // Rescind!
 
   // Remove inverse offers because sending them for a slave that is
   // gone doesn't make sense.
@@ -9954,7 +10261,7 @@ void Master::_removeSlave(
 
   sendSlaveLost(slave->info);
 
-  if (!subscribers.subscribed.empty()) {
+  if (subscribers.active()) {
     subscribers.send(protobuf::master::event::createAgentRemoved(slave->id));
   }
 
@@ -9975,6 +10282,8 @@ void Master::__removeSlave(
   // only within recoverResources() (see MESOS-621). The calls to
   // recoverResources() below are therefore required, even though
   // the slave is already removed.
+  _recoverTaskResources();
+
   allocator->removeSlave(slave->id);
 
   // Transition tasks to TASK_UNREACHABLE/TASK_GONE_BY_OPERATOR/TASK_LOST
@@ -10038,15 +10347,11 @@ void Master::__removeSlave(
     }
   }
 
-  foreach (Offer* offer, utils::copy(slave->offers)) {
-    // TODO(vinod): We don't need to call 'Allocator::recoverResources'
-    // once MESOS-621 is fixed.
-    allocator->recoverResources(
-        offer->framework_id(), slave->id, offer->resources(), None());
-
-    // Remove and rescind offers.
-    removeOffer(offer, true); // Rescind!
-  }
+  // Remove and rescind offers.
+  //
+  // TODO(vinod): We don't need to recover the resources of the
+  // offers in the allocator once MESOS-621 is fixed.
+  removeOffers(slave->offers, true); // Rescind!
 
   // Remove inverse offers because sending them for a slave that is
   // unreachable doesn't make sense.
@@ -10113,7 +10418,9 @@ void Master::updateTask(Task* task, const StatusUpdate& update)
         sendSubscribersUpdate = true;
       }
 
+      metrics->removeTask(task->state());
       task->set_state(latestState.get());
+      metrics->addTask(task->state());
     }
   } else {
     removable = !isRemovable(task->state()) && isRemovable(status.state());
@@ -10126,7 +10433,9 @@ void Master::updateTask(Task* task, const StatusUpdate& update)
         sendSubscribersUpdate = true;
       }
 
+      metrics->removeTask(task->state());
       task->set_state(status.state());
+      metrics->addTask(task->state());
     }
   }
 
@@ -10145,7 +10454,7 @@ void Master::updateTask(Task* task, const StatusUpdate& update)
   // MESOS-1746.
   task->mutable_statuses(task->statuses_size() - 1)->clear_data();
 
-  if (sendSubscribersUpdate && !subscribers.subscribed.empty()) {
+  if (sendSubscribersUpdate && subscribers.active()) {
     subscribers.send(protobuf::master::event::createTaskUpdated(
         *task, task->state(), status));
   }
@@ -10157,11 +10466,10 @@ void Master::updateTask(Task* task, const StatusUpdate& update)
 
   // Once the task becomes removable, recover the resources.
   if (removable) {
-    allocator->recoverResources(
+    recoverTaskResources(
         task->framework_id(),
         task->slave_id(),
-        task->resources(),
-        None());
+        task->resources());
 
     // The slave owns the Task object and cannot be nullptr.
     Slave* slave = slaves.registered.get(task->slave_id());
@@ -10221,6 +10529,39 @@ void Master::updateTask(Task* task, const StatusUpdate& update)
 }
 
 
+void Master::recoverTaskResources(
+    const FrameworkID& frameworkId,
+    const SlaveID& slaveId,
+    const Resources& resources)
+{
+  if (resources.empty()) {
+    return;
+  }
+
+  // Status updates usually arrive in bursts (e.g., when a job finishes
+  // or an agent re-registers), so rather than calling into the
+  // allocator for every task we collect the resources until all
+  // messages queued up so far have been processed.
+  if (recoveredTaskResources.empty()) {
+    dispatch(self(), &Master::_recoverTaskResources);
+  }
+
+  recoveredTaskResources[frameworkId][slaveId] += resources;
+}
+
+
+void Master::_recoverTaskResources()
+{
+  if (recoveredTaskResources.empty()) {
+    return;
+  }
+
+  allocator->batchRecoverResources(recoveredTaskResources);
+
+  recoveredTaskResources.clear();
+}
+
+
 void Master::removeTask(Task* task, bool unreachable)
 {
   CHECK_NOTNULL(task);
@@ -10670,10 +11011,35 @@ void Master::removeOffer(Offer* offer, bool rescind)
   // Delete it.
   LOG(INFO) << "Removing offer " << offer->id();
   offers.erase(offer->id());
+  --metrics->outstanding_offers;
   delete offer;
 }
 
 
+void Master::removeOffers(const hashset<Offer*>& _offers, bool rescind)
+{
+  if (_offers.empty()) {
+    return;
+  }
+
+  // Recover the resources of all offers using a single call, so that
+  // removing many offers (e.g., all offers of a framework or agent)
+  // does not flood the allocator with messages.
+  hashmap<FrameworkID, hashmap<SlaveID, Resources>> recovered;
+  foreach (Offer* offer, _offers) {
+    recovered[offer->framework_id()][offer->slave_id()] += offer->resources();
+  }
+
+  allocator->batchRecoverResources(recovered);
+
+  // NOTE: A copy is needed because `_offers` might be the offers of a
+  // framework or agent, which `removeOffer()` modifies.
+  foreach (Offer* offer, utils::copy(_offers)) {
+    removeOffer(offer, rescind);
+  }
+}
+
+
 void Master::inverseOfferTimeout(const OfferID& inverseOfferId)
 {
   InverseOffer* inverseOffer = getInverseOffer(inverseOfferId);
@@ -10895,68 +11261,6 @@ double Master::_frameworks_inactive()
 }
 
 
-double Master::_tasks_staging()
-{
-  double count = 0.0;
-
-  // Add the tasks pending validation / authorization.
-  foreachvalue (Framework* framework, frameworks.registered) {
-    count += framework->pendingTasks.size();
-  }
-
-  foreachvalue (Slave* slave, slaves.registered) {
-    typedef hashmap<TaskID, Task*> TaskMap;
-    foreachvalue (const TaskMap& tasks, slave->tasks) {
-      foreachvalue (const Task* task, tasks) {
-        if (task->state() == TASK_STAGING) {
-          count++;
-        }
-      }
-    }
-  }
-
-  return count;
-}
-
-
-double Master::_tasks_starting()
-{
-  double count = 0.0;
-
-  foreachvalue (Slave* slave, slaves.registered) {
-    typedef hashmap<TaskID, Task*> TaskMap;
-    foreachvalue (const TaskMap& tasks, slave->tasks) {
-      foreachvalue (const Task* task, tasks) {
-        if (task->state() == TASK_STARTING) {
-          count++;
-        }
-      }
-    }
-  }
-
-  return count;
-}
-
-
-double Master::_tasks_running()
-{
-  double count = 0.0;
-
-  foreachvalue (Slave* slave, slaves.registered) {
-    typedef hashmap<TaskID, Task*> TaskMap;
-    foreachvalue (const TaskMap& tasks, slave->tasks) {
-      foreachvalue (const Task* task, tasks) {
-        if (task->state() == TASK_RUNNING) {
-          count++;
-        }
-      }
-    }
-  }
-
-  return count;
-}
-
-
 double Master::_tasks_unreachable()
 {
   double count = 0.0;
@@ -10973,25 +11277,6 @@ double Master::_tasks_unreachable()
 }
 
 
-double Master::_tasks_killing()
-{
-  double count = 0.0;
-
-  foreachvalue (Slave* slave, slaves.registered) {
-    typedef hashmap<TaskID, Task*> TaskMap;
-    foreachvalue (const TaskMap& tasks, slave->tasks) {
-      foreachvalue (const Task* task, tasks) {
-        if (task->state() == TASK_KILLING) {
-          count++;
-        }
-      }
-    }
-  }
-
-  return count;
-}
-
-
 double Master::_resources_total(const string& name)
 {
   double total = 0.0;
@@ -11096,11 +11381,16 @@ static bool isValidFailoverTimeout(const FrameworkInfo& frameworkInfo)
 }
 
 
-void Master::Subscribers::send(const mesos::master::Event& event)
+void Master::Subscribers::send(const mesos::master::Event& _event)
 {
-  VLOG(1) << "Notifying all active subscribers about " << event.type()
+  VLOG(1) << "Notifying all active subscribers about " << _event.type()
           << " event";
 
+  mesos::master::Event event(_event);
+  event.set_sequence(++sequence);
+
+  events.push_back(event);
+
   foreachvalue (const Owned<Subscriber>& subscriber, subscribed) {
     Future<Owned<AuthorizationAcceptor>> authorizeRole =
       AuthorizationAcceptor::create(
@@ -11154,6 +11444,33 @@ void Master::Subscribers::send(const mesos::master::Event& event)
 }
 
 
+void Master::Subscribers::stopRecording()
+{
+  recording = false;
+  events.clear();
+
+  // Events are not sent while not recording, hence skip a sequence
+  // number so that a stream which ended before this point cannot be
+  // resumed, see `since()`.
+  ++sequence;
+}
+
+
+Option<vector<mesos::master::Event>> Master::Subscribers::since(
+    uint64_t _sequence) const
+{
+  // The recorded events are the last `events.size()` events sent.
+  if (!recording ||
+      _sequence > sequence ||
+      sequence - _sequence > events.size()) {
+    return None();
+  }
+
+  return vector<mesos::master::Event>(
+      events.end() - (sequence - _sequence), events.end());
+}
+
+
 void Master::Subscribers::Subscriber::send(
     const mesos::master::Event& event,
     const Owned<AuthorizationAcceptor>& authorizeRole,
@@ -11301,6 +11618,31 @@ void Master::exited(const id::UUID& id)
             << " from the list of active subscribers";
 
   subscribers.subscribed.erase(id);
+
+  if (subscribers.subscribed.empty()) {
+    subscribers.idleSince = Clock::now();
+
+    delay(SUBSCRIBER_RESUME_WINDOW,
+          self(),
+          &Master::stopRecordingSubscriberEvents);
+  }
+}
+
+
+void Master::stopRecordingSubscriberEvents()
+{
+  // A subscriber might have connected, or the last one might have
+  // disconnected again, in the meantime.
+  if (!subscribers.recording ||
+      subscribers.idleSince.isNone() ||
+      Clock::now() - subscribers.idleSince.get() < SUBSCRIBER_RESUME_WINDOW) {
+    return;
+  }
+
+  LOG(INFO) << "Stopped recording events for subscribers since none has been"
+            << " connected for " << SUBSCRIBER_RESUME_WINDOW;
+
+  subscribers.stopRecording();
 }
 
 
@@ -11311,6 +11653,9 @@ void Master::subscribe(
   LOG(INFO) << "Added subscriber " << http.streamId
             << " to the list of active subscribers";
 
+  subscribers.recording = true;
+  subscribers.idleSince = None();
+
   http.closed()
     .onAny(defer(self(),
            [this, http](const Future<Nothing>&) {
@@ -11407,6 +11752,8 @@ void Slave::addTask(Task* task)
 
   tasks[frameworkId][taskId] = task;
 
+  master->metrics->addTask(task->state());
+
   // Note that we explicitly convert from protobuf to `Resources` here
   // and then use the result below to avoid performance penalty for multiple
   // conversions and validations implied by conversion.
@@ -11417,7 +11764,7 @@ void Slave::addTask(Task* task)
     usedResources[frameworkId] += resources;
   }
 
-  if (!master->subscribers.subscribed.empty()) {
+  if (master->subscribers.active()) {
     master->subscribers.send(protobuf::master::event::createTaskAdded(*task));
   }
 
@@ -11465,6 +11812,8 @@ void Slave::removeTask(Task* task)
     tasks.erase(frameworkId);
   }
 
+  master->metrics->removeTask(task->state());
+
   killedTasks.remove(frameworkId, taskId);
 }
 
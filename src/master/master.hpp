@@ -23,6 +23,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <boost/circular_buffer.hpp>
@@ -55,6 +56,7 @@
 
 #include <stout/boundedhashmap.hpp>
 #include <stout/cache.hpp>
+#include <stout/error.hpp>
 #include <stout/foreach.hpp>
 #include <stout/hashmap.hpp>
 #include <stout/hashset.hpp>
@@ -75,6 +77,7 @@
 #include "internal/devolve.hpp"
 #include "internal/evolve.hpp"
 
+#include "master/compact_task.hpp"
 #include "master/constants.hpp"
 #include "master/flags.hpp"
 #include "master/machine.hpp"
@@ -542,6 +545,11 @@ public:
   // Made public for testing purposes.
   process::Future<Nothing> _recover(const Registry& registry);
 
+  // Stops recording events for operator API subscribers if none has
+  // been connected for `SUBSCRIBER_RESUME_WINDOW`.
+  // Made public for testing purposes.
+  void stopRecordingSubscriberEvents();
+
   MasterInfo info() const
   {
     return info_;
@@ -551,6 +559,10 @@ protected:
   void initialize() override;
   void finalize() override;
 
+  // Advances `stateGeneration` after every event which is not
+  // read-only, see `readOnly()`.
+  void serve(process::Event&& event) override;
+
   void consume(process::MessageEvent&& event) override;
   void consume(process::ExitedEvent&& event) override;
 
@@ -583,6 +595,13 @@ protected:
       const Option<std::string>& principal,
       uint64_t capacity);
 
+  // Throttles a call from an HTTP framework using the same rate limiter
+  // as for messages from frameworks with its principal, see `consume()`.
+  // Returns a future which is satisfied once the call can be processed,
+  // or `None()` if the capacity of the rate limiter is exceeded, in
+  // which case the call must be dropped.
+  Option<process::Future<Nothing>> throttle(Framework* framework);
+
   // Recovers state from the registrar.
   process::Future<Nothing> recover();
   void recoveredSlavesTimeout(const Registry& registry);
@@ -604,20 +623,62 @@ protected:
       const Option<std::string>& principal,
       const process::Future<bool>& authorized);
 
+  // Queues an agent not registered with the master (e.g., one
+  // recovered from the registry after a master failover) to be
+  // re-admitted with the next batch, see `readmitSlaves()`.
   void __reregisterSlave(
       const process::UPID& pid,
       ReregisterSlaveMessage&& incomingMessage,
       const process::Future<bool>& readmit);
 
+  // Re-admits all agents queued by `__reregisterSlave()`. The first
+  // agent of a batch dispatches this, hence all agents whose
+  // re-registration is processed in the meantime (e.g., thousands of
+  // agents re-registering after a master failover) are re-admitted at
+  // once: they are added to the allocator with a single `addSlaves()`
+  // call and the frameworks they are running are reconciled in a
+  // single pass, see `updateSlaveFrameworks()`.
+  void readmitSlaves();
+
+  // Re-admits a single agent of a batch, except for adding it to the
+  // allocator and reconciling its frameworks, which are left in the
+  // message. Returns nullptr if the agent is not re-admitted.
+  Slave* readmitSlave(
+      const process::UPID& pid,
+      ReregisterSlaveMessage* reregisterSlaveMessage);
+
   void ___reregisterSlave(
       const process::UPID& pid,
       ReregisterSlaveMessage&& incomingMessage,
       const process::Future<bool>& updated);
 
+  // Marks a re-registering agent reachable in the registry. The agents
+  // re-registering at the same time (e.g., after a network partition
+  // heals) are marked reachable using a single registry operation.
+  //
+  // NOTE: This only covers agents unknown to the master, i.e., those
+  // marked unreachable or no longer in the registry. Agents recovered
+  // from the registry after a master failover are re-admitted without
+  // a registry operation, unless their `SlaveInfo` changed, in which
+  // case each of them still applies its own `UpdateSlave` operation.
+  process::Future<bool> markReachable(const SlaveInfo& slaveInfo);
+
+  // Applies the registry operation for all agents waiting to be marked
+  // reachable, see `markReachable()`.
+  void _markReachable();
+
   void updateSlaveFrameworks(
       Slave* slave,
       const std::vector<FrameworkInfo>& frameworks);
 
+  // Sends the latest framework info to re-registered agents and recovers
+  // the frameworks they are running which are unknown to the master.
+  // All unknown frameworks of the given agents are recovered at once,
+  // see `recoverFrameworks()`.
+  void updateSlaveFrameworks(
+      const std::vector<std::pair<Slave*, std::vector<FrameworkInfo>>>&
+        agents);
+
   // 'future' is the future returned by the authenticator.
   void _authenticate(
       const process::UPID& pid,
@@ -637,6 +698,17 @@ protected:
       Framework* framework,
       const std::vector<TaskStatus>& statuses);
 
+  // Sends the reconciliation updates for the statuses starting at
+  // 'offset', at most `RECONCILIATION_BATCH_SIZE` of them, and
+  // dispatches itself for the remaining ones. For implicit
+  // reconciliation, tasks removed in the meantime are skipped since
+  // their terminal updates have been sent already.
+  void __reconcileTasks(
+      const FrameworkID& frameworkId,
+      const std::shared_ptr<const std::vector<TaskStatus>>& statuses,
+      size_t offset,
+      bool implicit);
+
   // When a slave that was previously registered with this master
   // re-registers, we need to reconcile the master's view of the
   // slave's tasks and executors.  This function also sends the
@@ -660,6 +732,13 @@ protected:
       const FrameworkInfo& info,
       const std::set<std::string>& suppressedRoles);
 
+  // Recovers multiple frameworks, see `recoverFramework()`, using a
+  // single pass over all agents to collect their tasks, executors and
+  // operations.
+  void recoverFrameworks(
+      const std::vector<FrameworkInfo>& infos,
+      const std::set<std::string>& suppressedRoles);
+
   // Transition a framework from `RECOVERED` to `CONNECTED` state and
   // activate it. This happens at most once after master failover, the
   // first time that the framework re-registers with the new master.
@@ -705,6 +784,15 @@ protected:
       Slave* slave,
       std::vector<Archive::Framework>&& completedFrameworks);
 
+  // Adds a slave to the master, but not to the allocator, see
+  // `slaveAddition()`.
+  void _addSlave(
+      Slave* slave,
+      std::vector<Archive::Framework>&& completedFrameworks);
+
+  // Returns the arguments to add the given slave to the allocator.
+  mesos::allocator::SlaveAddition slaveAddition(const Slave& slave);
+
   void _markUnreachable(
       Slave* slave,
       const TimeInfo& unreachableTime,
@@ -844,6 +932,36 @@ protected:
       const Offer::Operation::Destroy& destroy,
       const Option<process::http::authentication::Principal>& principal);
 
+  // Returns the authorization requests for launching `task`, or for
+  // performing the given operation. The task or operation is authorized
+  // if all of its requests are. No requests are returned if authorization
+  // is disabled.
+  std::vector<authorization::Request> authorizationRequests(
+      const TaskInfo& task,
+      const Framework* framework) const;
+
+  std::vector<authorization::Request> authorizationRequests(
+      const Offer::Operation::Reserve& reserve,
+      const Option<process::http::authentication::Principal>& principal) const;
+
+  std::vector<authorization::Request> authorizationRequests(
+      const Offer::Operation::Unreserve& unreserve,
+      const Option<process::http::authentication::Principal>& principal) const;
+
+  std::vector<authorization::Request> authorizationRequests(
+      const Offer::Operation::Create& create,
+      const Option<process::http::authentication::Principal>& principal) const;
+
+  std::vector<authorization::Request> authorizationRequests(
+      const Offer::Operation::Destroy& destroy,
+      const Option<process::http::authentication::Principal>& principal) const;
+
+  // Sends the requests of all tasks and operations to the authorizer in
+  // a single batch. Returns whether each task or operation is authorized,
+  // in the same order as `requests`.
+  std::list<process::Future<bool>> authorize(
+      const std::vector<std::vector<authorization::Request>>& requests);
+
   // Add the task and its executor (if not already running) to the
   // framework and slave. Returns the resources consumed as a result,
   // which includes resources for the task and its executor
@@ -854,6 +972,22 @@ protected:
   // terminal.
   void updateTask(Task* task, const StatusUpdate& update);
 
+  // Recovers the resources of a task that became removable. The
+  // resources recovered while processing a burst of status updates are
+  // returned to the allocator with a single call, see
+  // `_recoverTaskResources()`.
+  void recoverTaskResources(
+      const FrameworkID& frameworkId,
+      const SlaveID& slaveId,
+      const Resources& resources);
+
+  // Returns the resources collected by `recoverTaskResources()` to the
+  // allocator. This must be called before agents are added to or
+  // removed from the allocator and before frameworks are added to it,
+  // so that the allocator never recovers resources which were not
+  // allocated in its view.
+  void _recoverTaskResources();
+
   // Removes the task. `unreachable` indicates whether the task is removed due
   // to being unreachable. Note that we cannot rely on the task state because
   // it may not reflect unreachability due to being set to TASK_LOST for
@@ -902,6 +1036,10 @@ protected:
   // Remove an offer and optionally rescind the offer as well.
   void removeOffer(Offer* offer, bool rescind = false);
 
+  // Recovers the resources of the offers in the allocator using a
+  // single call, then removes and optionally rescinds the offers.
+  void removeOffers(const hashset<Offer*>& offers, bool rescind = false);
+
   // Remove an inverse offer after specified timeout
   void inverseOfferTimeout(const OfferID& inverseOfferId);
 
@@ -1288,6 +1426,16 @@ private:
 
   // Inner class used to namespace HTTP route handlers (see
   // master/http.cpp for implementations).
+  //
+  // TODO(xqdan): The read-only endpoints ('/state', '/state-summary',
+  // '/frameworks', '/slaves', '/tasks' and the v1 'GET_STATE' call) are
+  // still served on the master actor. Serving them from an immutable,
+  // versioned read model owned by a pool of reader processes would take
+  // them off the actor, but requires the master to maintain that model
+  // incrementally on every state change, since copying the whole state
+  // at a bounded rate costs the actor about as much as serving a large
+  // '/state' does. Until then, '/state' is written in bounded chunks and
+  // '/state-summary' responses are cached.
   class Http
   {
   public:
@@ -1307,6 +1455,12 @@ private:
         const Option<process::http::authentication::Principal>&
             principal) const;
 
+    // Continuation of `scheduler()` for calls of subscribed frameworks,
+    // invoked once the call is no longer throttled.
+    process::Future<process::http::Response> _scheduler(
+        const scheduler::Call& call,
+        const std::string& streamId) const;
+
     // /master/create-volumes
     process::Future<process::http::Response> createVolumes(
         const process::http::Request& request,
@@ -1455,6 +1609,19 @@ private:
         const Option<process::http::authentication::Principal>&
             principal) const;
 
+    struct StateStream; // Forward declaration.
+
+    // Writes the next chunk of a '/state' response, see `state()`.
+    void _state(const std::shared_ptr<StateStream>& stream) const;
+
+    // Returns the JSON of the agent or framework with the given `id` in
+    // the given section of a '/state' response, or None if it has been
+    // removed or is not visible to the client.
+    Option<std::string> stateElement(
+        const StateStream& stream,
+        size_t section,
+        const std::string& id) const;
+
     process::Future<std::vector<const Task*>> _tasks(
         const size_t limit,
         const size_t offset,
@@ -1686,6 +1853,17 @@ private:
         const process::Owned<ObjectApprover>& executorsApprover,
         const process::Owned<AuthorizationAcceptor>& rolesAcceptor) const;
 
+    // Returns the serialized `SUBSCRIBED` event for a new subscriber.
+    // The snapshot of the cluster state contained in the event is shared
+    // between subscribers, see `Master::Subscribers::Snapshot`.
+    std::string subscribed(
+        const Option<process::http::authentication::Principal>& principal,
+        ContentType contentType,
+        const process::Owned<ObjectApprover>& frameworksApprover,
+        const process::Owned<ObjectApprover>& tasksApprover,
+        const process::Owned<ObjectApprover>& executorsApprover,
+        const process::Owned<AuthorizationAcceptor>& rolesAcceptor) const;
+
     process::Future<process::http::Response> subscribe(
         const mesos::master::Call& call,
         const Option<process::http::authentication::Principal>& principal,
@@ -1711,6 +1889,9 @@ private:
 
     Master* master;
 
+    // Cached responses of `/state-summary`, see `ResponseCache`.
+    mutable ResponseCache stateSummaryCache;
+
     // NOTE: The quota specific pieces of the Operator API are factored
     // out into this separate class.
     QuotaHandler quotaHandler;
@@ -1876,6 +2057,17 @@ private:
     // Slaves that are in the process of being marked gone.
     hashset<SlaveID> markingGone;
 
+    // Slaves waiting to be marked reachable with the next registry
+    // operation, see `Master::markReachable()`, and the promise for the
+    // result of that operation.
+    std::vector<SlaveInfo> markingReachable;
+    process::Owned<process::Promise<bool>> markedReachable;
+
+    // Slaves waiting to be re-admitted with the next batch, see
+    // `Master::readmitSlaves()`.
+    std::vector<std::pair<process::UPID, ReregisterSlaveMessage>>
+      readmitting;
+
     // This collection includes agents that have gracefully shutdown,
     // as well as those that have been marked unreachable or gone. We
     // keep a cache here to prevent this from growing in an unbounded
@@ -2010,12 +2202,60 @@ private:
       const Option<process::http::authentication::Principal> principal;
     };
 
+    // A `SUBSCRIBED` event containing a snapshot of the cluster state,
+    // serialized for a particular content type. Snapshots are shared
+    // between subscribers with the same principal as long as the state
+    // of the master does not change.
+    struct Snapshot
+    {
+      uint64_t stateGeneration;
+      uint64_t sequence;
+      std::string record;
+    };
+
+    Subscribers()
+      : recording(false),
+        sequence(0),
+        events(MAX_SUBSCRIBER_EVENTS),
+        snapshots(MAX_SUBSCRIBER_SNAPSHOTS) {}
+
+    // Returns whether events need to be sent. Once a client has
+    // subscribed, events are recorded even if no subscriber is connected
+    // so that subscribers are able to resume their streams, but only
+    // until no subscriber has been connected for
+    // `SUBSCRIBER_RESUME_WINDOW`.
+    bool active() const { return recording; }
+
+    // Stops recording events. Recorded events are dropped, hence
+    // streams of past subscribers can no longer be resumed.
+    void stopRecording();
+
     // Sends the event to all subscribers connected to the 'api/vX' endpoint.
     void send(const mesos::master::Event& event);
 
+    // Returns the recorded events following the event with the given
+    // sequence number, or none if some of these events have already
+    // been dropped.
+    Option<std::vector<mesos::master::Event>> since(uint64_t _sequence) const;
+
     // Active subscribers to the 'api/vX' endpoint keyed by the stream
     // identifier.
     hashmap<id::UUID, process::Owned<Subscriber>> subscribed;
+
+    bool recording;
+
+    // Time at which the last subscriber disconnected, if no subscriber
+    // is connected.
+    Option<process::Time> idleSince;
+
+    // Sequence number of the last event sent.
+    uint64_t sequence;
+
+    // The most recently sent events, used to resume streams.
+    boost::circular_buffer<mesos::master::Event> events;
+
+    // Snapshots keyed by principal and content type, see `Snapshot`.
+    Cache<std::string, Snapshot> snapshots;
   } subscribers;
 
   hashmap<OfferID, Offer*> offers;
@@ -2066,6 +2306,22 @@ private:
   // copyable metric types only.
   std::shared_ptr<Metrics> metrics;
 
+  // Evaluates the given gauge handler. Gauges only read the state of
+  // the master, hence evaluating them is marked as read-only.
+  double gauge(double (Master::*handler)())
+  {
+    readOnly();
+    return (this->*handler)();
+  }
+
+  double resourceGauge(
+      double (Master::*handler)(const std::string&),
+      const std::string& name)
+  {
+    readOnly();
+    return (this->*handler)(name);
+  }
+
   // Gauge handlers.
   double _uptime_secs()
   {
@@ -2088,11 +2344,6 @@ private:
   double _frameworks_active();
   double _frameworks_inactive();
 
-  double _outstanding_offers()
-  {
-    return offers.size();
-  }
-
   double _event_queue_messages()
   {
     return static_cast<double>(eventCount<process::MessageEvent>());
@@ -2108,11 +2359,7 @@ private:
     return static_cast<double>(eventCount<process::HttpEvent>());
   }
 
-  double _tasks_staging();
-  double _tasks_starting();
-  double _tasks_running();
   double _tasks_unreachable();
-  double _tasks_killing();
 
   double _resources_total(const std::string& name);
   double _resources_used(const std::string& name);
@@ -2126,6 +2373,29 @@ private:
 
   Option<process::Time> electedTime; // Time when this master is elected.
 
+  // Increased after every event which might have changed the state
+  // exposed by the master's read-only endpoints (frameworks, agents,
+  // tasks, offers, ...), see `serve()`. Used to invalidate cached
+  // responses of these endpoints.
+  uint64_t stateGeneration;
+
+  // Marks the event being served as read-only, i.e., as one which does
+  // not change the state of the master, so that it does not advance
+  // `stateGeneration`. Used by the continuations of read-only endpoints
+  // and by gauges, which are dispatched to the master like any other
+  // event.
+  void readOnly() { readOnlyEvent = true; }
+
+  // Whether the event being served is read-only, see `readOnly()`.
+  bool readOnlyEvent;
+
+  // The shapes shared by the completed tasks of all frameworks.
+  TaskShapes taskShapes;
+
+  // Resources of removable tasks not yet recovered in the allocator,
+  // see `recoverTaskResources()`.
+  hashmap<FrameworkID, hashmap<SlaveID, Resources>> recoveredTaskResources;
+
   // Validates the framework including authorization.
   // Returns None if the framework is valid.
   // Returns Error if the framework is invalid.
@@ -2307,7 +2577,8 @@ struct Framework
     // means that there might be multiple completed tasks with the
     // same task ID. We should consider rejecting attempts to reuse
     // task IDs (MESOS-6779).
-    completedTasks.push_back(process::Owned<Task>(new Task(std::move(task))));
+    completedTasks.push_back(
+        CompactTask(std::move(task), &master->taskShapes));
   }
 
   void addUnreachableTask(const Task& task)
@@ -2799,8 +3070,9 @@ struct Framework
   // state and have had all their updates acknowledged. We only keep a
   // fixed-size cache to avoid consuming too much memory. We use
   // boost::circular_buffer rather than BoundedHashMap because there
-  // can be multiple completed tasks with the same task ID.
-  boost::circular_buffer<process::Owned<Task>> completedTasks;
+  // can be multiple completed tasks with the same task ID. The tasks
+  // are stored in compact form and share their common fields.
+  boost::circular_buffer<CompactTask> completedTasks;
 
   // When an agent is marked unreachable, tasks running on it are stored
   // here. We only keep a fixed-size cache to avoid consuming too much memory.
@@ -2858,6 +3130,11 @@ struct Framework
   Resources totalOfferedResources;
   hashmap<SlaveID, Resources> offeredResources;
 
+  // Results of validating the resources of the framework's tasks, keyed
+  // by the serialized resources. Frameworks usually launch many tasks
+  // with the same resources, which then only need to be validated once.
+  Cache<std::string, Option<Error>> validatedResources;
+
   // This is only set for HTTP frameworks.
   Option<process::Owned<Heartbeater<scheduler::Event, v1::scheduler::Event>>>
     heartbeater;
@@ -2876,7 +3153,8 @@ private:
       registeredTime(time),
       reregisteredTime(time),
       completedTasks(masterFlags.max_completed_tasks_per_framework),
-      unreachableTasks(masterFlags.max_unreachable_tasks_per_framework)
+      unreachableTasks(masterFlags.max_unreachable_tasks_per_framework),
+      validatedResources(MAX_VALIDATED_RESOURCES_PER_FRAMEWORK)
   {
     foreach (const std::string& role, roles) {
       // NOTE: It's possible that we're already being tracked under the role
@@ -19,6 +19,7 @@
 #include <process/metrics/counter.hpp>
 #include <process/metrics/gauge.hpp>
 #include <process/metrics/metrics.hpp>
+#include <process/metrics/push_gauge.hpp>
 
 #include <stout/foreach.hpp>
 
@@ -27,6 +28,7 @@
 
 using process::metrics::Counter;
 using process::metrics::Gauge;
+using process::metrics::PushGauge;
 
 using std::string;
 
@@ -40,55 +42,45 @@ namespace master {
 Metrics::Metrics(const Master& master)
   : uptime_secs(
         "master/uptime_secs",
-        defer(master, &Master::_uptime_secs)),
+        defer(master, &Master::gauge, &Master::_uptime_secs)),
     elected(
         "master/elected",
-        defer(master, &Master::_elected)),
+        defer(master, &Master::gauge, &Master::_elected)),
     slaves_connected(
         "master/slaves_connected",
-        defer(master, &Master::_slaves_connected)),
+        defer(master, &Master::gauge, &Master::_slaves_connected)),
     slaves_disconnected(
         "master/slaves_disconnected",
-        defer(master, &Master::_slaves_disconnected)),
+        defer(master, &Master::gauge, &Master::_slaves_disconnected)),
     slaves_active(
         "master/slaves_active",
-        defer(master, &Master::_slaves_active)),
+        defer(master, &Master::gauge, &Master::_slaves_active)),
     slaves_inactive(
         "master/slaves_inactive",
-        defer(master, &Master::_slaves_inactive)),
+        defer(master, &Master::gauge, &Master::_slaves_inactive)),
     slaves_unreachable(
         "master/slaves_unreachable",
-        defer(master, &Master::_slaves_unreachable)),
+        defer(master, &Master::gauge, &Master::_slaves_unreachable)),
     frameworks_connected(
         "master/frameworks_connected",
-        defer(master, &Master::_frameworks_connected)),
+        defer(master, &Master::gauge, &Master::_frameworks_connected)),
     frameworks_disconnected(
         "master/frameworks_disconnected",
-        defer(master, &Master::_frameworks_disconnected)),
+        defer(master, &Master::gauge, &Master::_frameworks_disconnected)),
     frameworks_active(
         "master/frameworks_active",
-        defer(master, &Master::_frameworks_active)),
+        defer(master, &Master::gauge, &Master::_frameworks_active)),
     frameworks_inactive(
         "master/frameworks_inactive",
-        defer(master, &Master::_frameworks_inactive)),
-    outstanding_offers(
-        "master/outstanding_offers",
-        defer(master, &Master::_outstanding_offers)),
-    tasks_staging(
-        "master/tasks_staging",
-        defer(master, &Master::_tasks_staging)),
-    tasks_starting(
-        "master/tasks_starting",
-        defer(master, &Master::_tasks_starting)),
-    tasks_running(
-        "master/tasks_running",
-        defer(master, &Master::_tasks_running)),
+        defer(master, &Master::gauge, &Master::_frameworks_inactive)),
+    outstanding_offers("master/outstanding_offers"),
+    tasks_staging("master/tasks_staging"),
+    tasks_starting("master/tasks_starting"),
+    tasks_running("master/tasks_running"),
     tasks_unreachable(
         "master/tasks_unreachable",
-        defer(master, &Master::_tasks_unreachable)),
-    tasks_killing(
-        "master/tasks_killing",
-        defer(master, &Master::_tasks_killing)),
+        defer(master, &Master::gauge, &Master::_tasks_unreachable)),
+    tasks_killing("master/tasks_killing"),
     tasks_finished(
         "master/tasks_finished"),
     tasks_failed(
@@ -107,6 +99,8 @@ Metrics::Metrics(const Master& master)
         "master/tasks_gone_by_operator"),
     dropped_messages(
         "master/dropped_messages"),
+    http_api_latency(
+        "master/http_api_latency_ms"),
     messages_register_framework(
         "master/messages_register_framework"),
     messages_reregister_framework(
@@ -169,13 +163,13 @@ Metrics::Metrics(const Master& master)
         "master/recovery_slave_removals"),
     event_queue_messages(
         "master/event_queue_messages",
-        defer(master, &Master::_event_queue_messages)),
+        defer(master, &Master::gauge, &Master::_event_queue_messages)),
     event_queue_dispatches(
         "master/event_queue_dispatches",
-        defer(master, &Master::_event_queue_dispatches)),
+        defer(master, &Master::gauge, &Master::_event_queue_dispatches)),
     event_queue_http_requests(
         "master/event_queue_http_requests",
-        defer(master, &Master::_event_queue_http_requests)),
+        defer(master, &Master::gauge, &Master::_event_queue_http_requests)),
     slave_registrations(
         "master/slave_registrations"),
     slave_reregistrations(
@@ -234,6 +228,8 @@ Metrics::Metrics(const Master& master)
 
   process::metrics::add(dropped_messages);
 
+  process::metrics::add(http_api_latency);
+
   // Messages from schedulers.
   process::metrics::add(messages_register_framework);
   process::metrics::add(messages_reregister_framework);
@@ -302,15 +298,27 @@ Metrics::Metrics(const Master& master)
   foreach (const string& resource, resources) {
     Gauge total(
         "master/" + resource + "_total",
-        defer(master, &Master::_resources_total, resource));
+        defer(
+            master,
+            &Master::resourceGauge,
+            &Master::_resources_total,
+            resource));
 
     Gauge used(
         "master/" + resource + "_used",
-        defer(master, &Master::_resources_used, resource));
+        defer(
+            master,
+            &Master::resourceGauge,
+            &Master::_resources_used,
+            resource));
 
     Gauge percent(
         "master/" + resource + "_percent",
-        defer(master, &Master::_resources_percent, resource));
+        defer(
+            master,
+            &Master::resourceGauge,
+            &Master::_resources_percent,
+            resource));
 
     resources_total.push_back(total);
     resources_used.push_back(used);
@@ -324,15 +332,27 @@ Metrics::Metrics(const Master& master)
   foreach (const string& resource, resources) {
     Gauge total(
         "master/" + resource + "_revocable_total",
-        defer(master, &Master::_resources_revocable_total, resource));
+        defer(
+            master,
+            &Master::resourceGauge,
+            &Master::_resources_revocable_total,
+            resource));
 
     Gauge used(
         "master/" + resource + "_revocable_used",
-        defer(master, &Master::_resources_revocable_used, resource));
+        defer(
+            master,
+            &Master::resourceGauge,
+            &Master::_resources_revocable_used,
+            resource));
 
     Gauge percent(
         "master/" + resource + "_revocable_percent",
-        defer(master, &Master::_resources_revocable_percent, resource));
+        defer(
+            master,
+            &Master::resourceGauge,
+            &Master::_resources_revocable_percent,
+            resource));
 
     resources_revocable_total.push_back(total);
     resources_revocable_used.push_back(used);
@@ -380,6 +400,8 @@ Metrics::~Metrics()
 
   process::metrics::remove(dropped_messages);
 
+  process::metrics::remove(http_api_latency);
+
   // Messages from schedulers.
   process::metrics::remove(messages_register_framework);
   process::metrics::remove(messages_reregister_framework);
@@ -510,6 +532,38 @@ void Metrics::incrementTasksStates(
 }
 
 
+Option<PushGauge> Metrics::tasksState(const TaskState& state)
+{
+  // NOTE: Pending tasks are accounted for as TASK_STAGING by the
+  // master directly.
+  switch (state) {
+    case TASK_STAGING: return tasks_staging;
+    case TASK_STARTING: return tasks_starting;
+    case TASK_RUNNING: return tasks_running;
+    case TASK_KILLING: return tasks_killing;
+    default: return None();
+  }
+}
+
+
+void Metrics::addTask(const TaskState& state)
+{
+  Option<PushGauge> gauge = tasksState(state);
+  if (gauge.isSome()) {
+    ++gauge.get();
+  }
+}
+
+
+void Metrics::removeTask(const TaskState& state)
+{
+  Option<PushGauge> gauge = tasksState(state);
+  if (gauge.isSome()) {
+    --gauge.get();
+  }
+}
+
+
 } // namespace master {
 } // namespace internal {
 } // namespace mesos {
@@ -22,9 +22,12 @@
 
 #include <process/metrics/counter.hpp>
 #include <process/metrics/gauge.hpp>
+#include <process/metrics/histogram.hpp>
 #include <process/metrics/metrics.hpp>
+#include <process/metrics/push_gauge.hpp>
 
 #include <stout/hashmap.hpp>
+#include <stout/option.hpp>
 
 #include "mesos/mesos.hpp"
 #include "mesos/type_utils.hpp"
@@ -55,14 +58,17 @@ struct Metrics
   process::metrics::Gauge frameworks_active;
   process::metrics::Gauge frameworks_inactive;
 
-  process::metrics::Gauge outstanding_offers;
+  // NOTE: The following gauges are updated by the master as offers
+  // and tasks change, so that reading them does not need to dispatch
+  // to (and wait for) the master actor, nor walk all of its tasks.
+  process::metrics::PushGauge outstanding_offers;
 
   // Task state metrics.
-  process::metrics::Gauge tasks_staging;
-  process::metrics::Gauge tasks_starting;
-  process::metrics::Gauge tasks_running;
+  process::metrics::PushGauge tasks_staging;
+  process::metrics::PushGauge tasks_starting;
+  process::metrics::PushGauge tasks_running;
   process::metrics::Gauge tasks_unreachable;
-  process::metrics::Gauge tasks_killing;
+  process::metrics::PushGauge tasks_killing;
   process::metrics::Counter tasks_finished;
   process::metrics::Counter tasks_failed;
   process::metrics::Counter tasks_killed;
@@ -81,6 +87,9 @@ struct Metrics
   // Message counters.
   process::metrics::Counter dropped_messages;
 
+  // Latency of the calls to the v1 scheduler and operator APIs.
+  process::metrics::Histogram http_api_latency;
+
   // Metrics specific to frameworks of a common principal.
   // These metrics have names prefixed by "frameworks/<principal>/".
   struct Frameworks
@@ -104,18 +113,30 @@ struct Metrics
     // requested by this message has finished.
     process::metrics::Counter messages_processed;
 
+    // Framework messages and HTTP calls queued by a RateLimiter, and
+    // those dropped because the capacity of the RateLimiter was
+    // exceeded.
+    process::metrics::Counter messages_throttled;
+    process::metrics::Counter messages_dropped;
+
     explicit Frameworks(const std::string& principal)
       : messages_received("frameworks/" + principal + "/messages_received"),
-        messages_processed("frameworks/" + principal + "/messages_processed")
+        messages_processed("frameworks/" + principal + "/messages_processed"),
+        messages_throttled("frameworks/" + principal + "/messages_throttled"),
+        messages_dropped("frameworks/" + principal + "/messages_dropped")
     {
       process::metrics::add(messages_received);
       process::metrics::add(messages_processed);
+      process::metrics::add(messages_throttled);
+      process::metrics::add(messages_dropped);
     }
 
     ~Frameworks()
     {
       process::metrics::remove(messages_received);
       process::metrics::remove(messages_processed);
+      process::metrics::remove(messages_throttled);
+      process::metrics::remove(messages_dropped);
     }
   };
 
@@ -205,6 +226,15 @@ struct Metrics
       const TaskState& state,
       const TaskStatus::Source& source,
       const TaskStatus::Reason& reason);
+
+  // Updates the task state gauges for a task in 'state' being added
+  // to or removed from an agent. Called on every state transition.
+  void addTask(const TaskState& state);
+  void removeTask(const TaskState& state);
+
+private:
+  // Returns the gauge tracking tasks in 'state', if any.
+  Option<process::metrics::PushGauge> tasksState(const TaskState& state);
 };
 
 } // namespace master {
@@ -16,6 +16,9 @@
 
 #include "master/registry_operations.hpp"
 
+#include <stout/foreach.hpp>
+#include <stout/hashmap.hpp>
+
 #include "common/resources_utils.hpp"
 
 namespace mesos {
@@ -147,9 +150,19 @@ Try<bool> MarkSlaveUnreachable::perform(
 // "admitted" lists, if its metadata has been garbage collected from
 // the registry.
 MarkSlaveReachable::MarkSlaveReachable(const SlaveInfo& _info)
-  : info(_info)
+  : infos({_info})
 {
-  CHECK(info.has_id()) << "SlaveInfo is missing the 'id' field";
+  CHECK(_info.has_id()) << "SlaveInfo is missing the 'id' field";
+}
+
+
+MarkSlaveReachable::MarkSlaveReachable(
+    const std::vector<SlaveInfo>& _infos)
+  : infos(_infos)
+{
+  foreach (const SlaveInfo& info, infos) {
+    CHECK(info.has_id()) << "SlaveInfo is missing the 'id' field";
+  }
 }
 
 
@@ -163,41 +176,59 @@ Try<bool> MarkSlaveReachable::perform(
   // before they are marked unreachable. In this situation, the
   // registry is already in the correct state, so no changes are
   // needed.
-  if (slaveIDs->contains(info.id())) {
+  hashmap<SlaveID, const SlaveInfo*> reachable;
+  foreach (const SlaveInfo& info, infos) {
+    if (!slaveIDs->contains(info.id())) {
+      reachable[info.id()] = &info;
+    }
+  }
+
+  if (reachable.empty()) {
     return false; // No mutation.
   }
 
-  // Check whether the slave is in the unreachable list.
-  // TODO(neilc): Optimize this to avoid linear scan.
-  bool found = false;
-  for (int i = 0; i < registry->unreachable().slaves().size(); i++) {
-    const Registry::UnreachableSlave& slave =
-      registry->unreachable().slaves(i);
-
-    if (slave.id() == info.id()) {
-      registry->mutable_unreachable()->mutable_slaves()->DeleteSubrange(i, 1);
-      found = true;
-      break;
+  // Remove the slaves from the unreachable list in a single pass,
+  // preserving the order of the remaining entries.
+  google::protobuf::RepeatedPtrField<Registry::UnreachableSlave>*
+    unreachable = registry->mutable_unreachable()->mutable_slaves();
+
+  hashset<SlaveID> found;
+  int size = 0;
+  for (int i = 0; i < unreachable->size(); i++) {
+    const SlaveID& id = unreachable->Get(i).id();
+
+    if (reachable.contains(id)) {
+      found.insert(id);
+    } else {
+      unreachable->SwapElements(i, size++);
     }
   }
 
-  if (!found) {
-    LOG(WARNING) << "Allowing UNKNOWN agent to reregister: " << info;
-  }
+  unreachable->DeleteSubrange(size, unreachable->size() - size);
 
-  // Convert the resource format back to `PRE_RESERVATION_REFINEMENT` so
-  // the data stored in the registry can be read by older master versions.
-  SlaveInfo _info(info);
-  convertResourceFormat(_info.mutable_resources(),
-    PRE_RESERVATION_REFINEMENT);
+  foreach (const SlaveInfo& info, infos) {
+    if (!reachable.contains(info.id()) || slaveIDs->contains(info.id())) {
+      continue;
+    }
 
-  // Add the slave to the admitted list, even if we didn't find it
-  // in the unreachable list. This accounts for when the slave was
-  // unreachable for a long time, was GC'd from the unreachable
-  // list, but then eventually reregistered.
-  Registry::Slave* slave = registry->mutable_slaves()->add_slaves();
-  slave->mutable_info()->CopyFrom(_info);
-  slaveIDs->insert(_info.id());
+    if (!found.contains(info.id())) {
+      LOG(WARNING) << "Allowing UNKNOWN agent to reregister: " << info;
+    }
+
+    // Convert the resource format back to `PRE_RESERVATION_REFINEMENT` so
+    // the data stored in the registry can be read by older master versions.
+    SlaveInfo _info(info);
+    convertResourceFormat(_info.mutable_resources(),
+      PRE_RESERVATION_REFINEMENT);
+
+    // Add the slave to the admitted list, even if we didn't find it
+    // in the unreachable list. This accounts for when the slave was
+    // unreachable for a long time, was GC'd from the unreachable
+    // list, but then eventually reregistered.
+    Registry::Slave* slave = registry->mutable_slaves()->add_slaves();
+    slave->mutable_info()->CopyFrom(_info);
+    slaveIDs->insert(_info.id());
+  }
 
   return true; // Mutation.
 }
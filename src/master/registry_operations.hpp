@@ -17,6 +17,8 @@
 #ifndef __MASTER_REGISTRY_OPERATIONS_HPP__
 #define __MASTER_REGISTRY_OPERATIONS_HPP__
 
+#include <vector>
+
 #include <mesos/mesos.hpp>
 #include <mesos/type_utils.hpp>
 
@@ -84,11 +86,15 @@ class MarkSlaveReachable : public RegistryOperation
 public:
   explicit MarkSlaveReachable(const SlaveInfo& _info);
 
+  // Marks multiple agents reachable at once, which only requires a
+  // single pass over the list of unreachable agents.
+  explicit MarkSlaveReachable(const std::vector<SlaveInfo>& _infos);
+
 protected:
   virtual Try<bool> perform(Registry* registry, hashset<SlaveID>* slaveIDs);
 
 private:
-  const SlaveInfo info;
+  const std::vector<SlaveInfo> infos;
 };
 
 
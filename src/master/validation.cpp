@@ -17,6 +17,7 @@
 #include "master/validation.hpp"
 
 #include <algorithm>
+#include <functional>
 #include <iterator>
 #include <set>
 #include <string>
@@ -1257,6 +1258,35 @@ Option<Error> validateTaskAndExecutorResources(const TaskInfo& task)
 }
 
 
+// Same as `validateResources()`, but reuses the result for resources
+// which were validated for the framework before.
+Option<Error> validateCachedResources(
+    const TaskInfo& task,
+    Framework* framework)
+{
+  // The resources are serialized with a length prefix each, so that
+  // different resources never have the same fingerprint.
+  string fingerprint;
+  foreach (const Resource& resource, task.resources()) {
+    const string serialized = resource.SerializeAsString();
+    fingerprint += stringify(serialized.size()) + ":" + serialized;
+  }
+
+  Option<Option<Error>> cached =
+    framework->validatedResources.get(fingerprint);
+
+  if (cached.isSome()) {
+    return cached.get();
+  }
+
+  Option<Error> error = validateResources(task);
+
+  framework->validatedResources.put(fingerprint, error);
+
+  return error;
+}
+
+
 // Validates the `CommandInfo` contained within a `TaskInfo`.
 Option<Error> validateCommandInfo(const TaskInfo& task)
 {
@@ -1298,16 +1328,19 @@ Option<Error> validateTask(
 
   // NOTE: The order in which the following validate functions are
   // executed does matter!
+  //
+  // NOTE: The task is bound by reference to avoid copying it for
+  // every validator, which is costly for large task groups.
   vector<lambda::function<Option<Error>()>> validators = {
-    lambda::bind(internal::validateTaskID, task),
-    lambda::bind(internal::validateUniqueTaskID, task, framework),
-    lambda::bind(internal::validateSlaveID, task, slave),
-    lambda::bind(internal::validateKillPolicy, task),
-    lambda::bind(internal::validateCheck, task),
-    lambda::bind(internal::validateHealthCheck, task),
-    lambda::bind(internal::validateResources, task),
-    lambda::bind(internal::validateCommandInfo, task),
-    lambda::bind(internal::validateContainerInfo, task)
+    lambda::bind(internal::validateTaskID, std::cref(task)),
+    lambda::bind(internal::validateUniqueTaskID, std::cref(task), framework),
+    lambda::bind(internal::validateSlaveID, std::cref(task), slave),
+    lambda::bind(internal::validateKillPolicy, std::cref(task)),
+    lambda::bind(internal::validateCheck, std::cref(task)),
+    lambda::bind(internal::validateHealthCheck, std::cref(task)),
+    lambda::bind(internal::validateCachedResources, std::cref(task), framework),
+    lambda::bind(internal::validateCommandInfo, std::cref(task)),
+    lambda::bind(internal::validateContainerInfo, std::cref(task))
   };
 
   foreach (const lambda::function<Option<Error>()>& validator, validators) {
@@ -1443,8 +1476,13 @@ Option<Error> validate(
   CHECK_NOTNULL(slave);
 
   vector<lambda::function<Option<Error>()>> validators = {
-    lambda::bind(internal::validateTask, task, framework, slave),
-    lambda::bind(internal::validateExecutor, task, framework, slave, offered)
+    lambda::bind(internal::validateTask, std::cref(task), framework, slave),
+    lambda::bind(
+        internal::validateExecutor,
+        std::cref(task),
+        framework,
+        slave,
+        std::cref(offered))
   };
 
   foreach (const lambda::function<Option<Error>()>& validator, validators) {
@@ -1555,9 +1593,15 @@ Option<Error> validateExecutor(
   }
 
   // Validate the `ExecutorInfo` in all tasks are same.
+  //
+  // Comparing the serialized executors first avoids the costlier
+  // semantic comparison for the common case of identical executors.
+  const string serializedExecutor = executor.SerializeAsString();
 
   foreach (const TaskInfo& task, taskGroup.tasks()) {
-    if (task.has_executor() && task.executor() != executor) {
+    if (task.has_executor() &&
+        task.executor().SerializeAsString() != serializedExecutor &&
+        task.executor() != executor) {
       return Error(
           "The `ExecutorInfo` of "
           "task '" + stringify(task.task_id()) + "' is different from "
@@ -0,0 +1,189 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "slave/checkpointer.hpp"
+
+#include <vector>
+
+#include <process/dispatch.hpp>
+#include <process/id.hpp>
+#include <process/owned.hpp>
+#include <process/process.hpp>
+
+#include <stout/foreach.hpp>
+#include <stout/option.hpp>
+#include <stout/path.hpp>
+
+#include <stout/os/mkdir.hpp>
+#include <stout/os/mktemp.hpp>
+#include <stout/os/rename.hpp>
+#include <stout/os/rm.hpp>
+
+#include "logging/logging.hpp"
+
+using namespace process;
+
+using process::wait; // Necessary on some OS's to disambiguate.
+
+using std::string;
+using std::vector;
+
+namespace mesos {
+namespace internal {
+namespace slave {
+
+class CheckpointerProcess : public Process<CheckpointerProcess>
+{
+public:
+  CheckpointerProcess()
+    : ProcessBase(process::ID::generate("agent-checkpointer")) {}
+
+  virtual ~CheckpointerProcess()
+  {
+    foreach (const Request& request, pending) {
+      request.promise->fail("Checkpointer terminated");
+    }
+  }
+
+  Future<Nothing> checkpoint(
+      const string& path,
+      const lambda::function<Try<Nothing>(const string&)>& write)
+  {
+    Request request;
+    request.path = path;
+    request.write = write;
+    request.promise.reset(new Promise<Nothing>());
+
+    Future<Nothing> future = request.promise->future();
+
+    pending.push_back(request);
+
+    // The commit is dispatched behind the checkpoints that are already
+    // queued on this process, so all of them form a single batch.
+    if (pending.size() == 1) {
+      dispatch(self(), &Self::commit);
+    }
+
+    return future;
+  }
+
+private:
+  struct Request
+  {
+    string path;
+    lambda::function<Try<Nothing>(const string&)> write;
+    Owned<Promise<Nothing>> promise;
+
+    // The temporary file the data is written to before it is renamed
+    // to 'path', and the error, if any, encountered on the way.
+    string temp;
+    Option<Error> error;
+  };
+
+  void commit()
+  {
+    vector<Request> batch;
+    std::swap(batch, pending);
+
+    VLOG(1) << "Committing a batch of " << batch.size() << " checkpoints";
+
+    // First write all the temporary files, then rename them into
+    // place in the order in which the checkpoints were requested.
+    // Like 'state::checkpoint()', the files are not synced.
+    foreach (Request& request, batch) {
+      const string base = Path(request.path).dirname();
+
+      Try<Nothing> mkdir = os::mkdir(base);
+      if (mkdir.isError()) {
+        request.error = Error(
+            "Failed to create directory '" + base + "': " + mkdir.error());
+        continue;
+      }
+
+      // NOTE: We create the temporary file at 'base/XXXXXX' to make
+      // sure the rename below does not cross devices (MESOS-2319).
+      Try<string> temp = os::mktemp(path::join(base, "XXXXXX"));
+      if (temp.isError()) {
+        request.error = Error(
+            "Failed to create temporary file: " + temp.error());
+        continue;
+      }
+
+      request.temp = temp.get();
+
+      Try<Nothing> write = request.write(request.temp);
+      if (write.isError()) {
+        request.error = Error(
+            "Failed to write temporary file '" + request.temp +
+            "': " + write.error());
+      }
+    }
+
+    foreach (Request& request, batch) {
+      if (request.error.isNone()) {
+        Try<Nothing> rename = os::rename(request.temp, request.path);
+        if (rename.isError()) {
+          request.error = Error(
+              "Failed to rename '" + request.temp + "' to '" +
+              request.path + "': " + rename.error());
+        }
+      }
+
+      if (request.error.isSome()) {
+        LOG(ERROR) << "Failed to checkpoint '" << request.path << "': "
+                   << request.error->message;
+
+        // Try removing the temporary file on error.
+        if (!request.temp.empty()) {
+          os::rm(request.temp);
+        }
+
+        request.promise->fail(request.error->message);
+      } else {
+        request.promise->set(Nothing());
+      }
+    }
+  }
+
+  vector<Request> pending;
+};
+
+
+Checkpointer::Checkpointer()
+{
+  process = new CheckpointerProcess();
+  spawn(process);
+}
+
+
+Checkpointer::~Checkpointer()
+{
+  terminate(process);
+  wait(process);
+  delete process;
+}
+
+
+Future<Nothing> Checkpointer::_checkpoint(
+    const string& path,
+    const lambda::function<Try<Nothing>(const string&)>& write)
+{
+  return dispatch(process, &CheckpointerProcess::checkpoint, path, write);
+}
+
+} // namespace slave {
+} // namespace internal {
+} // namespace mesos {
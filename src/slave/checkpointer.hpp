@@ -0,0 +1,79 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __SLAVE_CHECKPOINTER_HPP__
+#define __SLAVE_CHECKPOINTER_HPP__
+
+#include <string>
+
+#include <process/future.hpp>
+
+#include <stout/lambda.hpp>
+#include <stout/nothing.hpp>
+#include <stout/try.hpp>
+
+#include "slave/state.hpp"
+
+namespace mesos {
+namespace internal {
+namespace slave {
+
+// Forward declarations.
+class CheckpointerProcess;
+
+// Checkpoints data to disk on behalf of the agent without blocking
+// the agent actor. Checkpoints requested while a previous batch is
+// being committed are committed together as a group: every file of a
+// batch is first written to a temporary file, then all of them are
+// renamed into place. Each file keeps the all-or-nothing semantics of
+// 'state::checkpoint()'.
+//
+// NOTE: Like 'state::checkpoint()', the files are not synced, so a
+// checkpoint in place survives an agent restart but might not survive
+// a crash of the machine.
+class Checkpointer
+{
+public:
+  Checkpointer();
+  virtual ~Checkpointer();
+
+  // Checkpoints an instance of T at the given path. The supported Ts
+  // are the ones supported by 'state::checkpoint()'. The future will
+  // become ready once the checkpoint is in place, and fail on error,
+  // in which case the previous content (if any) of the path is kept.
+  // Checkpoints to the same path are applied in the order in which
+  // they were requested.
+  template <typename T>
+  process::Future<Nothing> checkpoint(const std::string& path, const T& t)
+  {
+    return _checkpoint(path, [t](const std::string& temp) {
+      return state::internal::checkpoint(temp, t);
+    });
+  }
+
+private:
+  process::Future<Nothing> _checkpoint(
+      const std::string& path,
+      const lambda::function<Try<Nothing>(const std::string&)>& write);
+
+  CheckpointerProcess* process;
+};
+
+} // namespace slave {
+} // namespace internal {
+} // namespace mesos {
+
+#endif // __SLAVE_CHECKPOINTER_HPP__
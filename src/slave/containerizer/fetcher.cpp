@@ -16,6 +16,8 @@
 
 #include "slave/containerizer/fetcher.hpp"
 
+#include <algorithm>
+
 #include <process/async.hpp>
 #include <process/check.hpp>
 #include <process/collect.hpp>
@@ -28,7 +30,9 @@
 
 #include <stout/hashmap.hpp>
 #include <stout/hashset.hpp>
+#include <stout/json.hpp>
 #include <stout/net.hpp>
+#include <stout/numify.hpp>
 #include <stout/path.hpp>
 #include <stout/strings.hpp>
 #include <stout/uri.hpp>
@@ -47,6 +51,8 @@
 
 #include "common/status_utils.hpp"
 
+#include "slave/state.hpp"
+
 #include "slave/containerizer/fetcher_process.hpp"
 
 using std::list;
@@ -73,10 +79,16 @@ namespace slave {
 
 static const string CACHE_FILE_NAME_PREFIX = "c";
 
+// NOTE: This name must not contain CACHE_FILE_NAME_PREFIX, so that
+// the index is not mistaken for a cache file.
+static const string CACHE_INDEX_FILE_NAME = "index.json";
+
 
 Fetcher::Fetcher(const Flags& flags) : process(new FetcherProcess(flags))
 {
-  if (os::exists(flags.fetcher_cache_dir)) {
+  // If the cache is to be recovered, the FetcherProcess has already
+  // taken care of the contents of the cache directory.
+  if (!flags.fetcher_cache_recovery && os::exists(flags.fetcher_cache_dir)) {
     Try<Nothing> rmdir = os::rmdir(flags.fetcher_cache_dir, true);
     CHECK_SOME(rmdir)
       << "Could not delete fetcher cache directory '"
@@ -254,6 +266,10 @@ void Fetcher::kill(const ContainerID& containerId)
 FetcherProcess::Metrics::Metrics(FetcherProcess *fetcher)
   : task_fetches_succeeded("containerizer/fetcher/task_fetches_succeeded"),
     task_fetches_failed("containerizer/fetcher/task_fetches_failed"),
+    cache_hits("containerizer/fetcher/cache_hits"),
+    cache_misses("containerizer/fetcher/cache_misses"),
+    cache_bytes_saved("containerizer/fetcher/cache_bytes_saved"),
+    cache_evictions("containerizer/fetcher/cache_evictions"),
     cache_size_total_bytes(
         "containerizer/fetcher/cache_size_total_bytes",
         [=]() {
@@ -269,6 +285,10 @@ FetcherProcess::Metrics::Metrics(FetcherProcess *fetcher)
 {
   process::metrics::add(task_fetches_succeeded);
   process::metrics::add(task_fetches_failed);
+  process::metrics::add(cache_hits);
+  process::metrics::add(cache_misses);
+  process::metrics::add(cache_bytes_saved);
+  process::metrics::add(cache_evictions);
   process::metrics::add(cache_size_total_bytes);
   process::metrics::add(cache_size_used_bytes);
 }
@@ -278,6 +298,10 @@ FetcherProcess::Metrics::~Metrics()
 {
   process::metrics::remove(task_fetches_succeeded);
   process::metrics::remove(task_fetches_failed);
+  process::metrics::remove(cache_hits);
+  process::metrics::remove(cache_misses);
+  process::metrics::remove(cache_bytes_saved);
+  process::metrics::remove(cache_evictions);
 
   // Wait for the metrics to be removed before we allow the destructor
   // to complete.
@@ -293,6 +317,24 @@ FetcherProcess::FetcherProcess(const Flags& _flags)
       flags(_flags),
       cache(_flags.fetcher_cache_size)
 {
+  if (flags.fetcher_cache_recovery && os::exists(flags.fetcher_cache_dir)) {
+    Try<Nothing> recover = cache.recover(flags.fetcher_cache_dir);
+    if (recover.isError()) {
+      LOG(WARNING) << "Failed to recover the fetcher cache, clearing '"
+                   << flags.fetcher_cache_dir << "': " << recover.error();
+
+      Try<Nothing> rmdir = os::rmdir(flags.fetcher_cache_dir, true);
+      CHECK_SOME(rmdir)
+        << "Could not delete fetcher cache directory '"
+        << flags.fetcher_cache_dir << "': " + rmdir.error();
+    } else {
+      metrics.cache_evictions += cache.evictions();
+
+      LOG(INFO) << "Recovered " << cache.size() << " fetcher cache entries"
+                << " using " << cache.usedSpace() << " from '"
+                << flags.fetcher_cache_dir << "'";
+    }
+  }
 }
 
 
@@ -540,10 +582,15 @@ Future<Nothing> FetcherProcess::__fetch(
         // completion in FetcherProcess::fetch().
         item->set_action(FetcherInfo::Item::DOWNLOAD_AND_CACHE);
         item->set_cache_filename(entry.get()->filename);
+
+        ++metrics.cache_misses;
       } else {
         CHECK_READY(entry.get()->completion());
         item->set_action(FetcherInfo::Item::RETRIEVE_FROM_CACHE);
         item->set_cache_filename(entry.get()->filename);
+
+        ++metrics.cache_hits;
+        metrics.cache_bytes_saved += entry.get()->size.bytes();
       }
     } else {
       item->set_action(FetcherInfo::Item::BYPASS_CACHE);
@@ -588,6 +635,8 @@ Future<Nothing> FetcherProcess::__fetch(
     .then(defer(self(), [=]() {
       ++metrics.task_fetches_succeeded;
 
+      bool completed = false;
+
       foreachvalue (const Option<shared_ptr<Cache::Entry>>& entry, entries) {
         if (entry.isSome()) {
           entry.get()->unreference();
@@ -598,6 +647,7 @@ Future<Nothing> FetcherProcess::__fetch(
             Try<Nothing> adjust = cache.adjust(entry.get());
             if (adjust.isSome()) {
               entry.get()->complete();
+              completed = true;
             } else {
               LOG(WARNING) << "Failed to adjust the cache size for entry '"
                            << entry.get()->key << "' with error: "
@@ -612,11 +662,31 @@ Future<Nothing> FetcherProcess::__fetch(
         }
       }
 
+      if (completed) {
+        checkpointCache();
+      }
+
       return Nothing();
     }));
 }
 
 
+void FetcherProcess::checkpointCache()
+{
+  if (!flags.fetcher_cache_recovery) {
+    return;
+  }
+
+  Try<Nothing> checkpoint = cache.checkpoint(flags.fetcher_cache_dir);
+  if (checkpoint.isError()) {
+    // The cache keeps working, but some of its recent changes may not
+    // be recovered after an agent restart.
+    LOG(WARNING) << "Failed to checkpoint the fetcher cache index: "
+                 << checkpoint.error();
+  }
+}
+
+
 static off_t delta(
     const Bytes& actualSize,
     const shared_ptr<FetcherProcess::Cache::Entry>& entry)
@@ -697,8 +767,18 @@ FetcherProcess::reserveCacheSpace(
                    requestedSpace.error());
   }
 
+  const size_t evictions = cache.evictions();
+
   Try<Nothing> reservation = cache.reserve(requestedSpace.get());
 
+  // Do not leave evicted entries in the index, even if not enough space
+  // could be freed up.
+  if (cache.evictions() != evictions) {
+    metrics.cache_evictions += cache.evictions() - evictions;
+
+    checkpointCache();
+  }
+
   if (reservation.isError()) {
     // Let anyone waiting on this future know that we've
     // failed to download and they should bypass the cache
@@ -1150,6 +1230,8 @@ Try<Nothing> FetcherProcess::Cache::reserve(
       if (removal.isError()) {
         return Error(removal.error());
       }
+
+      ++evictionCount;
     }
   }
 
@@ -1192,6 +1274,185 @@ size_t FetcherProcess::Cache::size() const
 }
 
 
+size_t FetcherProcess::Cache::evictions() const
+{
+  return evictionCount;
+}
+
+
+Try<Nothing> FetcherProcess::Cache::checkpoint(
+    const string& cacheDirectory) const
+{
+  JSON::Array entries;
+
+  foreach (const shared_ptr<Cache::Entry>& entry, lruSortedEntries) {
+    // Only completely downloaded entries can be reused after a restart.
+    if (!entry->completion().isReady()) {
+      continue;
+    }
+
+    JSON::Object object;
+    object.values["key"] = entry->key;
+    object.values["directory"] = entry->directory;
+    object.values["filename"] = entry->filename;
+    object.values["size"] = entry->size.bytes();
+
+    entries.values.push_back(object);
+  }
+
+  JSON::Object index;
+  index.values["entries"] = entries;
+
+  return state::checkpoint(
+      path::join(cacheDirectory, CACHE_INDEX_FILE_NAME),
+      stringify(index));
+}
+
+
+Try<Nothing> FetcherProcess::Cache::recover(const string& cacheDirectory)
+{
+  CHECK(table.empty());
+
+  const string indexPath = path::join(cacheDirectory, CACHE_INDEX_FILE_NAME);
+
+  // First parse the whole index, so that we do not end up with a
+  // partially recovered cache on error.
+  list<shared_ptr<Cache::Entry>> entries;
+  unsigned long serial = 0;
+
+  if (os::exists(indexPath)) {
+    Try<string> read = os::read(indexPath);
+    if (read.isError()) {
+      return Error("Failed to read '" + indexPath + "': " + read.error());
+    }
+
+    Try<JSON::Object> index = JSON::parse<JSON::Object>(read.get());
+    if (index.isError()) {
+      return Error("Failed to parse '" + indexPath + "': " + index.error());
+    }
+
+    Result<JSON::Array> array = index->at<JSON::Array>("entries");
+    if (!array.isSome()) {
+      return Error("Missing or invalid 'entries' in '" + indexPath + "'");
+    }
+
+    foreach (const JSON::Value& value, array->values) {
+      if (!value.is<JSON::Object>()) {
+        return Error("Invalid entry in '" + indexPath + "'");
+      }
+
+      const JSON::Object& object = value.as<JSON::Object>();
+
+      Result<JSON::String> key = object.at<JSON::String>("key");
+      Result<JSON::String> directory = object.at<JSON::String>("directory");
+      Result<JSON::String> filename = object.at<JSON::String>("filename");
+      Result<JSON::Number> size = object.at<JSON::Number>("size");
+
+      if (!key.isSome() || !directory.isSome() ||
+          !filename.isSome() || !size.isSome()) {
+        return Error("Incomplete entry in '" + indexPath + "'");
+      }
+
+      // Cache files are either in the cache directory itself or in one
+      // of its per-user subdirectories, see FetcherProcess::fetch().
+      if ((directory->value != cacheDirectory &&
+           Path(directory->value).dirname() != cacheDirectory) ||
+          !startsWith(filename->value, CACHE_FILE_NAME_PREFIX) ||
+          strings::contains(filename->value, "/")) {
+        return Error("Invalid cache file '" +
+                     path::join(directory->value, filename->value) +
+                     "' in '" + indexPath + "'");
+      }
+
+      auto entry = shared_ptr<Cache::Entry>(new Cache::Entry(
+          key->value, directory->value, filename->value));
+
+      entry->size = Bytes(size->as<uint64_t>());
+
+      // The file may have been lost after the index was checkpointed.
+      Try<Bytes> actual = os::stat::size(
+          entry->path().string(),
+          os::stat::FollowSymlink::DO_NOT_FOLLOW_SYMLINK);
+
+      if (actual.isError() || actual.get() != entry->size) {
+        LOG(WARNING) << "Not recovering fetcher cache entry '" << entry->key
+                     << "' because its file is missing or has changed: "
+                     << entry->path();
+        continue;
+      }
+
+      // Cache file names are of the form "c<serial>-<basename>", see
+      // nextFilename(). New names must not collide with recovered ones.
+      const string& name = filename->value;
+      Try<unsigned long> number = numify<unsigned long>(name.substr(
+          CACHE_FILE_NAME_PREFIX.size(),
+          name.find('-') - CACHE_FILE_NAME_PREFIX.size()));
+
+      if (number.isSome()) {
+        serial = std::max(serial, number.get());
+      }
+
+      entries.push_back(entry);
+    }
+  }
+
+  // Delete all files that are not part of a recovered entry, e.g.,
+  // partial downloads and the files of evicted entries.
+  hashset<string> paths;
+  foreach (const shared_ptr<Cache::Entry>& entry, entries) {
+    paths.insert(entry->path().string());
+  }
+
+  Try<list<string>> files = os::find(cacheDirectory, "");
+  if (files.isError()) {
+    return Error("Failed to list '" + cacheDirectory + "': " + files.error());
+  }
+
+  foreach (const string& file, files.get()) {
+    if (file != indexPath && !paths.contains(file)) {
+      VLOG(1) << "Deleting unrecovered fetcher cache file: " << file;
+
+      Try<Nothing> rm = os::rm(file);
+      if (rm.isError()) {
+        LOG(WARNING) << "Failed to delete '" << file << "': " << rm.error();
+      }
+    }
+  }
+
+  filenameSerial = std::max(filenameSerial, serial);
+
+  foreach (const shared_ptr<Cache::Entry>& entry, entries) {
+    table.put(entry->key, entry);
+    lruSortedEntries.push_back(entry);
+
+    claimSpace(entry->size);
+
+    entry->complete();
+  }
+
+  // The cache may have been configured to be smaller than before.
+  while (tally > space && !lruSortedEntries.empty()) {
+    Try<Nothing> removal = remove(lruSortedEntries.front());
+    if (removal.isError()) {
+      LOG(WARNING) << removal.error();
+    }
+
+    ++evictionCount;
+  }
+
+  // The recovered entries are in use from now on, so a failure to
+  // checkpoint the index must not fail the recovery. The next
+  // recovery skips the entries whose files have been evicted.
+  Try<Nothing> checkpoint = this->checkpoint(cacheDirectory);
+  if (checkpoint.isError()) {
+    LOG(WARNING) << "Failed to checkpoint the fetcher cache index: "
+                 << checkpoint.error();
+  }
+
+  return Nothing();
+}
+
+
 void FetcherProcess::Cache::claimSpace(const Bytes& bytes)
 {
   tally += bytes;
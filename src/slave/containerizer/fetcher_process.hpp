@@ -133,7 +133,8 @@ public:
       process::Promise<Nothing> promise;
     };
 
-    explicit Cache(Bytes _space) : space(_space), tally(0), filenameSerial(0) {}
+    explicit Cache(Bytes _space)
+      : space(_space), tally(0), filenameSerial(0), evictionCount(0) {}
     virtual ~Cache() {}
 
     void claimSpace(const Bytes& bytes);
@@ -189,6 +190,23 @@ public:
     // Number of entries.
     size_t size() const;
 
+    // Number of entries that have been evicted to free up cache space.
+    size_t evictions() const;
+
+    // Writes the keys, files and sizes of all completely downloaded
+    // entries, in LRU order, to an index file in the given (top-level)
+    // cache directory.
+    Try<Nothing> checkpoint(const std::string& cacheDirectory) const;
+
+    // Restores the entries listed in the index file in the given cache
+    // directory, as completely downloaded and unreferenced. Entries
+    // whose cache files are missing or do not have the recorded size
+    // are skipped, and all cache files that are not listed are deleted.
+    // Must be called before any entries are created. Returns an error,
+    // without having changed the cache, if the index cannot be read.
+    // A failure to checkpoint the resulting index is only logged.
+    Try<Nothing> recover(const std::string& cacheDirectory);
+
   private:
     // Maximum storable number of bytes in the cache directory.
     const Bytes space;
@@ -199,6 +217,9 @@ public:
     // Used to generate distinct cache file names simply by counting.
     unsigned long filenameSerial;
 
+    // How many entries have been evicted so far.
+    size_t evictionCount;
+
     // Maps keys (cache directory / URI combinations) to cache file
     // entries.
     hashmap<std::string, std::shared_ptr<Entry>> table;
@@ -239,6 +260,10 @@ private:
       const std::string& cacheDirectory,
       const Option<std::string>& user);
 
+  // Checkpoints the cache index if the cache is to be recovered after
+  // an agent restart. Logs a warning on failure.
+  void checkpointCache();
+
   // Calls Cache::reserve() and returns a ready entry future if successful,
   // else Failure. Claims the space and assigns the entry's size to this
   // amount if and only if successful.
@@ -258,6 +283,12 @@ private:
     process::metrics::Counter task_fetches_succeeded;
     process::metrics::Counter task_fetches_failed;
 
+    // NOTE: These metrics count per URI, not per task.
+    process::metrics::Counter cache_hits;
+    process::metrics::Counter cache_misses;
+    process::metrics::Counter cache_bytes_saved;
+    process::metrics::Counter cache_evictions;
+
     process::metrics::Gauge cache_size_total_bytes;
     process::metrics::Gauge cache_size_used_bytes;
   } metrics;
@@ -18,6 +18,8 @@
 
 #include <stout/error.hpp>
 #include <stout/option.hpp>
+#include <stout/os.hpp>
+#include <stout/path.hpp>
 
 #include "linux/cgroups.hpp"
 
@@ -162,9 +164,53 @@ Future<ResourceStatistics> CpuSubsystem::usage(
     }
   }
 
+  // Add the pressure stall information if the kernel reports it for
+  // this hierarchy. It is optional, so the fields are left unset if
+  // it cannot be read.
+  if (pressureReaders.contains(containerId) ||
+      os::exists(path::join(hierarchy, cgroup, "cpu.pressure"))) {
+    Try<cgroups::psi::Pressure> pressure = Error("Not read");
+
+    if (!pressureReaders.contains(containerId)) {
+      Try<Owned<cgroups::ControlReader>> reader =
+        cgroups::ControlReader::create(hierarchy, cgroup, "cpu.pressure");
+
+      if (reader.isError()) {
+        pressure = Error(reader.error());
+      } else {
+        pressureReaders.put(containerId, reader.get());
+      }
+    }
+
+    if (pressureReaders.contains(containerId)) {
+      pressure = cgroups::psi::read(pressureReaders[containerId].get());
+    }
+
+    if (pressure.isSome()) {
+      result.set_cpus_pressure_some_avg10(pressure->some.avg10);
+      result.set_cpus_pressure_some_total_secs(pressure->some.total.secs());
+    } else if (!pressureWarned) {
+      LOG(WARNING) << "Skipping the pressure stall information of container "
+                   << containerId << " and any further failures to read it: "
+                   << "Failed to read 'cpu.pressure': " << pressure.error();
+
+      pressureWarned = true;
+    }
+  }
+
   return result;
 }
 
+
+Future<Nothing> CpuSubsystem::cleanup(
+    const ContainerID& containerId,
+    const string& cgroup)
+{
+  pressureReaders.erase(containerId);
+
+  return Nothing();
+}
+
 } // namespace slave {
 } // namespace internal {
 } // namespace mesos {
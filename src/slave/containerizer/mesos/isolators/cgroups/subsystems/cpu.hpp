@@ -19,10 +19,15 @@
 
 #include <string>
 
+#include <process/future.hpp>
 #include <process/owned.hpp>
 
+#include <stout/hashmap.hpp>
+#include <stout/nothing.hpp>
 #include <stout/try.hpp>
 
+#include "linux/cgroups.hpp"
+
 #include "slave/flags.hpp"
 
 #include "slave/containerizer/mesos/isolators/cgroups/constants.hpp"
@@ -58,8 +63,20 @@ public:
       const ContainerID& containerId,
       const std::string& cgroup);
 
+  virtual process::Future<Nothing> cleanup(
+      const ContainerID& containerId,
+      const std::string& cgroup);
+
 private:
   CpuSubsystem(const Flags& flags, const std::string& hierarchy);
+
+  // Readers of 'cpu.pressure' for each container, created on the
+  // first call to 'usage' and closed on 'cleanup'.
+  hashmap<ContainerID, process::Owned<cgroups::ControlReader>>
+    pressureReaders;
+
+  // Whether a failure to read 'cpu.pressure' has been logged.
+  bool pressureWarned = false;
 };
 
 } // namespace slave {
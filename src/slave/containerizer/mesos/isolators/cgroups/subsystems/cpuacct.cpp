@@ -88,10 +88,18 @@ Future<ResourceStatistics> CpuacctSubsystem::usage(
   PCHECK(ticks > 0) << "Failed to get sysconf(_SC_CLK_TCK)";
 
   // Add the cpuacct.stat information.
-  Try<hashmap<string, uint64_t>> stat = cgroups::stat(
-      hierarchy,
-      cgroup,
-      "cpuacct.stat");
+  if (!statReaders.contains(containerId)) {
+    Try<Owned<cgroups::ControlReader>> reader =
+      cgroups::ControlReader::create(hierarchy, cgroup, "cpuacct.stat");
+
+    if (reader.isError()) {
+      return Failure("Failed to open 'cpuacct.stat': " + reader.error());
+    }
+
+    statReaders.put(containerId, reader.get());
+  }
+
+  Try<hashmap<string, uint64_t>> stat = statReaders[containerId]->stat();
 
   if (stat.isError()) {
     return Failure("Failed to read 'cpuacct.stat': " + stat.error());
@@ -110,6 +118,16 @@ Future<ResourceStatistics> CpuacctSubsystem::usage(
   return result;
 }
 
+
+Future<Nothing> CpuacctSubsystem::cleanup(
+    const ContainerID& containerId,
+    const string& cgroup)
+{
+  statReaders.erase(containerId);
+
+  return Nothing();
+}
+
 } // namespace slave {
 } // namespace internal {
 } // namespace mesos {
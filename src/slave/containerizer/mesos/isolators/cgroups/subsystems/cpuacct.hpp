@@ -19,10 +19,15 @@
 
 #include <string>
 
+#include <process/future.hpp>
 #include <process/owned.hpp>
 
+#include <stout/hashmap.hpp>
+#include <stout/nothing.hpp>
 #include <stout/try.hpp>
 
+#include "linux/cgroups.hpp"
+
 #include "slave/flags.hpp"
 
 #include "slave/containerizer/mesos/isolators/cgroups/constants.hpp"
@@ -53,8 +58,16 @@ public:
       const ContainerID& containerId,
       const std::string& cgroup);
 
+  virtual process::Future<Nothing> cleanup(
+      const ContainerID& containerId,
+      const std::string& cgroup);
+
 private:
   CpuacctSubsystem(const Flags& flags, const std::string& hierarchy);
+
+  // Readers of 'cpuacct.stat' for each container, created on the
+  // first call to 'usage' and closed on 'cleanup'.
+  hashmap<ContainerID, process::Owned<cgroups::ControlReader>> statReaders;
 };
 
 } // namespace slave {
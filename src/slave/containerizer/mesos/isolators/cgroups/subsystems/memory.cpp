@@ -27,12 +27,16 @@
 #include <stout/error.hpp>
 #include <stout/option.hpp>
 #include <stout/os.hpp>
+#include <stout/path.hpp>
 #include <stout/result.hpp>
+#include <stout/strings.hpp>
 
 #include "common/protobuf_utils.hpp"
 
 #include "slave/containerizer/mesos/isolators/cgroups/subsystems/memory.hpp"
 
+using cgroups::ControlReader;
+
 using cgroups::memory::pressure::Counter;
 using cgroups::memory::pressure::Level;
 
@@ -300,6 +304,50 @@ Future<Nothing> MemorySubsystem::update(
 }
 
 
+// Opens the control file into 'reader' unless it is already open.
+static Try<Nothing> openReader(
+    Option<Owned<ControlReader>>* reader,
+    const string& hierarchy,
+    const string& cgroup,
+    const string& control)
+{
+  if (reader->isNone()) {
+    Try<Owned<ControlReader>> create =
+      ControlReader::create(hierarchy, cgroup, control);
+
+    if (create.isError()) {
+      return Error(create.error());
+    }
+
+    *reader = create.get();
+  }
+
+  return Nothing();
+}
+
+
+// Reads a control file holding a number of bytes (e.g.
+// 'memory.usage_in_bytes') through the cached reader.
+static Try<Bytes> readBytes(
+    Option<Owned<ControlReader>>* reader,
+    const string& hierarchy,
+    const string& cgroup,
+    const string& control)
+{
+  Try<Nothing> open = openReader(reader, hierarchy, cgroup, control);
+  if (open.isError()) {
+    return Error(open.error());
+  }
+
+  Try<string> read = reader->get()->read();
+  if (read.isError()) {
+    return Error(read.error());
+  }
+
+  return Bytes::parse(strings::trim(read.get()) + "B");
+}
+
+
 Future<ResourceStatistics> MemorySubsystem::usage(
     const ContainerID& containerId,
     const string& cgroup)
@@ -317,7 +365,11 @@ Future<ResourceStatistics> MemorySubsystem::usage(
   // The rss from memory.stat is wrong in two dimensions:
   //   1. It does not include child cgroups.
   //   2. It does not include any file backed pages.
-  Try<Bytes> usage = cgroups::memory::usage_in_bytes(hierarchy, cgroup);
+  Try<Bytes> usage = readBytes(
+      &info->usageReader,
+      hierarchy,
+      cgroup,
+      "memory.usage_in_bytes");
 
   if (usage.isError()) {
     return Failure("Failed to parse 'memory.usage_in_bytes': " + usage.error());
@@ -326,7 +378,11 @@ Future<ResourceStatistics> MemorySubsystem::usage(
   result.set_mem_total_bytes(usage.get().bytes());
 
   if (flags.cgroups_limit_swap) {
-    Try<Bytes> usage = cgroups::memory::memsw_usage_in_bytes(hierarchy, cgroup);
+    Try<Bytes> usage = readBytes(
+        &info->memswUsageReader,
+        hierarchy,
+        cgroup,
+        "memory.memsw.usage_in_bytes");
 
     if (usage.isError()) {
       return Failure(
@@ -338,11 +394,18 @@ Future<ResourceStatistics> MemorySubsystem::usage(
 
   // TODO(bmahler): Add namespacing to cgroups to enforce the expected
   // structure, e.g, cgroups::memory::stat.
-  Try<hashmap<string, uint64_t>> stat = cgroups::stat(
+  Try<Nothing> open = openReader(
+      &info->statReader,
       hierarchy,
       cgroup,
       "memory.stat");
 
+  if (open.isError()) {
+    return Failure("Failed to open 'memory.stat': " + open.error());
+  }
+
+  Try<hashmap<string, uint64_t>> stat = info->statReader.get()->stat();
+
   if (stat.isError()) {
     return Failure("Failed to read 'memory.stat': " + stat.error());
   }
@@ -378,6 +441,43 @@ Future<ResourceStatistics> MemorySubsystem::usage(
     result.set_mem_unevictable_bytes(total_unevictable.get());
   }
 
+  // Add the pressure stall information if the kernel reports it for
+  // this hierarchy. It is optional, so the fields are left unset if
+  // it cannot be read.
+  if (info->pressureReader.isSome() ||
+      os::exists(path::join(hierarchy, cgroup, "memory.pressure"))) {
+    Try<cgroups::psi::Pressure> pressure = Error("Not read");
+
+    Try<Nothing> open = openReader(
+        &info->pressureReader,
+        hierarchy,
+        cgroup,
+        "memory.pressure");
+
+    if (open.isError()) {
+      pressure = Error(open.error());
+    } else {
+      pressure = cgroups::psi::read(info->pressureReader->get());
+    }
+
+    if (pressure.isSome()) {
+      result.set_mem_pressure_some_avg10(pressure->some.avg10);
+      result.set_mem_pressure_some_total_secs(pressure->some.total.secs());
+
+      if (pressure->full.isSome()) {
+        result.set_mem_pressure_full_avg10(pressure->full->avg10);
+        result.set_mem_pressure_full_total_secs(
+            pressure->full->total.secs());
+      }
+    } else if (!pressureWarned) {
+      LOG(WARNING) << "Skipping the pressure stall information of container "
+                   << containerId << " and any further failures to read it: "
+                   << "Failed to read 'memory.pressure': " << pressure.error();
+
+      pressureWarned = true;
+    }
+  }
+
   // Get pressure counter readings.
   list<Level> levels;
   list<Future<uint64_t>> values;
@@ -25,6 +25,7 @@
 
 #include <stout/hashmap.hpp>
 #include <stout/nothing.hpp>
+#include <stout/option.hpp>
 #include <stout/try.hpp>
 
 #include "linux/cgroups.hpp"
@@ -91,6 +92,13 @@ private:
         process::Owned<cgroups::memory::pressure::Counter>> pressureCounters;
 
     process::Promise<mesos::slave::ContainerLimitation> limitation;
+
+    // Readers of the control files sampled in 'usage', created on
+    // first use and kept open for the lifetime of the container.
+    Option<process::Owned<cgroups::ControlReader>> usageReader;
+    Option<process::Owned<cgroups::ControlReader>> memswUsageReader;
+    Option<process::Owned<cgroups::ControlReader>> statReader;
+    Option<process::Owned<cgroups::ControlReader>> pressureReader;
   };
 
   MemorySubsystem(const Flags& flags, const std::string& hierarchy);
@@ -121,6 +129,9 @@ private:
 
   // Stores cgroups associated information for container.
   hashmap<ContainerID, process::Owned<Info>> infos;
+
+  // Whether a failure to read 'memory.pressure' has been logged.
+  bool pressureWarned = false;
 };
 
 } // namespace slave {
@@ -14,18 +14,27 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <fnmatch.h>
 #include <signal.h>
+#include <time.h>
 
 #ifdef __linux__
 #include <sys/prctl.h>
 #endif
+#include <sys/stat.h>
 #include <sys/types.h>
 
 #include <deque>
+#include <list>
+#include <memory>
 #include <tuple>
+#include <utility>
+
+#include <boost/functional/hash.hpp>
 
 #include <glog/logging.h>
 
+#include <process/async.hpp>
 #include <process/check.hpp>
 #include <process/collect.hpp>
 #include <process/defer.hpp>
@@ -36,6 +45,8 @@
 
 #include <stout/check.hpp>
 #include <stout/foreach.hpp>
+#include <stout/hashmap.hpp>
+#include <stout/hashset.hpp>
 #include <stout/lambda.hpp>
 #include <stout/numify.hpp>
 #include <stout/strings.hpp>
@@ -44,16 +55,22 @@
 #include <stout/os/constants.hpp>
 #include <stout/os/exists.hpp>
 #include <stout/os/killtree.hpp>
+#include <stout/os/ls.hpp>
 #include <stout/os/stat.hpp>
 
 #include "common/protobuf_utils.hpp"
 
+#ifdef __linux__
+#include "linux/ioprio.hpp"
+#endif // __linux__
+
 #include "slave/containerizer/mesos/isolators/posix/disk.hpp"
 
 namespace io = process::io;
 
 using std::deque;
 using std::list;
+using std::pair;
 using std::string;
 using std::vector;
 
@@ -101,7 +118,11 @@ PosixDiskIsolatorProcess::Info::PathInfo::~PathInfo()
 PosixDiskIsolatorProcess::PosixDiskIsolatorProcess(const Flags& _flags)
   : ProcessBase(process::ID::generate("posix-disk-isolator")),
     flags(_flags),
-    collector(flags.container_disk_watch_interval) {}
+    collector(
+        flags.container_disk_watch_interval,
+        flags.container_disk_usage_collector == "walk"
+          ? DiskUsageCollector::Method::WALK
+          : DiskUsageCollector::Method::DU) {}
 
 
 PosixDiskIsolatorProcess::~PosixDiskIsolatorProcess() {}
@@ -461,12 +482,226 @@ Future<Nothing> PosixDiskIsolatorProcess::cleanup(
 }
 
 
+// The number of walks for which the usage of the files of an unchanged
+// directory is reused, after which its files are stat'ed again. Writing
+// to a file does not update the modification time of its directory, so
+// such writes are only accounted for once the usage is revalidated.
+static const size_t MAX_DIRECTORY_USAGE_REUSES = 10;
+
+
+// The usage of the files of a directory (i.e., of all its entries which
+// are not directories), as of the given modification time of the
+// directory, along with the names of its subdirectories. The entries
+// are unchanged as long as the modification time is, since adding,
+// removing or renaming an entry updates the modification time.
+struct DirectoryUsage
+{
+  struct timespec mtime;
+
+  // The number of walks which reused this usage.
+  size_t reuses;
+
+  // The blocks allocated for the files with a single link.
+  uint64_t blocks;
+
+  // The files with multiple hard links, which are counted once per walk
+  // (device, inode, blocks).
+  vector<std::tuple<dev_t, ino_t, uint64_t>> links;
+
+  vector<string> subdirectories;
+};
+
+
+// The directory usages of the last walk of a path, which depend on the
+// excludes of the walk.
+struct DirectoryUsages
+{
+  vector<string> excludes;
+  hashmap<string, DirectoryUsage> directories;
+};
+
+
+static struct timespec mtime(const struct stat& s)
+{
+#ifdef __APPLE__
+  return s.st_mtimespec;
+#else
+  return s.st_mtim;
+#endif // __APPLE__
+}
+
+
+// Returns true if 'path' matches any of the given patterns the way
+// 'du --exclude' does, i.e., if a pattern matches the whole path or
+// any suffix of it which starts after a '/'.
+static bool excluded(const string& path, const vector<string>& excludes)
+{
+  foreach (const string& pattern, excludes) {
+    if (::fnmatch(pattern.c_str(), path.c_str(), 0) == 0) {
+      return true;
+    }
+
+    size_t slash = path.find('/');
+    while (slash != string::npos) {
+      if (slash + 1 < path.size() &&
+          path[slash + 1] != '/' &&
+          ::fnmatch(pattern.c_str(), path.c_str() + slash + 1, 0) == 0) {
+        return true;
+      }
+
+      slash = path.find('/', slash + 1);
+    }
+  }
+
+  return false;
+}
+
+
+// Returns the disk usage rooted at 'root' the same way as 'du -s':
+// the blocks allocated for all the files and directories, without
+// following symbolic links and counting hard links only once.
+//
+// The files of a directory are only stat'ed if its modification time
+// changed since the walk recorded in 'usages' (see `DirectoryUsage`),
+// which is then replaced by the usages of this walk. Subdirectories
+// are still stat'ed on every walk, since changes within them do not
+// update the modification time of their parent.
+static Try<Bytes> walk(
+    const string& root,
+    const vector<string>& excludes,
+    const std::shared_ptr<DirectoryUsages>& usages)
+{
+#ifdef __linux__
+  // Do not starve the I/O of running tasks, see also the garbage
+  // collector.
+  ioprio::LowIOPriority priority;
+#endif // __linux__
+
+  const time_t start = ::time(nullptr);
+
+  struct stat s;
+  if (::lstat(root.c_str(), &s) < 0) {
+    return ErrnoError("Failed to stat '" + root + "'");
+  }
+
+  uint64_t blocks = s.st_blocks;
+
+  if (usages->excludes != excludes) {
+    usages->excludes = excludes;
+    usages->directories.clear();
+  }
+
+  hashmap<string, DirectoryUsage> next;
+  hashset<pair<dev_t, ino_t>, boost::hash<pair<dev_t, ino_t>>> links;
+
+  vector<pair<string, struct timespec>> directories;
+  if (S_ISDIR(s.st_mode)) {
+    directories.push_back(std::make_pair(root, mtime(s)));
+  }
+
+  while (!directories.empty()) {
+    const string directory = directories.back().first;
+    const struct timespec modified = directories.back().second;
+    directories.pop_back();
+
+    Option<DirectoryUsage> usage = usages->directories.get(directory);
+
+    if (usage.isSome() &&
+        usage->mtime.tv_sec == modified.tv_sec &&
+        usage->mtime.tv_nsec == modified.tv_nsec &&
+        usage->reuses < MAX_DIRECTORY_USAGE_REUSES) {
+      usage->reuses++;
+
+      foreach (const string& subdirectory, usage->subdirectories) {
+        const string path = path::join(directory, subdirectory);
+
+        // The subdirectory might have been removed since the last walk.
+        if (::lstat(path.c_str(), &s) < 0 || !S_ISDIR(s.st_mode)) {
+          continue;
+        }
+
+        blocks += s.st_blocks;
+        directories.push_back(std::make_pair(path, mtime(s)));
+      }
+    } else {
+      Try<list<string>> entries = os::ls(directory);
+      if (entries.isError()) {
+        if (directory == root) {
+          return Error(entries.error());
+        }
+
+        // The directory might have been removed during the walk.
+        VLOG(1) << "Skipping '" << directory << "': " << entries.error();
+        continue;
+      }
+
+      usage = DirectoryUsage();
+      usage->mtime = modified;
+      usage->reuses = 0;
+      usage->blocks = 0;
+
+      foreach (const string& entry, entries.get()) {
+        const string path = path::join(directory, entry);
+
+        if (excluded(path, excludes)) {
+          continue;
+        }
+
+        // The entry might have been removed since the listing.
+        if (::lstat(path.c_str(), &s) < 0) {
+          continue;
+        }
+
+        if (S_ISDIR(s.st_mode)) {
+          usage->subdirectories.push_back(entry);
+
+          blocks += s.st_blocks;
+          directories.push_back(std::make_pair(path, mtime(s)));
+        } else if (s.st_nlink > 1) {
+          usage->links.push_back(
+              std::make_tuple(s.st_dev, s.st_ino, s.st_blocks));
+        } else {
+          usage->blocks += s.st_blocks;
+        }
+      }
+    }
+
+    blocks += usage->blocks;
+
+    foreach (const auto& link, usage->links) {
+      const pair<dev_t, ino_t> inode =
+        std::make_pair(std::get<0>(link), std::get<1>(link));
+
+      if (!links.contains(inode)) {
+        links.insert(inode);
+        blocks += std::get<2>(link);
+      }
+    }
+
+    // A directory could be modified again within the granularity of
+    // its modification time, so we only keep the usages of the
+    // directories which have not been modified recently.
+    if (modified.tv_sec < start - 1) {
+      next.put(directory, std::move(usage.get()));
+    }
+  }
+
+  usages->directories = std::move(next);
+
+  // 'st_blocks' is the number of 512-byte blocks allocated.
+  return Bytes(blocks * 512);
+}
+
+
 class DiskUsageCollectorProcess : public Process<DiskUsageCollectorProcess>
 {
 public:
-  DiskUsageCollectorProcess(const Duration& _interval)
+  DiskUsageCollectorProcess(
+      const Duration& _interval,
+      DiskUsageCollector::Method _method)
     : ProcessBase(process::ID::generate("posix-disk-usage-collector")),
-      interval(_interval) {}
+      interval(_interval),
+      method(_method) {}
   virtual ~DiskUsageCollectorProcess() {}
 
   Future<Bytes> usage(
@@ -520,14 +755,19 @@ private:
     string path;
     vector<string> excludes;
     Option<Subprocess> du;
+    bool walking = false;
     Promise<Bytes> promise;
   };
 
   void discard(const string& path)
   {
+    // The path is no longer checked, so we do not need to keep the
+    // directory usages of its last walk.
+    usages.erase(path);
+
     for (auto it = entries.begin(); it != entries.end(); ++it) {
-      // We only cancel those checks whose 'du' haven't been launched.
-      if ((*it)->path == path && (*it)->du.isNone()) {
+      // We only cancel those checks which haven't been started.
+      if ((*it)->path == path && (*it)->du.isNone() && !(*it)->walking) {
         (*it)->promise.discard();
         entries.erase(it);
         break;
@@ -548,6 +788,20 @@ private:
 
     const Owned<Entry>& entry = entries.front();
 
+    if (method == DiskUsageCollector::Method::WALK) {
+      if (!usages.contains(entry->path)) {
+        usages.put(entry->path, std::make_shared<DirectoryUsages>());
+      }
+
+      entry->walking = true;
+
+      // NOTE: The walk blocks, so we run it outside of this process.
+      process::async(&walk, entry->path, entry->excludes, usages[entry->path])
+        .onAny(defer(self(), &Self::_walk, lambda::_1));
+
+      return;
+    }
+
     // Invoke 'du' and report number of 1K-byte blocks. We fix the
     // block size here so that we can get consistent results on all
     // platforms (e.g., OS X uses 512 byte blocks).
@@ -664,16 +918,48 @@ private:
     delay(interval, self(), &Self::schedule);
   }
 
+  void _walk(const Future<Try<Bytes>>& future)
+  {
+    CHECK(!entries.empty());
+
+    const Owned<Entry>& entry = entries.front();
+    CHECK(entry->walking);
+
+    if (!future.isReady()) {
+      entry->promise.fail(
+          "Failed to walk '" + entry->path + "': " +
+          (future.isFailed() ? future.failure() : "discarded"));
+    } else if (future->isError()) {
+      entry->promise.fail(
+          "Failed to walk '" + entry->path + "': " + future->error());
+    } else {
+      entry->promise.set(future->get());
+    }
+
+    if (!entry->promise.future().isReady()) {
+      usages.erase(entry->path);
+    }
+
+    entries.pop_front();
+    delay(interval, self(), &Self::schedule);
+  }
+
   const Duration interval;
+  const DiskUsageCollector::Method method;
 
   // A queue of pending checks.
   deque<Owned<Entry>> entries;
+
+  // The directory usages of the last walk of each path.
+  hashmap<string, std::shared_ptr<DirectoryUsages>> usages;
 };
 
 
-DiskUsageCollector::DiskUsageCollector(const Duration& interval)
+DiskUsageCollector::DiskUsageCollector(
+    const Duration& interval,
+    Method method)
 {
-  process = new DiskUsageCollectorProcess(interval);
+  process = new DiskUsageCollectorProcess(interval, method);
   spawn(process);
 }
 
@@ -42,7 +42,14 @@ class DiskUsageCollectorProcess;
 class DiskUsageCollector
 {
 public:
-  DiskUsageCollector(const Duration& interval);
+  // How the disk usage of a path is collected.
+  enum class Method
+  {
+    DU,   // Run a 'du' subprocess.
+    WALK, // Walk the directory tree within the agent.
+  };
+
+  DiskUsageCollector(const Duration& interval, Method method = Method::DU);
   ~DiskUsageCollector();
 
   // Returns the disk usage rooted at 'path'. The user can discard the
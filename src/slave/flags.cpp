@@ -240,14 +240,27 @@ mesos::internal::slave::Flags::Flags()
   add(&Flags::fetcher_cache_dir,
       "fetcher_cache_dir",
       "Directory for the fetcher cache. The agent will clear this directory\n"
-      "on startup. It is recommended to set this value to a separate volume\n"
-      "for several reasons:\n"
+      "on startup, unless `--fetcher_cache_recovery` is set. It is\n"
+      "recommended to set this value to a separate volume for several\n"
+      "reasons:\n"
       "  * The cache directories are transient and not meant to be\n"
-      "    backed up. Upon restarting the agent, the cache is always empty.\n"
+      "    backed up. Upon restarting the agent, the cache is empty (see\n"
+      "    `--fetcher_cache_recovery`).\n"
       "  * The cache and container sandboxes can potentially interfere with\n"
       "    each other when occupying a shared space (i.e. disk contention).",
       path::join(os::temp(), "mesos", "fetch"));
 
+  add(&Flags::fetcher_cache_recovery,
+      "fetcher_cache_recovery",
+      "If set to `true`, the agent keeps the contents of the fetcher cache\n"
+      "directory across restarts instead of clearing it on startup. The\n"
+      "cache index is checkpointed to the cache directory whenever a file\n"
+      "is added or removed, and the cache files listed there are reused\n"
+      "after a restart. Files that are not listed in the index (e.g.,\n"
+      "partial downloads) are deleted. If the index cannot be recovered,\n"
+      "the cache directory is cleared as usual.",
+      false);
+
   add(&Flags::work_dir,
       "work_dir",
       "Path of the agent work directory. This is where executor sandboxes\n"
@@ -453,6 +466,21 @@ mesos::internal::slave::Flags::Flags()
       "be a value between 0.0 and 1.0",
       GC_DISK_HEADROOM);
 
+  add(&Flags::gc_parallelism,
+      "gc_parallelism",
+      "Maximum number of executor directories that are deleted\n"
+      "concurrently by the garbage collector. Each concurrent deletion\n"
+      "occupies a libprocess worker thread while it runs, so this\n"
+      "should be kept well below the number of worker threads.",
+      DEFAULT_GC_PARALLELISM,
+      [](const size_t& value) -> Option<Error> {
+        if (value == 0) {
+          return Error("Expected --gc_parallelism to be positive");
+        }
+
+        return None();
+      });
+
   add(&Flags::disk_watch_interval,
       "disk_watch_interval",
       "Periodic time interval (e.g., 10secs, 2mins, etc)\n"
@@ -1125,6 +1153,27 @@ mesos::internal::slave::Flags::Flags()
       "used for the `disk/du` isolator.",
       Seconds(15));
 
+  add(&Flags::container_disk_usage_collector,
+      "container_disk_usage_collector",
+      "How the `disk/du` isolator collects the disk usage of containers.\n"
+      "Either `du`, which runs a `du` subprocess for each check, or `walk`,\n"
+      "which walks the directory tree within the agent with a low I/O\n"
+      "priority. The walk only re-reads and stats the files of directories\n"
+      "whose modification time changed since the previous check of the\n"
+      "same path, or which were reused for 10 checks. Writes to existing\n"
+      "files might thus only be accounted for after 10 checks. In both\n"
+      "cases at most one check runs at a time, at most once per\n"
+      "`--container_disk_watch_interval`.",
+      "du",
+      [](const string& value) -> Option<Error> {
+        if (value != "du" && value != "walk") {
+          return Error(
+              "Expected `--container_disk_usage_collector` to be either"
+              " `du` or `walk`");
+        }
+        return None();
+      });
+
   // TODO(jieyu): Consider enabling this flag by default. Remember
   // to update the user doc if we decide to do so.
   add(&Flags::enforce_container_disk_quota,
@@ -1290,6 +1339,23 @@ mesos::internal::slave::Flags::Flags()
       "flag.",
       Seconds(15));
 
+  add(&Flags::container_usage_sampling_interval,
+      "container_usage_sampling_interval",
+      "If set, the agent collects the resource usage of all executors at\n"
+      "this interval and serves the `/monitor/statistics` and `/containers`\n"
+      "endpoints, the resource estimator and the QoS controller from the\n"
+      "most recent sample, instead of querying the containerizer for every\n"
+      "request. The statistics of each container include the time they\n"
+      "were sampled at.",
+      [](const Option<Duration>& value) -> Option<Error> {
+        if (value.isSome() && value.get() <= Duration::zero()) {
+          return Error(
+              "Expected `--container_usage_sampling_interval` to be positive");
+        }
+
+        return None();
+      });
+
   add(&Flags::master_detector,
       "master_detector",
       "The symbol name of the master detector to use. This symbol\n"
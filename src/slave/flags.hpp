@@ -67,6 +67,7 @@ public:
   Option<std::string> attributes;
   Bytes fetcher_cache_size;
   std::string fetcher_cache_dir;
+  bool fetcher_cache_recovery;
   std::string work_dir;
   std::string runtime_dir;
   std::string launcher_dir;
@@ -90,6 +91,7 @@ public:
 #endif // USE_SSL_SOCKET
   Duration gc_delay;
   double gc_disk_headroom;
+  size_t gc_parallelism;
   Duration disk_watch_interval;
 
   Option<std::string> container_logger;
@@ -158,6 +160,7 @@ public:
   Option<std::string> network_cni_plugins_dir;
   Option<std::string> network_cni_config_dir;
   Duration container_disk_watch_interval;
+  std::string container_disk_usage_collector;
   bool enforce_container_disk_quota;
   Option<Modules> modules;
   Option<std::string> modulesDir;
@@ -176,6 +179,7 @@ public:
   Option<std::string> qos_controller;
   Duration qos_correction_interval_min;
   Duration oversubscribed_resources_interval;
+  Option<Duration> container_usage_sampling_interval;
   Option<std::string> master_detector;
 #if ENABLE_XFS_DISK_ISOLATOR
   std::string xfs_project_range;
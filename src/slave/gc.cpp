@@ -16,6 +16,10 @@
 
 #include "slave/gc.hpp"
 
+#ifndef __WINDOWS__
+#include <sys/stat.h>
+#endif // __WINDOWS__
+
 #include <list>
 
 #include <process/check.hpp>
@@ -25,11 +29,16 @@
 
 #include <process/metrics/metrics.hpp>
 
+#include <stout/bytes.hpp>
 #include <stout/foreach.hpp>
 #include <stout/lambda.hpp>
 
 #include <stout/os/rmdir.hpp>
 
+#ifdef __linux__
+#include "linux/ioprio.hpp"
+#endif // __linux__
+
 #include "logging/logging.hpp"
 
 #include "slave/gc_process.hpp"
@@ -48,6 +57,29 @@ namespace mesos {
 namespace internal {
 namespace slave {
 
+// Tracks the disk space and inodes freed by a path removal.
+struct Reclaimed
+{
+  Reclaimed() : bytes(0), inodes(0) {}
+
+  uint64_t bytes;
+  uint64_t inodes;
+};
+
+
+GarbageCollectorProcess::GarbageCollectorProcess(size_t parallelism)
+  : ProcessBase(process::ID::generate("agent-garbage-collector")),
+    metrics(this)
+{
+  CHECK_GT(parallelism, 0u);
+
+  for (size_t i = 0; i < parallelism; i++) {
+    executors.push_back(Owned<process::Executor>(new process::Executor()));
+    idle.push_back(i);
+  }
+}
+
+
 GarbageCollectorProcess::Metrics::Metrics(GarbageCollectorProcess *gc)
   : path_removals_succeeded("gc/path_removals_succeeded"),
     path_removals_failed("gc/path_removals_failed"),
@@ -56,11 +88,15 @@ GarbageCollectorProcess::Metrics::Metrics(GarbageCollectorProcess *gc)
       // basically has to be tracked as a member variable, which means we
       // can safely do concurrent reads while the map is being updated.
       return static_cast<double>(gc->paths.size());
-    })
+    }),
+    bytes_reclaimed("gc/bytes_reclaimed"),
+    inodes_reclaimed("gc/inodes_reclaimed")
 {
   process::metrics::add(path_removals_succeeded);
   process::metrics::add(path_removals_failed);
   process::metrics::add(path_removals_pending);
+  process::metrics::add(bytes_reclaimed);
+  process::metrics::add(inodes_reclaimed);
 }
 
 
@@ -68,6 +104,8 @@ GarbageCollectorProcess::Metrics::~Metrics()
 {
   process::metrics::remove(path_removals_succeeded);
   process::metrics::remove(path_removals_failed);
+  process::metrics::remove(bytes_reclaimed);
+  process::metrics::remove(inodes_reclaimed);
 
   // Wait for the metric to be removed to protect against asynchronous
   // evaluation referencing a deleted object.
@@ -159,25 +197,29 @@ Future<bool> GarbageCollectorProcess::unschedule(const string& path)
 
 
 // Fires a message to self for the next event. This also cancels any
-// existing timer.
+// existing timer. Paths which are already being removed (or queued for
+// removal) do not need an event.
 void GarbageCollectorProcess::reset()
 {
   Clock::cancel(timer); // Cancel the existing timer, if any.
-  if (!paths.empty()) {
-    Timeout removalTime = (*paths.begin()).first; // Get the first entry.
 
-    timer = delay(removalTime.remaining(), self(), &Self::remove, removalTime);
-  } else {
-    timer = Timer(); // Reset the timer.
+  foreach (const Timeout& removalTime, paths.keys()) {
+    foreach (const Owned<PathInfo>& info, paths.get(removalTime)) {
+      if (!info->removing) {
+        timer =
+          delay(removalTime.remaining(), self(), &Self::remove, removalTime);
+        return;
+      }
+    }
   }
+
+  timer = Timer(); // Reset the timer.
 }
 
 
 void GarbageCollectorProcess::remove(const Timeout& removalTime)
 {
   if (paths.count(removalTime) > 0) {
-    list<Owned<PathInfo>> infos;
-
     foreach (const Owned<PathInfo> info, paths.get(removalTime)) {
       if (info->removing) {
         VLOG(1) << "Skipping deletion of '" << info-> path
@@ -185,74 +227,126 @@ void GarbageCollectorProcess::remove(const Timeout& removalTime)
         continue;
       }
 
-      infos.push_back(info);
+      queue.push_back(info);
 
       // Set `removing` to signify that the path is being cleaned up.
       info->removing = true;
     }
 
+    removeQueued();
+  } else {
+    // This occurs when either:
+    //   1. The path(s) has already been removed (e.g. by prune()).
+    //   2. All paths under the removal time were unscheduled.
+    LOG(INFO) << "Ignoring gc event at " << removalTime.remaining()
+              << " as the paths were already removed, or were unscheduled";
+  }
+
+  reset();
+}
+
+
+void GarbageCollectorProcess::removeQueued()
+{
+  // NOTE: All path removals are dispatched to a fixed set of executors
+  // so that:
+  //   1. They do not block other dispatches (MESOS-6549).
+  //   2. They do not occupy all worker threads (MESOS-7964).
+  // Each executor removes a single path at a time, so that a large
+  // path only holds up the executor deleting it, and picks up the next
+  // queued path once it is done, regardless of when that path's
+  // removal time came up.
+  while (!idle.empty() && !queue.empty()) {
+    const size_t executor = idle.back();
+    idle.pop_back();
+
+    const Owned<PathInfo> info = queue.front();
+    queue.pop_front();
+
     Counter _succeeded = metrics.path_removals_succeeded;
     Counter _failed = metrics.path_removals_failed;
+    Counter _bytes = metrics.bytes_reclaimed;
+    Counter _inodes = metrics.inodes_reclaimed;
 
-    auto rmdirs = [_succeeded, _failed, infos]() {
+    auto rmdir = [_succeeded, _failed, _bytes, _inodes, info]() {
       // Make mutable copies of the counters to work around MESOS-7907.
       Counter succeeded = _succeeded;
       Counter failed = _failed;
-
-      foreach (const Owned<PathInfo>& info, infos) {
-        // Run the removal operation with 'continueOnError = true'.
-        // It's possible for tasks and isolators to lay down files
-        // that are not deletable by GC. In the face of such errors
-        // GC needs to free up disk space wherever it can because the
-        // disk space has already been re-offered to frameworks.
-        LOG(INFO) << "Deleting " << info->path;
-        Try<Nothing> rmdir = os::rmdir(info->path, true, true, true);
-
-        if (rmdir.isError()) {
-          LOG(WARNING) << "Failed to delete '" << info->path << "': "
-                       << rmdir.error();
-          info->promise.fail(rmdir.error());
-
-          ++failed;
-        } else {
-          LOG(INFO) << "Deleted '" << info->path << "'";
-          info->promise.set(rmdir.get());
-
-          ++succeeded;
-        }
+      Counter bytes = _bytes;
+      Counter inodes = _inodes;
+
+#ifdef __linux__
+      ioprio::LowIOPriority priority;
+#endif // __linux__
+
+      // Run the removal operation with 'continueOnError = true'.
+      // It's possible for tasks and isolators to lay down files
+      // that are not deletable by GC. In the face of such errors
+      // GC needs to free up disk space wherever it can because the
+      // disk space has already been re-offered to frameworks.
+      LOG(INFO) << "Deleting " << info->path;
+
+      Reclaimed reclaimed;
+#ifndef __WINDOWS__
+      // Account for the disk space and inodes that are freed. Files
+      // with other hard links outside of the directory do not free
+      // anything and are thus not accounted for.
+      Try<Nothing> rmdir = os::rmdir(
+          info->path,
+          true,
+          true,
+          true,
+          [&reclaimed](const string& path, const struct stat& s) {
+            if (S_ISDIR(s.st_mode) || s.st_nlink <= 1) {
+              reclaimed.bytes += s.st_blocks * 512;
+              reclaimed.inodes++;
+            }
+          });
+#else
+      Try<Nothing> rmdir = os::rmdir(info->path, true, true, true);
+#endif // __WINDOWS__
+
+      bytes += reclaimed.bytes;
+      inodes += reclaimed.inodes;
+
+      if (rmdir.isError()) {
+        LOG(WARNING) << "Failed to delete '" << info->path << "': "
+                     << rmdir.error();
+        info->promise.fail(rmdir.error());
+
+        ++failed;
+      } else {
+        LOG(INFO) << "Deleted '" << info->path << "' ("
+                  << Bytes(reclaimed.bytes) << " in "
+                  << reclaimed.inodes << " inodes)";
+        info->promise.set(rmdir.get());
+
+        ++succeeded;
       }
 
       return Nothing();
     };
 
-    // NOTE: All `rmdirs` calls are dispatched to one executor so that:
-    //   1. They do not block other dispatches (MESOS-6549).
-    //   2. They do not occupy all worker threads (MESOS-7964).
-    executor.execute(rmdirs)
-      .onAny(defer(self(), &Self::_remove, lambda::_1, infos));
-  } else {
-    // This occurs when either:
-    //   1. The path(s) has already been removed (e.g. by prune()).
-    //   2. All paths under the removal time were unscheduled.
-    LOG(INFO) << "Ignoring gc event at " << removalTime.remaining()
-              << " as the paths were already removed, or were unscheduled";
-    reset();
+    executors[executor]->execute(rmdir)
+      .onAny(defer(self(), &Self::_remove, lambda::_1, executor, info));
   }
 }
 
 
-void  GarbageCollectorProcess::_remove(const Future<Nothing>& result,
-                                       const list<Owned<PathInfo>> infos)
+void GarbageCollectorProcess::_remove(
+    const Future<Nothing>& result,
+    size_t executor,
+    const Owned<PathInfo>& info)
 {
   CHECK_READY(result);
 
-  // Remove path records from `paths` and `timeouts` data structures.
-  foreach (const Owned<PathInfo>& info, infos) {
-    CHECK(paths.remove(timeouts[info->path], info));
-    CHECK_EQ(timeouts.erase(info->path), 1u);
-  }
+  // Remove the path record from `paths` and `timeouts` data structures.
+  CHECK(paths.remove(timeouts[info->path], info));
+  CHECK_EQ(timeouts.erase(info->path), 1u);
 
-  reset();
+  idle.push_back(executor);
+
+  removeQueued();
 }
 
 
@@ -268,9 +362,9 @@ void GarbageCollectorProcess::prune(const Duration& d)
 }
 
 
-GarbageCollector::GarbageCollector()
+GarbageCollector::GarbageCollector(size_t parallelism)
 {
-  process = new GarbageCollectorProcess();
+  process = new GarbageCollectorProcess(parallelism);
   spawn(process);
 }
 
@@ -42,7 +42,8 @@ class GarbageCollectorProcess;
 class GarbageCollector
 {
 public:
-  GarbageCollector();
+  // Up to 'parallelism' paths are deleted concurrently.
+  explicit GarbageCollector(size_t parallelism = 1);
   virtual ~GarbageCollector();
 
   // Schedules the specified path for removal after the specified
@@ -17,8 +17,9 @@
 #ifndef __SLAVE_GC_PROCESS_HPP__
 #define __SLAVE_GC_PROCESS_HPP__
 
-#include <list>
+#include <deque>
 #include <string>
+#include <vector>
 
 #include <process/executor.hpp>
 #include <process/future.hpp>
@@ -45,9 +46,7 @@ class GarbageCollectorProcess :
     public process::Process<GarbageCollectorProcess>
 {
 public:
-  GarbageCollectorProcess()
-    : ProcessBase(process::ID::generate("agent-garbage-collector")),
-      metrics(this) {}
+  explicit GarbageCollectorProcess(size_t parallelism = 1);
 
   virtual ~GarbageCollectorProcess();
 
@@ -82,10 +81,14 @@ private:
     bool removing = false;
   };
 
-  // Callback for `remove` for bookkeeping after path removal.
+  // Hands out the queued paths to the idle executors.
+  void removeQueued();
+
+  // Callback for `removeQueued` for bookkeeping after path removal.
   void _remove(
       const process::Future<Nothing>& result,
-      const std::list<process::Owned<PathInfo>> infos);
+      size_t executor,
+      const process::Owned<PathInfo>& info);
 
   struct Metrics
   {
@@ -95,6 +98,11 @@ private:
     process::metrics::Counter path_removals_succeeded;
     process::metrics::Counter path_removals_failed;
     process::metrics::Gauge path_removals_pending;
+
+    // The disk space and inodes freed by path removals, from which
+    // the reclamation rates can be derived.
+    process::metrics::Counter bytes_reclaimed;
+    process::metrics::Counter inodes_reclaimed;
   } metrics;
 
   // Store all the timeouts and corresponding paths to delete.
@@ -108,8 +116,17 @@ private:
 
   process::Timer timer;
 
-  // For executing path removals in a separate actor.
-  process::Executor executor;
+  // For executing path removals in separate actors. The paths due for
+  // removal are spread across these executors so that up to
+  // `--gc_parallelism` paths are deleted concurrently.
+  std::vector<process::Owned<process::Executor>> executors;
+
+  // The paths due for removal which wait for an idle executor, shared
+  // across removal times.
+  std::deque<process::Owned<PathInfo>> queue;
+
+  // The indices of the executors which are not removing a path.
+  std::vector<size_t> idle;
 };
 
 } // namespace slave {
@@ -1307,12 +1307,23 @@ Future<Response> Http::state(
       rolesApprover)
     .then(defer(
         slave->self(),
-        [this, request](const tuple<Owned<ObjectApprover>,
-                                    Owned<ObjectApprover>,
-                                    Owned<ObjectApprover>,
-                                    Owned<ObjectApprover>,
-                                    Owned<ObjectApprover>>& approvers)
-          -> Response {
+        [this, request, principal](
+            const tuple<Owned<ObjectApprover>,
+                        Owned<ObjectApprover>,
+                        Owned<ObjectApprover>,
+                        Owned<ObjectApprover>,
+                        Owned<ObjectApprover>>& approvers) -> Response {
+      slave->readOnly();
+
+      // Serve the cached response if the agent's state has not
+      // changed since it was computed.
+      Option<Response> cached =
+        stateCache.get(request, principal, slave->stateGeneration);
+
+      if (cached.isSome()) {
+        return cached.get();
+      }
+
       // This lambda is consumed before the outer lambda
       // returns, hence capture by reference is fine here.
       auto state = [this, &approvers](JSON::ObjectWriter* writer) {
@@ -1497,7 +1508,11 @@ Future<Response> Http::state(
         });
       };
 
-      return OK(jsonify(state), request.url.query.get("jsonp"));
+      return stateCache.put(
+          request,
+          principal,
+          slave->stateGeneration,
+          OK(jsonify(state), request.url.query.get("jsonp")));
     }));
 }
 
@@ -2310,7 +2325,7 @@ Future<JSON::Array> Http::__containers(
 
           metadata->push_back(entry);
           statusFutures.push_back(slave->containerizer->status(containerId));
-          statsFutures.push_back(slave->containerizer->usage(containerId));
+          statsFutures.push_back(slave->containerUsage(containerId));
         }
       }
 
@@ -325,6 +325,9 @@ private:
 
   // Used to rate limit the statistics endpoint.
   process::Shared<process::RateLimiter> statisticsLimiter;
+
+  // Cached responses of `/state`, see `ResponseCache`.
+  mutable ResponseCache stateCache;
 };
 
 } // namespace slave {
@@ -35,27 +35,27 @@ using process::metrics::Gauge;
 Metrics::Metrics(const Slave& slave)
   : uptime_secs(
         "slave/uptime_secs",
-        defer(slave, &Slave::_uptime_secs)),
+        defer(slave, &Slave::gauge, &Slave::_uptime_secs)),
     registered(
         "slave/registered",
-        defer(slave, &Slave::_registered)),
+        defer(slave, &Slave::gauge, &Slave::_registered)),
     recovery_errors(
         "slave/recovery_errors"),
     frameworks_active(
         "slave/frameworks_active",
-        defer(slave, &Slave::_frameworks_active)),
+        defer(slave, &Slave::gauge, &Slave::_frameworks_active)),
     tasks_staging(
         "slave/tasks_staging",
-        defer(slave, &Slave::_tasks_staging)),
+        defer(slave, &Slave::gauge, &Slave::_tasks_staging)),
     tasks_starting(
         "slave/tasks_starting",
-        defer(slave, &Slave::_tasks_starting)),
+        defer(slave, &Slave::gauge, &Slave::_tasks_starting)),
     tasks_running(
         "slave/tasks_running",
-        defer(slave, &Slave::_tasks_running)),
+        defer(slave, &Slave::gauge, &Slave::_tasks_running)),
     tasks_killing(
         "slave/tasks_killing",
-        defer(slave, &Slave::_tasks_killing)),
+        defer(slave, &Slave::gauge, &Slave::_tasks_killing)),
     tasks_finished(
         "slave/tasks_finished"),
     tasks_failed(
@@ -68,13 +68,13 @@ Metrics::Metrics(const Slave& slave)
         "slave/tasks_gone"),
     executors_registering(
         "slave/executors_registering",
-        defer(slave, &Slave::_executors_registering)),
+        defer(slave, &Slave::gauge, &Slave::_executors_registering)),
     executors_running(
         "slave/executors_running",
-        defer(slave, &Slave::_executors_running)),
+        defer(slave, &Slave::gauge, &Slave::_executors_running)),
     executors_terminating(
         "slave/executors_terminating",
-        defer(slave, &Slave::_executors_terminating)),
+        defer(slave, &Slave::gauge, &Slave::_executors_terminating)),
     executors_terminated(
         "slave/executors_terminated"),
     executors_preempted(
@@ -89,9 +89,14 @@ Metrics::Metrics(const Slave& slave)
         "slave/invalid_framework_messages"),
     executor_directory_max_allowed_age_secs(
         "slave/executor_directory_max_allowed_age_secs",
-        defer(slave, &Slave::_executor_directory_max_allowed_age_secs)),
+        defer(
+            slave,
+            &Slave::gauge,
+            &Slave::_executor_directory_max_allowed_age_secs)),
     container_launch_errors(
-        "slave/container_launch_errors")
+        "slave/container_launch_errors"),
+    http_api_latency(
+        "slave/http_api_latency_ms")
 {
   // TODO(dhamon): Check return values for metric registration.
   process::metrics::add(uptime_secs);
@@ -127,6 +132,8 @@ Metrics::Metrics(const Slave& slave)
 
   process::metrics::add(container_launch_errors);
 
+  process::metrics::add(http_api_latency);
+
   // Create resource gauges.
   // TODO(dhamon): Set these up dynamically when creating a slave
   // based on the resources it exposes.
@@ -135,15 +142,27 @@ Metrics::Metrics(const Slave& slave)
   foreach (const string& resource, resources) {
     Gauge total(
         "slave/" + resource + "_total",
-        defer(slave, &Slave::_resources_total, resource));
+        defer(
+            slave,
+            &Slave::resourceGauge,
+            &Slave::_resources_total,
+            resource));
 
     Gauge used(
         "slave/" + resource + "_used",
-        defer(slave, &Slave::_resources_used, resource));
+        defer(
+            slave,
+            &Slave::resourceGauge,
+            &Slave::_resources_used,
+            resource));
 
     Gauge percent(
         "slave/" + resource + "_percent",
-        defer(slave, &Slave::_resources_percent, resource));
+        defer(
+            slave,
+            &Slave::resourceGauge,
+            &Slave::_resources_percent,
+            resource));
 
     resources_total.push_back(total);
     resources_used.push_back(used);
@@ -157,15 +176,27 @@ Metrics::Metrics(const Slave& slave)
   foreach (const string& resource, resources) {
     Gauge total(
         "slave/" + resource + "_revocable_total",
-        defer(slave, &Slave::_resources_revocable_total, resource));
+        defer(
+            slave,
+            &Slave::resourceGauge,
+            &Slave::_resources_revocable_total,
+            resource));
 
     Gauge used(
         "slave/" + resource + "_revocable_used",
-        defer(slave, &Slave::_resources_revocable_used, resource));
+        defer(
+            slave,
+            &Slave::resourceGauge,
+            &Slave::_resources_revocable_used,
+            resource));
 
     Gauge percent(
         "slave/" + resource + "_revocable_percent",
-        defer(slave, &Slave::_resources_revocable_percent, resource));
+        defer(
+            slave,
+            &Slave::resourceGauge,
+            &Slave::_resources_revocable_percent,
+            resource));
 
     resources_revocable_total.push_back(total);
     resources_revocable_used.push_back(used);
@@ -214,6 +245,8 @@ Metrics::~Metrics()
 
   process::metrics::remove(container_launch_errors);
 
+  process::metrics::remove(http_api_latency);
+
   foreach (const Gauge& gauge, resources_total) {
     process::metrics::remove(gauge);
   }
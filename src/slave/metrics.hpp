@@ -21,6 +21,7 @@
 
 #include <process/metrics/counter.hpp>
 #include <process/metrics/gauge.hpp>
+#include <process/metrics/histogram.hpp>
 
 
 namespace mesos {
@@ -68,6 +69,9 @@ struct Metrics
 
   process::metrics::Counter container_launch_errors;
 
+  // Latency of the calls to the v1 executor and operator APIs.
+  process::metrics::Histogram http_api_latency;
+
   // Non-revocable resources.
   std::vector<process::metrics::Gauge> resources_total;
   std::vector<process::metrics::Gauge> resources_used;
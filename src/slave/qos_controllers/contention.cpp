@@ -0,0 +1,344 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <list>
+#include <utility>
+
+#include <mesos/resources.hpp>
+#include <mesos/type_utils.hpp>
+
+#include <mesos/module/qos_controller.hpp>
+
+#include <mesos/slave/qos_controller.hpp>
+
+#include <process/defer.hpp>
+#include <process/dispatch.hpp>
+#include <process/id.hpp>
+#include <process/owned.hpp>
+#include <process/process.hpp>
+
+#include <stout/foreach.hpp>
+#include <stout/hashmap.hpp>
+#include <stout/lambda.hpp>
+#include <stout/numify.hpp>
+#include <stout/option.hpp>
+
+#include "slave/qos_controllers/contention.hpp"
+
+using namespace mesos;
+using namespace process;
+
+using std::list;
+using std::pair;
+
+using mesos::modules::Module;
+
+using mesos::slave::QoSController;
+using mesos::slave::QoSCorrection;
+
+namespace mesos {
+namespace internal {
+namespace slave {
+
+
+class ContentionQoSControllerProcess
+  : public Process<ContentionQoSControllerProcess>
+{
+public:
+  ContentionQoSControllerProcess(
+      const lambda::function<Future<ResourceUsage>()>& _usage,
+      const Option<double>& _cpuPressureThreshold,
+      const Option<double>& _memoryPressureThreshold,
+      const Option<double>& _throttledRatioThreshold)
+    : ProcessBase(process::ID::generate("qos-contention-controller")),
+      usage(_usage),
+      cpuPressureThreshold(_cpuPressureThreshold),
+      memoryPressureThreshold(_memoryPressureThreshold),
+      throttledRatioThreshold(_throttledRatioThreshold) {}
+
+  Future<list<QoSCorrection>> corrections()
+  {
+    return usage().then(defer(self(), &Self::_corrections, lambda::_1));
+  }
+
+  Future<list<QoSCorrection>> _corrections(const ResourceUsage& usage)
+  {
+    bool cpuContention = false;
+    bool memoryContention = false;
+
+    foreach (const ResourceUsage::Executor& executor, usage.executors()) {
+      if (!executor.has_statistics() ||
+          !Resources(executor.allocated()).revocable().empty()) {
+        continue;
+      }
+
+      const ResourceStatistics& statistics = executor.statistics();
+      const ExecutorID& executorId = executor.executor_info().executor_id();
+
+      if (cpuPressureThreshold.isSome() &&
+          statistics.has_cpus_pressure_some_avg10() &&
+          statistics.cpus_pressure_some_avg10() > cpuPressureThreshold.get()) {
+        LOG(INFO) << "Cpu pressure " << statistics.cpus_pressure_some_avg10()
+                  << "% of executor '" << executorId << "'"
+                  << " exceeds threshold " << cpuPressureThreshold.get();
+        cpuContention = true;
+      }
+
+      if (memoryPressureThreshold.isSome() &&
+          statistics.has_mem_pressure_some_avg10() &&
+          statistics.mem_pressure_some_avg10() >
+            memoryPressureThreshold.get()) {
+        LOG(INFO) << "Memory pressure " << statistics.mem_pressure_some_avg10()
+                  << "% of executor '" << executorId << "'"
+                  << " exceeds threshold " << memoryPressureThreshold.get();
+        memoryContention = true;
+      }
+
+      Option<double> ratio = throttledRatio(executor);
+      if (throttledRatioThreshold.isSome() &&
+          ratio.isSome() &&
+          ratio.get() > throttledRatioThreshold.get()) {
+        LOG(INFO) << "Executor '" << executorId << "' was throttled in "
+                  << ratio.get() * 100 << "% of the cpu periods, exceeding"
+                  << " threshold " << throttledRatioThreshold.get();
+        cpuContention = true;
+      }
+    }
+
+    // Pick the revocable executor which uses the most of the contended
+    // resource. Memory contention takes precedence, since evicting a
+    // cpu-heavy executor does not relieve it.
+    Option<ResourceUsage::Executor> victim;
+    Option<double> victimScore;
+
+    if (cpuContention || memoryContention) {
+      foreach (const ResourceUsage::Executor& executor, usage.executors()) {
+        if (!executor.has_statistics() ||
+            Resources(executor.allocated()).revocable().empty()) {
+          continue;
+        }
+
+        Option<double> score = memoryContention
+          ? memoryUsage(executor)
+          : cpuUsage(executor);
+
+        if (score.isSome() &&
+            (victimScore.isNone() || score.get() > victimScore.get())) {
+          victim = executor;
+          victimScore = score;
+        }
+      }
+    }
+
+    // Remember the statistics of the running executors to compute the
+    // cpu usage and throttling over the next correction interval.
+    samples.clear();
+    foreach (const ResourceUsage::Executor& executor, usage.executors()) {
+      if (executor.has_statistics()) {
+        samples[key(executor)] = executor.statistics();
+      }
+    }
+
+    if (victim.isNone()) {
+      return list<QoSCorrection>();
+    }
+
+    LOG(INFO) << "Evicting revocable executor '"
+              << victim->executor_info().executor_id() << "' of framework "
+              << victim->executor_info().framework_id() << " to relieve "
+              << (memoryContention ? "memory" : "cpu") << " contention";
+
+    QoSCorrection correction;
+
+    correction.set_type(mesos::slave::QoSCorrection_Type_KILL);
+    correction.mutable_kill()->mutable_framework_id()->CopyFrom(
+        victim->executor_info().framework_id());
+    correction.mutable_kill()->mutable_executor_id()->CopyFrom(
+        victim->executor_info().executor_id());
+
+    return list<QoSCorrection>({correction});
+  }
+
+private:
+  typedef pair<FrameworkID, ExecutorID> Key;
+
+  static Key key(const ResourceUsage::Executor& executor)
+  {
+    return Key(
+        executor.executor_info().framework_id(),
+        executor.executor_info().executor_id());
+  }
+
+  // Returns the fraction of CFS periods in which the executor was
+  // throttled since the previous correction, if known.
+  Option<double> throttledRatio(const ResourceUsage::Executor& executor)
+  {
+    const ResourceStatistics& current = executor.statistics();
+
+    Option<ResourceStatistics> previous = samples.get(key(executor));
+    if (previous.isNone() ||
+        !current.has_cpus_nr_periods() ||
+        !current.has_cpus_nr_throttled() ||
+        !previous->has_cpus_nr_periods() ||
+        !previous->has_cpus_nr_throttled() ||
+        current.cpus_nr_periods() <= previous->cpus_nr_periods() ||
+        current.cpus_nr_throttled() < previous->cpus_nr_throttled()) {
+      return None();
+    }
+
+    return
+      static_cast<double>(
+          current.cpus_nr_throttled() - previous->cpus_nr_throttled()) /
+      static_cast<double>(
+          current.cpus_nr_periods() - previous->cpus_nr_periods());
+  }
+
+  // Returns the cpus used by the executor since the previous
+  // correction, if known.
+  Option<double> cpuUsage(const ResourceUsage::Executor& executor)
+  {
+    const ResourceStatistics& current = executor.statistics();
+
+    Option<ResourceStatistics> previous = samples.get(key(executor));
+    if (previous.isNone() ||
+        current.timestamp() <= previous->timestamp()) {
+      return None();
+    }
+
+    double time =
+      (current.cpus_user_time_secs() + current.cpus_system_time_secs()) -
+      (previous->cpus_user_time_secs() + previous->cpus_system_time_secs());
+
+    return time / (current.timestamp() - previous->timestamp());
+  }
+
+  static Option<double> memoryUsage(const ResourceUsage::Executor& executor)
+  {
+    const ResourceStatistics& statistics = executor.statistics();
+
+    if (statistics.has_mem_total_bytes()) {
+      return static_cast<double>(statistics.mem_total_bytes());
+    } else if (statistics.has_mem_rss_bytes()) {
+      return static_cast<double>(statistics.mem_rss_bytes());
+    }
+
+    return None();
+  }
+
+  const lambda::function<Future<ResourceUsage>()> usage;
+  const Option<double> cpuPressureThreshold;
+  const Option<double> memoryPressureThreshold;
+  const Option<double> throttledRatioThreshold;
+
+  // Statistics of each executor at the previous correction.
+  hashmap<Key, ResourceStatistics> samples;
+};
+
+
+ContentionQoSController::~ContentionQoSController()
+{
+  if (process.get() != nullptr) {
+    terminate(process.get());
+    wait(process.get());
+  }
+}
+
+
+Try<Nothing> ContentionQoSController::initialize(
+  const lambda::function<Future<ResourceUsage>()>& usage)
+{
+  if (process.get() != nullptr) {
+    return Error("Contention QoS Controller has already been initialized");
+  }
+
+  process.reset(
+      new ContentionQoSControllerProcess(
+          usage,
+          cpuPressureThreshold,
+          memoryPressureThreshold,
+          throttledRatioThreshold));
+
+  spawn(process.get());
+
+  return Nothing();
+}
+
+
+process::Future<list<QoSCorrection>> ContentionQoSController::corrections()
+{
+  if (process.get() == nullptr) {
+    return Failure("Contention QoS Controller is not initialized");
+  }
+
+  return dispatch(
+      process.get(),
+      &ContentionQoSControllerProcess::corrections);
+}
+
+} // namespace slave {
+} // namespace internal {
+} // namespace mesos {
+
+
+static QoSController* create(const Parameters& parameters)
+{
+  Option<double> cpuPressureThreshold = None();
+  Option<double> memoryPressureThreshold = None();
+  Option<double> throttledRatioThreshold = None();
+
+  foreach (const Parameter& parameter, parameters.parameter()) {
+    Option<double>* threshold = nullptr;
+
+    if (parameter.key() == "cpu_pressure_threshold") {
+      threshold = &cpuPressureThreshold;
+    } else if (parameter.key() == "memory_pressure_threshold") {
+      threshold = &memoryPressureThreshold;
+    } else if (parameter.key() == "throttled_ratio_threshold") {
+      threshold = &throttledRatioThreshold;
+    } else {
+      continue;
+    }
+
+    Try<double> thresholdParam = numify<double>(parameter.value());
+    if (thresholdParam.isError()) {
+      LOG(ERROR) << "Failed to parse '" << parameter.key() << "': "
+                 << thresholdParam.error();
+      return nullptr;
+    }
+
+    *threshold = thresholdParam.get();
+  }
+
+  if (cpuPressureThreshold.isNone() &&
+      memoryPressureThreshold.isNone() &&
+      throttledRatioThreshold.isNone()) {
+    LOG(ERROR) << "No thresholds are configured for ContentionQoSController";
+    return nullptr;
+  }
+
+  return new mesos::internal::slave::ContentionQoSController(
+      cpuPressureThreshold, memoryPressureThreshold, throttledRatioThreshold);
+}
+
+
+Module<QoSController> org_apache_mesos_ContentionQoSController(
+    MESOS_MODULE_API_VERSION,
+    MESOS_VERSION,
+    "Apache Mesos",
+    "modules@mesos.apache.org",
+    "Resource Contention QoS Controller Module.",
+    nullptr,
+    create);
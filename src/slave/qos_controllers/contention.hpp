@@ -0,0 +1,81 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __SLAVE_QOS_CONTROLLERS_CONTENTION_HPP__
+#define __SLAVE_QOS_CONTROLLERS_CONTENTION_HPP__
+
+#include <list>
+
+#include <mesos/slave/qos_controller.hpp>
+
+#include <stout/lambda.hpp>
+#include <stout/option.hpp>
+#include <stout/try.hpp>
+
+#include <process/future.hpp>
+#include <process/owned.hpp>
+
+namespace mesos {
+namespace internal {
+namespace slave {
+
+// Forward declaration.
+class ContentionQoSControllerProcess;
+
+
+// The `ContentionQoSController` evicts revocable executors when the
+// non-revocable (i.e. latency-sensitive) executors on the agent show
+// signs of resource contention in their usage statistics:
+//
+//   - cpu or memory pressure stall information (PSI) above the
+//     configured percentage of wall time, on kernels which report it;
+//   - the fraction of CFS periods in which the executor was throttled
+//     since the previous correction above the configured ratio.
+//
+// Rather than evicting all revocable executors, only the single
+// revocable executor which uses the most of the contended resource
+// is evicted in each correction round; subsequent rounds re-evaluate
+// whether the contention persists.
+class ContentionQoSController : public mesos::slave::QoSController
+{
+public:
+  ContentionQoSController(
+      const Option<double>& _cpuPressureThreshold,
+      const Option<double>& _memoryPressureThreshold,
+      const Option<double>& _throttledRatioThreshold)
+    : cpuPressureThreshold(_cpuPressureThreshold),
+      memoryPressureThreshold(_memoryPressureThreshold),
+      throttledRatioThreshold(_throttledRatioThreshold) {}
+
+  virtual ~ContentionQoSController();
+
+  virtual Try<Nothing> initialize(
+    const lambda::function<process::Future<ResourceUsage>()>& usage);
+
+  virtual process::Future<std::list<mesos::slave::QoSCorrection>> corrections();
+
+private:
+  const Option<double> cpuPressureThreshold;
+  const Option<double> memoryPressureThreshold;
+  const Option<double> throttledRatioThreshold;
+  process::Owned<ContentionQoSControllerProcess> process;
+};
+
+} // namespace slave {
+} // namespace internal {
+} // namespace mesos {
+
+#endif // __SLAVE_QOS_CONTROLLERS_CONTENTION_HPP__
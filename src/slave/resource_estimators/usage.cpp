@@ -0,0 +1,309 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <boost/circular_buffer.hpp>
+
+#include <mesos/resources.hpp>
+#include <mesos/type_utils.hpp>
+
+#include <mesos/module/resource_estimator.hpp>
+
+#include <mesos/slave/resource_estimator.hpp>
+
+#include <process/defer.hpp>
+#include <process/dispatch.hpp>
+#include <process/id.hpp>
+#include <process/owned.hpp>
+#include <process/process.hpp>
+
+#include <stout/bytes.hpp>
+#include <stout/foreach.hpp>
+#include <stout/hashmap.hpp>
+#include <stout/hashset.hpp>
+#include <stout/lambda.hpp>
+#include <stout/numify.hpp>
+#include <stout/option.hpp>
+#include <stout/stringify.hpp>
+
+#include "slave/resource_estimators/usage.hpp"
+
+using namespace mesos;
+using namespace process;
+
+using std::pair;
+using std::vector;
+
+using mesos::modules::Module;
+
+using mesos::slave::ResourceEstimator;
+
+namespace mesos {
+namespace internal {
+namespace slave {
+
+
+class UsageResourceEstimatorProcess
+  : public Process<UsageResourceEstimatorProcess>
+{
+public:
+  UsageResourceEstimatorProcess(
+      const lambda::function<Future<ResourceUsage>()>& _usage,
+      size_t _window,
+      double _percentile)
+    : ProcessBase(process::ID::generate("usage-resource-estimator")),
+      usage(_usage),
+      window(_window),
+      percentile(_percentile) {}
+
+  Future<Resources> oversubscribable()
+  {
+    return usage().then(defer(self(), &Self::_oversubscribable, lambda::_1));
+  }
+
+  Future<Resources> _oversubscribable(const ResourceUsage& usage)
+  {
+    double cpus = 0.0;
+    double mem = 0.0; // In bytes.
+
+    Resources allocatedRevocable;
+    hashset<Key> running;
+
+    foreach (const ResourceUsage::Executor& executor, usage.executors()) {
+      const Resources allocated = executor.allocated();
+
+      // Revocable executors consume the oversubscribed resources,
+      // so their usage is not considered for the estimate.
+      if (!allocated.revocable().empty()) {
+        allocatedRevocable += allocated.revocable();
+        continue;
+      }
+
+      if (!executor.has_statistics()) {
+        continue;
+      }
+
+      const Key key(
+          executor.executor_info().framework_id(),
+          executor.executor_info().executor_id());
+
+      running.insert(key);
+
+      if (!histories.contains(key)) {
+        histories.put(key, History(window));
+      }
+
+      History& history = histories.at(key);
+      const ResourceStatistics& statistics = executor.statistics();
+
+      // The cpu usage is only known if both samples include the cpu
+      // times, e.g., the cpuacct subsystem might not be enabled.
+      Option<double> allocatedCpus = allocated.cpus();
+      if (allocatedCpus.isSome() &&
+          statistics.has_cpus_user_time_secs() &&
+          statistics.has_cpus_system_time_secs() &&
+          history.previous.isSome() &&
+          history.previous->has_cpus_user_time_secs() &&
+          history.previous->has_cpus_system_time_secs() &&
+          statistics.timestamp() > history.previous->timestamp()) {
+        double used =
+          ((statistics.cpus_user_time_secs() +
+            statistics.cpus_system_time_secs()) -
+           (history.previous->cpus_user_time_secs() +
+            history.previous->cpus_system_time_secs())) /
+          (statistics.timestamp() - history.previous->timestamp());
+
+        history.cpus.push_back(std::max(0.0, allocatedCpus.get() - used));
+      }
+
+      Option<Bytes> allocatedMem = allocated.mem();
+      if (allocatedMem.isSome() && statistics.has_mem_total_bytes()) {
+        history.mem.push_back(std::max(
+            0.0,
+            static_cast<double>(allocatedMem->bytes()) -
+            static_cast<double>(statistics.mem_total_bytes())));
+      }
+
+      history.previous = statistics;
+
+      if (history.cpus.full()) {
+        cpus += estimate(history.cpus);
+      }
+
+      if (history.mem.full()) {
+        mem += estimate(history.mem);
+      }
+    }
+
+    // Drop the history of executors which have terminated.
+    foreach (const Key& key, histories.keys()) {
+      if (!running.contains(key)) {
+        histories.erase(key);
+      }
+    }
+
+    cpus -= allocatedRevocable.cpus().getOrElse(0.0);
+    mem -= static_cast<double>(
+        allocatedRevocable.mem().getOrElse(Bytes(0)).bytes());
+
+    Resources oversubscribable;
+
+    if (cpus > 0.0) {
+      oversubscribable += revocable("cpus", cpus);
+    }
+
+    if (mem >= static_cast<double>(Bytes::MEGABYTES)) {
+      oversubscribable +=
+        revocable("mem", mem / static_cast<double>(Bytes::MEGABYTES));
+    }
+
+    return oversubscribable;
+  }
+
+private:
+  typedef pair<FrameworkID, ExecutorID> Key;
+
+  // The allocated minus used resources of an executor over the last
+  // `window` samples.
+  struct History
+  {
+    explicit History(size_t window)
+      : cpus(window),
+        mem(window) {}
+
+    Option<ResourceStatistics> previous;
+    boost::circular_buffer<double> cpus;
+    boost::circular_buffer<double> mem;
+  };
+
+  // Returns the configured percentile of the samples.
+  double estimate(const boost::circular_buffer<double>& samples) const
+  {
+    vector<double> sorted(samples.begin(), samples.end());
+    std::sort(sorted.begin(), sorted.end());
+
+    size_t index = static_cast<size_t>(
+        (percentile / 100.0) * static_cast<double>(sorted.size() - 1));
+
+    return sorted[index];
+  }
+
+  static Resource revocable(const std::string& name, double value)
+  {
+    Resource resource = Resources::parse(name, stringify(value), "*").get();
+    resource.mutable_revocable();
+    return resource;
+  }
+
+  const lambda::function<Future<ResourceUsage>()> usage;
+  const size_t window;
+  const double percentile;
+
+  hashmap<Key, History> histories;
+};
+
+
+UsageResourceEstimator::~UsageResourceEstimator()
+{
+  if (process.get() != nullptr) {
+    terminate(process.get());
+    wait(process.get());
+  }
+}
+
+
+Try<Nothing> UsageResourceEstimator::initialize(
+    const lambda::function<Future<ResourceUsage>()>& usage)
+{
+  if (process.get() != nullptr) {
+    return Error("Usage resource estimator has already been initialized");
+  }
+
+  process.reset(new UsageResourceEstimatorProcess(usage, window, percentile));
+  spawn(process.get());
+
+  return Nothing();
+}
+
+
+Future<Resources> UsageResourceEstimator::oversubscribable()
+{
+  if (process.get() == nullptr) {
+    return Failure("Usage resource estimator is not initialized");
+  }
+
+  return dispatch(
+      process.get(),
+      &UsageResourceEstimatorProcess::oversubscribable);
+}
+
+} // namespace slave {
+} // namespace internal {
+} // namespace mesos {
+
+
+static bool compatible()
+{
+  return true;
+}
+
+
+static ResourceEstimator* create(const Parameters& parameters)
+{
+  // By default, consider the 5th percentile of the unused resources
+  // over the last 60 samples (i.e. 15 minutes with the default
+  // `--oversubscribed_resources_interval`) to be oversubscribable.
+  size_t window = 60;
+  double percentile = 5;
+
+  foreach (const Parameter& parameter, parameters.parameter()) {
+    if (parameter.key() == "window") {
+      Try<size_t> _window = numify<size_t>(parameter.value());
+      if (_window.isError() || _window.get() == 0) {
+        LOG(ERROR) << "Invalid window '" << parameter.value() << "'";
+        return nullptr;
+      }
+
+      window = _window.get();
+    } else if (parameter.key() == "percentile") {
+      Try<double> _percentile = numify<double>(parameter.value());
+      if (_percentile.isError() ||
+          _percentile.get() < 0 ||
+          _percentile.get() > 100) {
+        LOG(ERROR) << "Invalid percentile '" << parameter.value() << "'";
+        return nullptr;
+      }
+
+      percentile = _percentile.get();
+    }
+  }
+
+  return new mesos::internal::slave::UsageResourceEstimator(
+      window, percentile);
+}
+
+
+Module<ResourceEstimator> org_apache_mesos_UsageResourceEstimator(
+    MESOS_MODULE_API_VERSION,
+    MESOS_VERSION,
+    "Apache Mesos",
+    "modules@mesos.apache.org",
+    "Usage History Resource Estimator Module.",
+    compatible,
+    create);
@@ -0,0 +1,72 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __SLAVE_RESOURCE_ESTIMATORS_USAGE_HPP__
+#define __SLAVE_RESOURCE_ESTIMATORS_USAGE_HPP__
+
+#include <mesos/resources.hpp>
+
+#include <mesos/slave/resource_estimator.hpp>
+
+#include <stout/lambda.hpp>
+#include <stout/try.hpp>
+
+#include <process/future.hpp>
+#include <process/owned.hpp>
+
+namespace mesos {
+namespace internal {
+namespace slave {
+
+// Forward declaration.
+class UsageResourceEstimatorProcess;
+
+
+// The `UsageResourceEstimator` estimates the resources which can be
+// oversubscribed from the usage history of the non-revocable
+// executors on the agent. For each executor it keeps the last
+// `window` samples of its allocated minus used cpus and memory, and
+// considers the given (low) percentile of those samples to be safely
+// unused. The sum of these estimates, less the revocable resources
+// already allocated, is reported as oversubscribable.
+//
+// An executor only contributes once it has a full window of samples,
+// so that short-lived idle periods are not oversubscribed.
+class UsageResourceEstimator : public mesos::slave::ResourceEstimator
+{
+public:
+  UsageResourceEstimator(size_t _window, double _percentile)
+    : window(_window),
+      percentile(_percentile) {}
+
+  virtual ~UsageResourceEstimator();
+
+  virtual Try<Nothing> initialize(
+      const lambda::function<process::Future<ResourceUsage>()>& usage);
+
+  virtual process::Future<Resources> oversubscribable();
+
+private:
+  const size_t window;
+  const double percentile;
+  process::Owned<UsageResourceEstimatorProcess> process;
+};
+
+} // namespace slave {
+} // namespace internal {
+} // namespace mesos {
+
+#endif // __SLAVE_RESOURCE_ESTIMATORS_USAGE_HPP__
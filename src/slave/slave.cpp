@@ -210,6 +210,8 @@ Slave::Slave(const string& id,
     containerizer(_containerizer),
     files(_files),
     metrics(*this),
+    stateGeneration(0),
+    readOnlyEvent(false),
     gc(_gc),
     taskStatusUpdateManager(_taskStatusUpdateManager),
     masterPingTimeout(DEFAULT_MASTER_PING_TIMEOUT()),
@@ -469,6 +471,8 @@ void Slave::initialize()
 
   localResourceProviderDaemon = std::move(_localResourceProviderDaemon.get());
 
+  checkpointer.reset(new Checkpointer());
+
   Try<Resources> resources = Containerizer::resources(flags);
   if (resources.isError()) {
     EXIT(EXIT_FAILURE)
@@ -772,7 +776,8 @@ void Slave::initialize()
         [this](const http::Request& request,
                const Option<Principal>& principal) {
           logRequest(request);
-          return http.api(request, principal);
+          return metrics.http_api_latency.time<Milliseconds>(
+              http.api(request, principal));
         },
         options);
 
@@ -782,7 +787,8 @@ void Slave::initialize()
         [this](const http::Request& request,
                const Option<Principal>& principal) {
           logRequest(request);
-          return http.executor(request, principal);
+          return metrics.http_api_latency.time<Milliseconds>(
+              http.executor(request, principal));
         });
 
   route("/api/v1/resource_provider",
@@ -951,6 +957,29 @@ void Slave::finalize()
 }
 
 
+void Slave::serve(process::Event&& event)
+{
+  // Any event might change the state exposed by `/state`, hence
+  // `stateGeneration` is advanced here once per event rather than by
+  // each of the handlers changing the state. Only events which are
+  // known to merely read the state do not advance it: HTTP requests
+  // which are read-only by their method, and events marked via
+  // `readOnly()`.
+  readOnlyEvent = false;
+
+  if (event.is<process::HttpEvent>()) {
+    const string& method = event.as<process::HttpEvent>().request->method;
+    readOnlyEvent = method == "GET" || method == "HEAD";
+  }
+
+  ProcessBase::serve(std::move(event));
+
+  if (!readOnlyEvent) {
+    stateGeneration++;
+  }
+}
+
+
 void Slave::shutdown(const UPID& from, const string& message)
 {
   if (from && master != from) {
@@ -2583,10 +2612,13 @@ void Slave::__run(
 
       break;
     case Executor::RUNNING: {
+      // The tasks are checkpointed off the agent actor. They are only
+      // sent to the executor in '___run' once their checkpoints have
+      // been written, so a recovering agent always knows about the
+      // tasks that a running executor knows about.
+      Future<Nothing> checkpointed = Nothing();
       if (executor->checkpoint) {
-        foreach (const TaskInfo& _task, tasks) {
-          executor->checkpointTask(_task);
-        }
+        checkpointed = executor->checkpointTasks(tasks);
       }
 
       // Queue tasks until the containerizer is updated
@@ -2602,14 +2634,9 @@ void Slave::__run(
       LOG(INFO) << "Queued " << taskOrTaskGroup(task, taskGroup)
                 << " for executor " << *executor;
 
-      publishResources()
-        .then(defer(self(), [=] {
-          return containerizer->update(
-              executor->containerId,
-              executor->allocatedResources());
-        }))
+      checkpointed
         .onAny(defer(self(),
-                     &Self::___run,
+                     &Self::_checkpointTasks,
                      lambda::_1,
                      frameworkId,
                      executorId,
@@ -2634,6 +2661,92 @@ void Slave::__run(
 }
 
 
+void Slave::_checkpointTasks(
+    const Future<Nothing>& future,
+    const FrameworkID& frameworkId,
+    const ExecutorID& executorId,
+    const ContainerID& containerId,
+    const list<TaskInfo>& tasks,
+    const list<TaskGroupInfo>& taskGroups)
+{
+  Framework* framework = getFramework(frameworkId);
+  Executor* executor =
+    framework != nullptr ? framework->getExecutor(executorId) : nullptr;
+
+  // If the executor has terminated or been replaced in the meantime,
+  // '___run' ignores the tasks and their status updates are (or have
+  // been) sent when the executor terminates.
+  if (executor == nullptr ||
+      executor->containerId != containerId ||
+      executor->state != Executor::RUNNING) {
+    ___run(Nothing(), frameworkId, executorId, containerId, tasks, taskGroups);
+    return;
+  }
+
+  if (!future.isReady()) {
+    LOG(ERROR) << "Failed to checkpoint tasks for executor " << *executor
+               << ", dropping them: "
+               << (future.isFailed() ? future.failure() : "discarded");
+
+    // Only the tasks whose checkpoints failed are dropped; the other
+    // tasks of the executor are unaffected. We report TASK_DROPPED
+    // because the tasks were never launched. For non-partition-aware
+    // frameworks, we report TASK_LOST for backward compatibility.
+    mesos::TaskState taskState = TASK_DROPPED;
+    if (!framework->capabilities.partitionAware) {
+      taskState = TASK_LOST;
+    }
+
+    list<TaskInfo> tasks_ = tasks;
+    foreach (const TaskGroupInfo& taskGroup, taskGroups) {
+      tasks_.insert(
+          tasks_.end(), taskGroup.tasks().begin(), taskGroup.tasks().end());
+    }
+
+    foreach (const TaskInfo& task, tasks_) {
+      // This is the case where the task is killed. No need to send
+      // status update because it should be handled in 'killTask'.
+      if (!executor->queuedTasks.contains(task.task_id())) {
+        continue;
+      }
+
+      const StatusUpdate update = protobuf::createStatusUpdate(
+          frameworkId,
+          info.id(),
+          task.task_id(),
+          taskState,
+          TaskStatus::SOURCE_SLAVE,
+          id::UUID::random(),
+          "Failed to checkpoint task: " +
+            (future.isFailed() ? future.failure() : "discarded"),
+          None(),
+          executorId);
+
+      // NOTE: Sending a terminal update removes the task from
+      // 'executor->queuedTasks' (and 'executor->queuedTaskGroups').
+      statusUpdate(update, UPID());
+    }
+
+    return;
+  }
+
+  publishResources()
+    .then(defer(self(), [=] {
+      return containerizer->update(
+          containerId,
+          executor->allocatedResources());
+    }))
+    .onAny(defer(self(),
+                 &Self::___run,
+                 lambda::_1,
+                 frameworkId,
+                 executorId,
+                 containerId,
+                 tasks,
+                 taskGroups));
+}
+
+
 void Slave::___run(
     const Future<Nothing>& future,
     const FrameworkID& frameworkId,
@@ -6841,6 +6954,11 @@ void Slave::__recover(const Future<Nothing>& future)
 
     // Start acting on correction from QoS Controller.
     qosCorrections();
+
+    // Start sampling the resource usage of the executors.
+    if (flags.container_usage_sampling_interval.isSome()) {
+      sampleUsage();
+    }
   } else {
     // Slave started in cleanup mode.
     CHECK_EQ("cleanup", flags.recover);
@@ -7790,6 +7908,62 @@ void Slave::_qosCorrections(const Future<list<QoSCorrection>>& future)
 
 
 Future<ResourceUsage> Slave::usage()
+{
+  // Serve the most recent sample if the usage is sampled periodically,
+  // to avoid querying the containerizer for every consumer.
+  if (flags.container_usage_sampling_interval.isSome() &&
+      sampledUsage.isSome()) {
+    return sampledUsage.get();
+  }
+
+  return collectUsage();
+}
+
+
+Future<ResourceStatistics> Slave::containerUsage(
+    const ContainerID& containerId)
+{
+  if (flags.container_usage_sampling_interval.isSome() &&
+      sampledStatistics.contains(containerId)) {
+    return sampledStatistics.at(containerId);
+  }
+
+  return containerizer->usage(containerId);
+}
+
+
+void Slave::sampleUsage()
+{
+  collectUsage()
+    .onAny(defer(self(), &Slave::_sampleUsage, lambda::_1));
+}
+
+
+void Slave::_sampleUsage(const Future<ResourceUsage>& usage)
+{
+  CHECK_SOME(flags.container_usage_sampling_interval);
+
+  if (!usage.isReady()) {
+    LOG(WARNING) << "Failed to sample the resource usage of executors: "
+                 << (usage.isFailed() ? usage.failure() : "discarded");
+  } else {
+    sampledUsage = usage.get();
+
+    sampledStatistics.clear();
+    foreach (const ResourceUsage::Executor& executor, usage->executors()) {
+      if (executor.has_statistics()) {
+        sampledStatistics.put(executor.container_id(), executor.statistics());
+      }
+    }
+  }
+
+  delay(flags.container_usage_sampling_interval.get(),
+        self(),
+        &Slave::sampleUsage);
+}
+
+
+Future<ResourceUsage> Slave::collectUsage()
 {
   // NOTE: We use 'Owned' here trying to avoid the expensive copy.
   // C++11 lambda only supports capturing variables that have copy
@@ -9053,6 +9227,35 @@ void Executor::checkpointTask(const Task& task)
 }
 
 
+Future<Nothing> Executor::checkpointTasks(const vector<TaskInfo>& tasks)
+{
+  CHECK(checkpoint);
+
+  list<Future<Nothing>> checkpoints;
+
+  foreach (const TaskInfo& task, tasks) {
+    const string path = paths::getTaskInfoPath(
+        slave->metaDir,
+        slave->info.id(),
+        frameworkId,
+        id,
+        containerId,
+        task.task_id());
+
+    VLOG(1) << "Checkpointing TaskInfo to '" << path << "'";
+
+    // See the comment in 'checkpointTask' on downgrading resources.
+    Task task_ = protobuf::createTask(task, TASK_STAGING, frameworkId);
+    downgradeResources(task_.mutable_resources());
+
+    checkpoints.push_back(slave->checkpointer->checkpoint(path, task_));
+  }
+
+  return collect(checkpoints)
+    .then([]() { return Nothing(); });
+}
+
+
 void Executor::recoverTask(const TaskState& state, bool recheckpointTask)
 {
   if (state.info.isNone()) {
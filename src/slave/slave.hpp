@@ -78,6 +78,7 @@
 #include "resource_provider/daemon.hpp"
 #include "resource_provider/manager.hpp"
 
+#include "slave/checkpointer.hpp"
 #include "slave/constants.hpp"
 #include "slave/containerizer/containerizer.hpp"
 #include "slave/flags.hpp"
@@ -371,6 +372,10 @@ public:
   virtual void finalize();
   virtual void exited(const process::UPID& pid);
 
+  // Advances `stateGeneration` after every event which is not
+  // read-only, see `readOnly()`.
+  virtual void serve(process::Event&& event);
+
   void __run(
       const process::Future<std::list<bool>>& future,
       const FrameworkInfo& frameworkInfo,
@@ -379,6 +384,19 @@ public:
       const Option<TaskGroupInfo>& taskGroup,
       const std::vector<ResourceVersionUUID>& resourceVersionUuids);
 
+  // This is called when the given tasks and task groups, launched on
+  // a running executor, have been checkpointed. If checkpointing
+  // succeeded, the resource limits of the container are updated for
+  // them. Otherwise only these tasks are dropped; the executor and
+  // its other tasks keep running.
+  void _checkpointTasks(
+      const process::Future<Nothing>& future,
+      const FrameworkID& frameworkId,
+      const ExecutorID& executorId,
+      const ContainerID& containerId,
+      const std::list<TaskInfo>& tasks,
+      const std::list<TaskGroupInfo>& taskGroups);
+
   // This is called when the resource limits of the container have
   // been updated for the given tasks and task groups. If the update is
   // successful, we flush the given tasks to the executor by sending
@@ -496,9 +514,25 @@ public:
       const process::Future<std::list<
           mesos::slave::QoSCorrection>>& correction);
 
-  // Returns the resource usage information for all executors.
+  // Returns the resource usage information for all executors. If
+  // `--container_usage_sampling_interval` is set, this is the most
+  // recent sample.
   virtual process::Future<ResourceUsage> usage();
 
+  // Returns the resource statistics of the container, from the most
+  // recent usage sample if available.
+  process::Future<ResourceStatistics> containerUsage(
+      const ContainerID& containerId);
+
+  // Collects the resource usage information for all executors from
+  // the containerizer.
+  process::Future<ResourceUsage> collectUsage();
+
+  // Periodically samples the resource usage of all executors, see
+  // `--container_usage_sampling_interval`.
+  void sampleUsage();
+  void _sampleUsage(const process::Future<ResourceUsage>& usage);
+
   // Handle the second phase of shutting down an executor for those
   // executors that have not properly shutdown within a timeout.
   void shutdownExecutorTimeout(
@@ -592,6 +626,22 @@ private:
   process::Future<Nothing> publishResources(
       const Option<Resources>& additionalResources = None());
 
+  // Evaluates the given gauge method. Gauges only read the state of the
+  // agent, hence evaluating them is marked as read-only.
+  double gauge(double (Slave::*method)())
+  {
+    readOnly();
+    return (this->*method)();
+  }
+
+  double resourceGauge(
+      double (Slave::*method)(const std::string&),
+      const std::string& name)
+  {
+    readOnly();
+    return (this->*method)(name);
+  }
+
   // Gauge methods.
   double _frameworks_active()
   {
@@ -675,10 +725,30 @@ private:
 
   process::Time startTime;
 
+  // Increased after every event which might have changed the state
+  // exposed by the agent's `/state` endpoint, see `serve()`. Used to
+  // invalidate cached responses.
+  uint64_t stateGeneration;
+
+  // Marks the event being served as read-only, i.e., as one which does
+  // not change the state of the agent, so that it does not advance
+  // `stateGeneration`. Used by the continuations of read-only endpoints
+  // and by gauges, which are dispatched to the agent like any other
+  // event.
+  void readOnly() { readOnlyEvent = true; }
+
+  // Whether the event being served is read-only, see `readOnly()`.
+  bool readOnlyEvent;
+
   GarbageCollector* gc;
 
   TaskStatusUpdateManager* taskStatusUpdateManager;
 
+  // Used to checkpoint state off the agent actor where the agent can
+  // wait for the checkpoints to be written, e.g., when launching
+  // tasks on a running executor.
+  process::Owned<Checkpointer> checkpointer;
+
   // Master detection future.
   process::Future<Option<MasterInfo>> detection;
 
@@ -735,6 +805,12 @@ private:
   // (allocated and oversubscribable) resources.
   Option<Resources> oversubscribedResources;
 
+  // The most recent sample of the resource usage of all executors,
+  // and its statistics indexed by container. Only used if
+  // `--container_usage_sampling_interval` is set.
+  Option<ResourceUsage> sampledUsage;
+  hashmap<ContainerID, ResourceStatistics> sampledStatistics;
+
   ResourceProviderManager resourceProviderManager;
   process::Owned<LocalResourceProviderDaemon> localResourceProviderDaemon;
 
@@ -826,6 +902,13 @@ public:
   void checkpointTask(const TaskInfo& task);
   void checkpointTask(const Task& task);
 
+  // Checkpoints the tasks as a single batch through the agent's
+  // checkpointer. The future becomes ready once all of the tasks
+  // have been checkpointed, i.e., renamed into place. Like other
+  // checkpoints of the agent, they are not synced to disk.
+  process::Future<Nothing> checkpointTasks(
+      const std::vector<TaskInfo>& tasks);
+
   void recoverTask(const state::TaskState& state, bool recheckpointTask);
 
   Try<Nothing> updateTaskState(const TaskStatus& status);
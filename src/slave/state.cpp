@@ -16,7 +16,11 @@
 
 #include <glog/logging.h>
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 #include <process/pid.hpp>
 
@@ -26,6 +30,7 @@
 #include <stout/none.hpp>
 #include <stout/nothing.hpp>
 #include <stout/numify.hpp>
+#include <stout/option.hpp>
 #include <stout/path.hpp>
 #include <stout/protobuf.hpp>
 #include <stout/strings.hpp>
@@ -58,7 +63,9 @@ namespace state {
 
 using std::list;
 using std::max;
+using std::min;
 using std::string;
+using std::vector;
 
 
 Try<State> recover(const string& rootDir, bool strict)
@@ -295,13 +302,50 @@ Try<FrameworkState> FrameworkState::recover(
         ": " + executors.error());
   }
 
-  // Recover the executors.
-  foreach (const string& path, executors.get()) {
+  // Recover the executors. Executors are independent of each other,
+  // so they are recovered concurrently to overlap the latency of
+  // reading their checkpoints. We use dedicated threads rather than
+  // the libprocess worker pool, since blocking a worker on the results
+  // would deadlock with a single worker thread. The number of threads
+  // is bounded by the number of cores. The results are merged in order
+  // below so that errors are reported exactly as in a serial recovery.
+  const vector<string> executorPaths(executors->begin(), executors->end());
+
+  vector<Option<Try<ExecutorState>>> results(executorPaths.size());
+  std::atomic<size_t> next(0);
+
+  auto worker = [&]() {
+    for (size_t i = next++; i < executorPaths.size(); i = next++) {
+      ExecutorID executorId;
+      executorId.set_value(Path(executorPaths[i]).basename());
+
+      results[i] = ExecutorState::recover(
+          rootDir, slaveId, frameworkId, executorId, strict);
+    }
+  };
+
+  const size_t concurrency = min<size_t>(
+      executorPaths.size(),
+      max(1u, std::thread::hardware_concurrency()));
+
+  // The calling thread is one of the workers.
+  vector<std::thread> threads;
+  for (size_t i = 1; i < concurrency; i++) {
+    threads.emplace_back(worker);
+  }
+
+  worker();
+
+  foreach (std::thread& thread, threads) {
+    thread.join();
+  }
+
+  for (size_t i = 0; i < executorPaths.size(); i++) {
     ExecutorID executorId;
-    executorId.set_value(Path(path).basename());
+    executorId.set_value(Path(executorPaths[i]).basename());
 
-    Try<ExecutorState> executor =
-      ExecutorState::recover(rootDir, slaveId, frameworkId, executorId, strict);
+    CHECK_SOME(results[i]);
+    const Try<ExecutorState>& executor = results[i].get();
 
     if (executor.isError()) {
       return Error("Failed to recover executor '" + executorId.value() +
@@ -339,7 +383,8 @@ Try<ExecutorState> ExecutorState::recover(
                  "': " + runs.error());
   }
 
-  // Recover the runs.
+  // Resolve the latest run first so that the remaining runs, which
+  // are only garbage collected by the agent, can be skipped cheaply.
   foreach (const string& path, runs.get()) {
     if (Path(path).basename() == paths::LATEST_SYMLINK) {
       const Result<string>& latest = os::realpath(path);
@@ -356,23 +401,47 @@ Try<ExecutorState> ExecutorState::recover(
       ContainerID containerId;
       containerId.set_value(Path(latest.get()).basename());
       state.latest = containerId;
-    } else {
-      ContainerID containerId;
-      containerId.set_value(Path(path).basename());
+    }
+  }
 
-      Try<RunState> run = RunState::recover(
-          rootDir, slaveId, frameworkId, executorId, containerId, strict);
+  // Recover the runs.
+  foreach (const string& path, runs.get()) {
+    if (Path(path).basename() == paths::LATEST_SYMLINK) {
+      continue;
+    }
 
-      if (run.isError()) {
-        return Error(
-            "Failed to recover run " + containerId.value() +
-            " of executor '" + executorId.value() +
-            "': " + run.error());
-      }
+    ContainerID containerId;
+    containerId.set_value(Path(path).basename());
+
+    // A completed run that is not the latest run has already been
+    // removed by the agent and will only be garbage collected, so we
+    // do not replay its tasks. This keeps recovery time proportional
+    // to the number of live runs rather than to the number of
+    // historical runs.
+    if (state.latest.isSome() &&
+        state.latest.get() != containerId &&
+        os::exists(paths::getExecutorSentinelPath(
+            rootDir, slaveId, frameworkId, executorId, containerId))) {
+      RunState run;
+      run.id = containerId;
+      run.completed = true;
+
+      state.runs[containerId] = run;
+      continue;
+    }
 
-      state.runs[containerId] = run.get();
-      state.errors += run->errors;
+    Try<RunState> run = RunState::recover(
+        rootDir, slaveId, frameworkId, executorId, containerId, strict);
+
+    if (run.isError()) {
+      return Error(
+          "Failed to recover run " + containerId.value() +
+          " of executor '" + executorId.value() +
+          "': " + run.error());
     }
+
+    state.runs[containerId] = run.get();
+    state.errors += run->errors;
   }
 
   // Find the latest executor.
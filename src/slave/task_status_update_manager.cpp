@@ -16,6 +16,8 @@
 
 #include "slave/task_status_update_manager.hpp"
 
+#include <vector>
+
 #include <process/delay.hpp>
 #include <process/id.hpp>
 #include <process/process.hpp>
@@ -38,14 +40,18 @@
 
 #include "logging/logging.hpp"
 
+#include "messages/messages.hpp"
+
 #include "slave/constants.hpp"
 #include "slave/flags.hpp"
+#include "slave/paths.hpp"
 #include "slave/slave.hpp"
 #include "slave/state.hpp"
 
 using lambda::function;
 
 using std::string;
+using std::vector;
 
 using process::wait; // Necessary on some OS's to disambiguate.
 using process::Failure;
@@ -200,6 +206,60 @@ void TaskStatusUpdateManagerProcess::resume()
 }
 
 
+// Compacts the checkpointed status updates of a task by replacing
+// the fully acknowledged prefix of its stream with the latest update
+// of that prefix and its acknowledgement. Replaying the compacted
+// updates yields the same stream state, i.e., the latest acknowledged
+// update followed by the pending updates, while keeping the updates
+// file of a long running task from growing without bound. The prefix
+// never extends past a terminal update so that the recovered task
+// state is unchanged.
+//
+// NOTE: The stream forgets the UUIDs of the dropped updates, so a
+// retry of one of them by the executor is forwarded again instead of
+// being dropped as a duplicate. This is safe because status updates
+// have at-least-once semantics.
+static Try<Nothing> compact(
+    const string& path,
+    vector<StatusUpdate>* updates,
+    const hashset<id::UUID>& acks)
+{
+  size_t acknowledged = 0;
+  while (acknowledged < updates->size()) {
+    const StatusUpdate& update = updates->at(acknowledged);
+
+    if (protobuf::isTerminalState(update.status().state()) ||
+        !acks.contains(id::UUID::fromBytes(update.uuid()).get())) {
+      break;
+    }
+
+    acknowledged++;
+  }
+
+  // Nothing to compact if at most one update is acknowledged.
+  if (acknowledged <= 1) {
+    return Nothing();
+  }
+
+  updates->erase(updates->begin(), updates->begin() + acknowledged - 1);
+
+  google::protobuf::RepeatedPtrField<StatusUpdateRecord> records;
+  foreach (const StatusUpdate& update, *updates) {
+    StatusUpdateRecord* record = records.Add();
+    record->set_type(StatusUpdateRecord::UPDATE);
+    record->mutable_update()->CopyFrom(update);
+
+    if (acks.contains(id::UUID::fromBytes(update.uuid()).get())) {
+      record = records.Add();
+      record->set_type(StatusUpdateRecord::ACK);
+      record->set_uuid(update.uuid());
+    }
+  }
+
+  return state::checkpoint(path, records);
+}
+
+
 Future<Nothing> TaskStatusUpdateManagerProcess::recover(
     const string& rootDir,
     const Option<SlaveState>& state)
@@ -256,12 +316,27 @@ Future<Nothing> TaskStatusUpdateManagerProcess::recover(
           continue;
         }
 
+        // Compact the updates file before the stream opens it for
+        // appending, so that subsequent recoveries replay fewer records.
+        vector<StatusUpdate> updates = task.updates;
+
+        const string path = paths::getTaskUpdatesPath(
+            rootDir, state->id, framework.id, executor.id, latest, task.id);
+
+        Try<Nothing> compacted = compact(path, &updates, task.acks);
+        if (compacted.isError()) {
+          LOG(WARNING) << "Failed to compact status updates file '" << path
+                       << "': " << compacted.error();
+
+          updates = task.updates;
+        }
+
         // Create a new status update stream.
         TaskStatusUpdateStream* stream = createStatusUpdateStream(
             task.id, framework.id, state->id, true, executor.id, latest);
 
         // Replay the stream.
-        Try<Nothing> replay = stream->replay(task.updates, task.acks);
+        Try<Nothing> replay = stream->replay(updates, task.acks);
         if (replay.isError()) {
           return Failure(
               "Failed to replay status updates for task " + stringify(task.id) +
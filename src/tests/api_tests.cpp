@@ -77,6 +77,7 @@ using mesos::internal::devolve;
 using mesos::internal::evolve;
 
 using mesos::internal::master::DEFAULT_HEARTBEAT_INTERVAL;
+using mesos::internal::master::SUBSCRIBER_RESUME_WINDOW;
 
 using mesos::internal::recordio::Reader;
 
@@ -1719,6 +1720,247 @@ TEST_P(MasterAPITest, SubscribeAgentEvents)
 }
 
 
+// This test verifies that a subscriber which got disconnected can resume
+// its stream and receives the events it has missed instead of a snapshot
+// of the cluster state.
+TEST_P(MasterAPITest, SubscribeResume)
+{
+  ContentType contentType = GetParam();
+
+  Try<Owned<cluster::Master>> master = this->StartMaster();
+  ASSERT_SOME(master);
+
+  http::Headers headers = createBasicAuthHeaders(DEFAULT_CREDENTIAL);
+  headers["Accept"] = stringify(contentType);
+
+  auto deserializer =
+    lambda::bind(deserialize<v1::master::Event>, contentType, lambda::_1);
+
+  v1::master::Call v1Call;
+  v1Call.set_type(v1::master::Call::SUBSCRIBE);
+
+  Future<http::Response> response = http::streaming::post(
+      master.get()->pid,
+      "api/v1",
+      headers,
+      serialize(contentType, v1Call),
+      stringify(contentType));
+
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(http::OK().status, response);
+  ASSERT_EQ(http::Response::PIPE, response->type);
+  ASSERT_SOME(response->reader);
+
+  http::Pipe::Reader reader = response->reader.get();
+
+  string masterId;
+  uint64_t sequence;
+
+  {
+    Reader<v1::master::Event> decoder(
+        Decoder<v1::master::Event>(deserializer), reader);
+
+    Future<Result<v1::master::Event>> event = decoder.read();
+    AWAIT_READY(event);
+
+    ASSERT_EQ(v1::master::Event::SUBSCRIBED, event->get().type());
+    EXPECT_TRUE(event->get().subscribed().has_get_state());
+    EXPECT_FALSE(event->get().subscribed().resumed());
+
+    masterId = event->get().subscribed().master_id();
+    sequence = event->get().subscribed().sequence();
+
+    EXPECT_EQ(master.get()->getMasterInfo().id(), masterId);
+  }
+
+  // Disconnect the subscriber.
+  reader.close();
+
+  // Start an agent while the subscriber is disconnected.
+  Future<SlaveRegisteredMessage> agentRegisteredMessage =
+    FUTURE_PROTOBUF(SlaveRegisteredMessage(), master.get()->pid, _);
+
+  Owned<MasterDetector> detector = master.get()->createDetector();
+  Try<Owned<cluster::Slave>> slave = StartSlave(detector.get());
+  ASSERT_SOME(slave);
+
+  AWAIT_READY(agentRegisteredMessage);
+
+  // Resume the stream, the missed `AGENT_ADDED` event is expected to
+  // be sent instead of a snapshot.
+  v1::master::Call::Subscribe::Resume* resume =
+    v1Call.mutable_subscribe()->mutable_resume();
+
+  resume->set_master_id(masterId);
+  resume->set_sequence(sequence);
+
+  response = http::streaming::post(
+      master.get()->pid,
+      "api/v1",
+      headers,
+      serialize(contentType, v1Call),
+      stringify(contentType));
+
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(http::OK().status, response);
+  ASSERT_EQ(http::Response::PIPE, response->type);
+  ASSERT_SOME(response->reader);
+
+  {
+    Reader<v1::master::Event> decoder(
+        Decoder<v1::master::Event>(deserializer), response->reader.get());
+
+    Future<Result<v1::master::Event>> event = decoder.read();
+    AWAIT_READY(event);
+
+    ASSERT_EQ(v1::master::Event::SUBSCRIBED, event->get().type());
+    EXPECT_TRUE(event->get().subscribed().resumed());
+    EXPECT_FALSE(event->get().subscribed().has_get_state());
+    EXPECT_EQ(sequence, event->get().subscribed().sequence());
+
+    event = decoder.read();
+    AWAIT_READY(event);
+
+    ASSERT_EQ(v1::master::Event::AGENT_ADDED, event->get().type());
+    EXPECT_EQ(sequence + 1, event->get().sequence());
+    EXPECT_EQ(
+        evolve(agentRegisteredMessage->slave_id()),
+        event->get().agent_added().agent().agent_info().id());
+
+    event = decoder.read();
+    AWAIT_READY(event);
+
+    EXPECT_EQ(v1::master::Event::HEARTBEAT, event->get().type());
+  }
+
+  // A stream of another master cannot be resumed, hence a snapshot
+  // of the cluster state is expected to be sent.
+  resume->set_master_id("unknown");
+
+  response = http::streaming::post(
+      master.get()->pid,
+      "api/v1",
+      headers,
+      serialize(contentType, v1Call),
+      stringify(contentType));
+
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(http::OK().status, response);
+  ASSERT_EQ(http::Response::PIPE, response->type);
+  ASSERT_SOME(response->reader);
+
+  {
+    Reader<v1::master::Event> decoder(
+        Decoder<v1::master::Event>(deserializer), response->reader.get());
+
+    Future<Result<v1::master::Event>> event = decoder.read();
+    AWAIT_READY(event);
+
+    ASSERT_EQ(v1::master::Event::SUBSCRIBED, event->get().type());
+    EXPECT_FALSE(event->get().subscribed().resumed());
+    EXPECT_EQ(sequence + 1, event->get().subscribed().sequence());
+    EXPECT_EQ(
+        1, event->get().subscribed().get_state().get_agents().agents_size());
+  }
+}
+
+
+// This test verifies that the master stops recording events once no
+// subscriber has been connected for the resume window, after which a
+// stream can no longer be resumed.
+TEST_P(MasterAPITest, SubscribeResumeWindowExpired)
+{
+  ContentType contentType = GetParam();
+
+  Try<Owned<cluster::Master>> master = this->StartMaster();
+  ASSERT_SOME(master);
+
+  http::Headers headers = createBasicAuthHeaders(DEFAULT_CREDENTIAL);
+  headers["Accept"] = stringify(contentType);
+
+  auto deserializer =
+    lambda::bind(deserialize<v1::master::Event>, contentType, lambda::_1);
+
+  v1::master::Call v1Call;
+  v1Call.set_type(v1::master::Call::SUBSCRIBE);
+
+  Future<http::Response> response = http::streaming::post(
+      master.get()->pid,
+      "api/v1",
+      headers,
+      serialize(contentType, v1Call),
+      stringify(contentType));
+
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(http::OK().status, response);
+  ASSERT_EQ(http::Response::PIPE, response->type);
+  ASSERT_SOME(response->reader);
+
+  http::Pipe::Reader reader = response->reader.get();
+
+  string masterId;
+  uint64_t sequence;
+
+  {
+    Reader<v1::master::Event> decoder(
+        Decoder<v1::master::Event>(deserializer), reader);
+
+    Future<Result<v1::master::Event>> event = decoder.read();
+    AWAIT_READY(event);
+
+    ASSERT_EQ(v1::master::Event::SUBSCRIBED, event->get().type());
+
+    masterId = event->get().subscribed().master_id();
+    sequence = event->get().subscribed().sequence();
+  }
+
+  Future<Nothing> stopRecording = FUTURE_DISPATCH(
+      master.get()->pid, &master::Master::stopRecordingSubscriberEvents);
+
+  Clock::pause();
+
+  // Disconnect the subscriber.
+  reader.close();
+
+  // The master only starts the resume window once it has noticed the
+  // disconnection, hence keep advancing the clock until the window
+  // has expired.
+  while (stopRecording.isPending()) {
+    Clock::advance(SUBSCRIBER_RESUME_WINDOW);
+    Clock::settle();
+  }
+
+  Clock::resume();
+
+  // The stream cannot be resumed anymore, hence a snapshot of the
+  // cluster state is expected to be sent.
+  v1::master::Call::Subscribe::Resume* resume =
+    v1Call.mutable_subscribe()->mutable_resume();
+
+  resume->set_master_id(masterId);
+  resume->set_sequence(sequence);
+
+  response = http::streaming::post(
+      master.get()->pid,
+      "api/v1",
+      headers,
+      serialize(contentType, v1Call),
+      stringify(contentType));
+
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(http::OK().status, response);
+  ASSERT_EQ(http::Response::PIPE, response->type);
+  ASSERT_SOME(response->reader);
+
+  {
+    Reader<v1::master::Event> decoder(
+        Decoder<v1::master::Event>(deserializer), response->reader.get());
+
+    Future<Result<v1::master::Event>> event = decoder.read();
+    AWAIT_READY(event);
+
+    ASSERT_EQ(v1::master::Event::SUBSCRIBED, event->get().type());
+    EXPECT_FALSE(event->get().subscribed().resumed());
+    EXPECT_TRUE(event->get().subscribed().has_get_state());
+  }
+}
+
+
 // This test verifies that no information about reservations and/or allocations
 // is returned to unauthorized users in response to the GET_AGENTS call.
 TEST_P(MasterAPITest, GetAgentsFiltering)
@@ -14,7 +14,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <iostream>
+#include <list>
 #include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -24,6 +27,10 @@
 
 #include <mesos/module/authorizer.hpp>
 
+#include <process/collect.hpp>
+
+#include <stout/stopwatch.hpp>
+#include <stout/stringify.hpp>
 #include <stout/try.hpp>
 
 #include "authorizer/local/authorizer.hpp"
@@ -37,7 +44,11 @@ namespace mesos {
 namespace internal {
 namespace tests {
 
+using std::cout;
+using std::endl;
+using std::list;
 using std::string;
+using std::vector;
 
 
 template <typename T>
@@ -5495,6 +5506,236 @@ TYPED_TEST(AuthorizationTest, ModifyResourceProviderConfig)
   }
 }
 
+
+// This test verifies that a batch of requests is decided in order, and
+// that the decisions match those of the individual requests.
+TYPED_TEST(AuthorizationTest, BatchAuthorized)
+{
+  ACLs acls;
+
+  {
+    // "foo" principal can run as "guest" user.
+    mesos::ACL::RunTask* acl = acls.add_run_tasks();
+    acl->mutable_principals()->add_values("foo");
+    acl->mutable_users()->add_values("guest");
+  }
+
+  {
+    // No other principal can run as any user.
+    mesos::ACL::RunTask* acl = acls.add_run_tasks();
+    acl->mutable_principals()->set_type(mesos::ACL::Entity::ANY);
+    acl->mutable_users()->set_type(mesos::ACL::Entity::NONE);
+  }
+
+  Try<Authorizer*> create = TypeParam::create(parameterize(acls));
+  ASSERT_SOME(create);
+  Owned<Authorizer> authorizer(create.get());
+
+  auto request = [](const string& principal, const string& user) {
+    authorization::Request request;
+    request.set_action(authorization::RUN_TASK);
+    request.mutable_subject()->set_value(principal);
+    request.mutable_object()->mutable_task_info()->mutable_command()
+      ->set_user(user);
+    return request;
+  };
+
+  vector<authorization::Request> requests = {
+    request("foo", "guest"),
+    request("bar", "guest"),
+    request("foo", "root"),
+    request("foo", "guest")
+  };
+
+  vector<Future<bool>> authorized = authorizer->batchAuthorized(requests);
+
+  ASSERT_EQ(requests.size(), authorized.size());
+
+  AWAIT_EXPECT_TRUE(authorized[0]);
+  AWAIT_EXPECT_FALSE(authorized[1]);
+  AWAIT_EXPECT_FALSE(authorized[2]);
+  AWAIT_EXPECT_TRUE(authorized[3]);
+
+  for (size_t i = 0; i < requests.size(); i++) {
+    AWAIT_EXPECT_EQ(
+        authorized[i].get(),
+        authorizer->authorized(requests[i]));
+  }
+
+  // An empty batch is trivially decided.
+  EXPECT_TRUE(
+      authorizer->batchAuthorized(vector<authorization::Request>()).empty());
+}
+
+
+// This test verifies that a request without a subject is not decided
+// with the approver of a request with an empty subject.
+TYPED_TEST(AuthorizationTest, BatchAuthorizedWithoutSubject)
+{
+  ACLs acls;
+  acls.set_permissive(false);
+
+  {
+    // The empty principal can run as "guest" user. A request without a
+    // principal does not match this ACL and is denied.
+    mesos::ACL::RunTask* acl = acls.add_run_tasks();
+    acl->mutable_principals()->add_values("");
+    acl->mutable_users()->add_values("guest");
+  }
+
+  Try<Authorizer*> create = TypeParam::create(parameterize(acls));
+  ASSERT_SOME(create);
+  Owned<Authorizer> authorizer(create.get());
+
+  authorization::Request empty;
+  empty.set_action(authorization::RUN_TASK);
+  empty.mutable_subject()->set_value("");
+  empty.mutable_object()->mutable_task_info()->mutable_command()
+    ->set_user("guest");
+
+  authorization::Request none = empty;
+  none.clear_subject();
+
+  vector<Future<bool>> authorized =
+    authorizer->batchAuthorized({empty, none});
+
+  ASSERT_EQ(2u, authorized.size());
+
+  AWAIT_EXPECT_TRUE(authorized[0]);
+  AWAIT_EXPECT_FALSE(authorized[1]);
+
+  AWAIT_EXPECT_TRUE(authorizer->authorized(empty));
+  AWAIT_EXPECT_FALSE(authorizer->authorized(none));
+}
+
+
+class LocalAuthorizer_BENCHMARK_Test
+  : public ::testing::Test,
+    public ::testing::WithParamInterface<size_t> {};
+
+
+// The local authorizer benchmark tests are parameterized by the number
+// of ACLs per action.
+INSTANTIATE_TEST_CASE_P(
+    ACLCount,
+    LocalAuthorizer_BENCHMARK_Test,
+    ::testing::Values(10U, 1000U, 10000U));
+
+
+// This benchmark measures creating object approvers and approving
+// objects with them, as done when filtering the tasks and roles of the
+// `/state` endpoint. Each principal is granted access to its own user
+// and role subtree, and the requests are made by the principal named
+// in the last ACL.
+TEST_P(LocalAuthorizer_BENCHMARK_Test, Approve)
+{
+  const size_t aclCount = GetParam();
+  const size_t approverCount = 1000U;
+  const size_t objectCount = 100000U;
+
+  ACLs acls;
+
+  for (size_t i = 0; i < aclCount; i++) {
+    mesos::ACL::ViewTask* viewTask = acls.add_view_tasks();
+    viewTask->mutable_principals()->add_values("principal" + stringify(i));
+    viewTask->mutable_users()->add_values("user" + stringify(i));
+
+    mesos::ACL::ViewRole* viewRole = acls.add_view_roles();
+    viewRole->mutable_principals()->add_values("principal" + stringify(i));
+    viewRole->mutable_roles()->add_values("role" + stringify(i) + "/%");
+  }
+
+  {
+    // Nobody else can view tasks or roles.
+    mesos::ACL::ViewTask* viewTask = acls.add_view_tasks();
+    viewTask->mutable_principals()->set_type(mesos::ACL::Entity::ANY);
+    viewTask->mutable_users()->set_type(mesos::ACL::Entity::NONE);
+
+    mesos::ACL::ViewRole* viewRole = acls.add_view_roles();
+    viewRole->mutable_principals()->set_type(mesos::ACL::Entity::ANY);
+    viewRole->mutable_roles()->set_type(mesos::ACL::Entity::NONE);
+  }
+
+  Try<Authorizer*> create = LocalAuthorizer::create(acls);
+  ASSERT_SOME(create);
+  Owned<Authorizer> authorizer(create.get());
+
+  authorization::Subject subject;
+  subject.set_value("principal" + stringify(aclCount - 1));
+
+  Stopwatch watch;
+
+  watch.start();
+
+  list<Future<Owned<ObjectApprover>>> approvers;
+
+  for (size_t i = 0; i < approverCount; i++) {
+    approvers.push_back(
+        authorizer->getObjectApprover(subject, authorization::VIEW_TASK));
+  }
+
+  AWAIT_READY(collect(approvers));
+
+  watch.stop();
+
+  cout << "Created " << approverCount << " object approvers in "
+       << watch.elapsed() << endl;
+
+  const Owned<ObjectApprover> tasksApprover = approvers.back().get();
+
+  FrameworkInfo frameworkInfo = DEFAULT_FRAMEWORK_INFO;
+
+  Task allowedTask;
+  allowedTask.set_user("user" + stringify(aclCount - 1));
+
+  Task deniedTask;
+  deniedTask.set_user("user0");
+
+  watch.start();
+
+  for (size_t i = 0; i < objectCount; i++) {
+    ASSERT_SOME_EQ(
+        true,
+        tasksApprover->approved(
+            ObjectApprover::Object(allowedTask, frameworkInfo)));
+
+    ASSERT_SOME_EQ(
+        false,
+        tasksApprover->approved(
+            ObjectApprover::Object(deniedTask, frameworkInfo)));
+  }
+
+  watch.stop();
+
+  cout << "Approved " << 2 * objectCount << " tasks in "
+       << watch.elapsed() << endl;
+
+  Future<Owned<ObjectApprover>> rolesApprover =
+    authorizer->getObjectApprover(subject, authorization::VIEW_ROLE);
+
+  AWAIT_READY(rolesApprover);
+
+  const string allowedRole = "role" + stringify(aclCount - 1) + "/a/b/c";
+  const string deniedRole = "role0/a/b/c";
+
+  watch.start();
+
+  for (size_t i = 0; i < objectCount; i++) {
+    ASSERT_SOME_EQ(
+        true,
+        rolesApprover.get()->approved(ObjectApprover::Object(allowedRole)));
+
+    ASSERT_SOME_EQ(
+        false,
+        rolesApprover.get()->approved(ObjectApprover::Object(deniedRole)));
+  }
+
+  watch.stop();
+
+  cout << "Approved " << 2 * objectCount << " roles in "
+       << watch.elapsed() << endl;
+}
+
 } // namespace tests {
 } // namespace internal {
 } // namespace mesos {
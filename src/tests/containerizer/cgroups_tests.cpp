@@ -22,6 +22,7 @@
 #include <string.h>
 #include <unistd.h>
 
+#include <iostream>
 #include <set>
 #include <string>
 #include <thread>
@@ -47,6 +48,7 @@
 #include <stout/os.hpp>
 #include <stout/path.hpp>
 #include <stout/proc.hpp>
+#include <stout/stopwatch.hpp>
 #include <stout/stringify.hpp>
 #include <stout/strings.hpp>
 
@@ -66,6 +68,8 @@ using namespace process;
 using cgroups::memory::pressure::Level;
 using cgroups::memory::pressure::Counter;
 
+using std::cout;
+using std::endl;
 using std::set;
 using std::string;
 using std::vector;
@@ -556,6 +560,115 @@ TEST_F(CgroupsAnyHierarchyWithCpuAcctMemoryTest, ROOT_CGROUPS_Stat)
 }
 
 
+TEST_F(CgroupsAnyHierarchyWithCpuAcctMemoryTest, ROOT_CGROUPS_ControlReader)
+{
+  EXPECT_ERROR(cgroups::ControlReader::create(
+      path::join(baseHierarchy, "cpuacct"), TEST_CGROUPS_ROOT, "invalid"));
+
+  Try<Owned<cgroups::ControlReader>> reader = cgroups::ControlReader::create(
+      path::join(baseHierarchy, "cpuacct"), "/", "cpuacct.stat");
+  ASSERT_SOME(reader);
+
+  // The same reader should return fresh contents on each read.
+  for (int i = 0; i < 2; i++) {
+    Try<hashmap<string, uint64_t>> result = reader.get()->stat();
+    ASSERT_SOME(result);
+    EXPECT_TRUE(result->contains("user"));
+    EXPECT_TRUE(result->contains("system"));
+    EXPECT_GT(result->get("user").get(), 0llu);
+    EXPECT_GT(result->get("system").get(), 0llu);
+  }
+
+  // 'memory.stat' is larger than a page on some kernels, which
+  // exercises growing the buffer.
+  reader = cgroups::ControlReader::create(
+      path::join(baseHierarchy, "memory"), "/", "memory.stat");
+  ASSERT_SOME(reader);
+
+  Try<hashmap<string, uint64_t>> result = reader.get()->stat();
+  ASSERT_SOME(result);
+  EXPECT_TRUE(result->contains("rss"));
+  EXPECT_TRUE(result->contains("total_rss"));
+  EXPECT_GT(result->get("rss").get(), 0llu);
+
+  reader = cgroups::ControlReader::create(
+      path::join(baseHierarchy, "memory"), "/", "memory.usage_in_bytes");
+  ASSERT_SOME(reader);
+
+  Try<string> read = reader.get()->read();
+  ASSERT_SOME(read);
+  EXPECT_SOME(numify<uint64_t>(strings::trim(read.get())));
+}
+
+
+// Compares the cost of sampling 'memory.stat' and 'cpuacct.stat' of
+// many cgroups through 'cgroups::stat', which verifies the hierarchy
+// and opens the control file on each call, against reusing an open
+// 'cgroups::ControlReader' for each control file.
+TEST_F(CgroupsAnyHierarchyWithCpuAcctMemoryTest, ROOT_CGROUPS_BENCHMARK_Stat)
+{
+  const size_t cgroupCount = 500;
+  const size_t rounds = 10;
+
+  vector<string> hierarchies = {
+    path::join(baseHierarchy, "cpuacct"),
+    path::join(baseHierarchy, "memory")
+  };
+
+  vector<string> controls = {"cpuacct.stat", "memory.stat"};
+
+  vector<string> cgroups;
+  for (size_t i = 0; i < cgroupCount; i++) {
+    cgroups.push_back(path::join(TEST_CGROUPS_ROOT, stringify(i)));
+
+    foreach (const string& hierarchy, hierarchies) {
+      ASSERT_SOME(cgroups::create(hierarchy, cgroups.back(), true));
+    }
+  }
+
+  Stopwatch watch;
+  watch.start();
+
+  for (size_t round = 0; round < rounds; round++) {
+    foreach (const string& cgroup, cgroups) {
+      for (size_t i = 0; i < hierarchies.size(); i++) {
+        ASSERT_SOME(cgroups::stat(hierarchies[i], cgroup, controls[i]));
+      }
+    }
+  }
+
+  watch.stop();
+
+  cout << "Read " << controls.size() * cgroupCount * rounds
+       << " stat files with cgroups::stat in " << watch.elapsed() << endl;
+
+  vector<Owned<cgroups::ControlReader>> readers;
+  foreach (const string& cgroup, cgroups) {
+    for (size_t i = 0; i < hierarchies.size(); i++) {
+      Try<Owned<cgroups::ControlReader>> reader =
+        cgroups::ControlReader::create(hierarchies[i], cgroup, controls[i]);
+
+      ASSERT_SOME(reader);
+      readers.push_back(reader.get());
+    }
+  }
+
+  watch.start();
+
+  for (size_t round = 0; round < rounds; round++) {
+    foreach (const Owned<cgroups::ControlReader>& reader, readers) {
+      ASSERT_SOME(reader->stat());
+    }
+  }
+
+  watch.stop();
+
+  cout << "Read " << controls.size() * cgroupCount * rounds
+       << " stat files with cgroups::ControlReader in " << watch.elapsed()
+       << endl;
+}
+
+
 TEST_F(CgroupsAnyHierarchyWithCpuMemoryTest, ROOT_CGROUPS_Listen)
 {
   string hierarchy = path::join(baseHierarchy, "memory");
@@ -1280,6 +1393,42 @@ TEST_F(CgroupsAnyHierarchyWithCpuAcctMemoryTest, ROOT_CGROUPS_CpuAcctsStats)
 // root access since it's just testing the parsing aspects of the
 // cgroups devices whitelist. If we ever modify this filter to be less
 // restrictive, we should rename this test accordingly.
+TEST(PressureTest, Parse)
+{
+  EXPECT_ERROR(cgroups::psi::Pressure::parse(""));
+  EXPECT_ERROR(cgroups::psi::Pressure::parse("some"));
+  EXPECT_ERROR(cgroups::psi::Pressure::parse(
+      "some avg10=0.00 avg60=0.00 avg300=x total=0\n"));
+  EXPECT_ERROR(cgroups::psi::Pressure::parse(
+      "full avg10=0.00 avg60=0.00 avg300=0.00 total=0\n"));
+  EXPECT_ERROR(cgroups::psi::Pressure::parse(
+      "other avg10=0.00 avg60=0.00 avg300=0.00 total=0\n"));
+
+  // Older kernels only report the 'some' line for cpu.
+  Try<cgroups::psi::Pressure> pressure = cgroups::psi::Pressure::parse(
+      "some avg10=1.50 avg60=0.75 avg300=0.25 total=2500000\n");
+
+  ASSERT_SOME(pressure);
+  EXPECT_DOUBLE_EQ(1.5, pressure->some.avg10);
+  EXPECT_DOUBLE_EQ(0.75, pressure->some.avg60);
+  EXPECT_DOUBLE_EQ(0.25, pressure->some.avg300);
+  EXPECT_EQ(Seconds(2) + Milliseconds(500), pressure->some.total);
+  EXPECT_NONE(pressure->full);
+
+  pressure = cgroups::psi::Pressure::parse(
+      "some avg10=10.00 avg60=5.00 avg300=1.00 total=100\n"
+      "full avg10=2.00 avg60=1.00 avg300=0.50 total=20\n");
+
+  ASSERT_SOME(pressure);
+  EXPECT_DOUBLE_EQ(10.0, pressure->some.avg10);
+  EXPECT_EQ(Microseconds(100), pressure->some.total);
+  ASSERT_SOME(pressure->full);
+  EXPECT_DOUBLE_EQ(2.0, pressure->full->avg10);
+  EXPECT_DOUBLE_EQ(0.5, pressure->full->avg300);
+  EXPECT_EQ(Microseconds(20), pressure->full->total);
+}
+
+
 TEST(DevicesTest, Parse)
 {
   EXPECT_ERROR(cgroups::devices::Entry::parse(""));
@@ -14,6 +14,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <sys/time.h>
+
+#include <iostream>
 #include <string>
 #include <vector>
 
@@ -30,6 +33,8 @@
 #include <stout/gtest.hpp>
 #include <stout/os.hpp>
 #include <stout/path.hpp>
+#include <stout/stopwatch.hpp>
+#include <stout/stringify.hpp>
 #include <stout/try.hpp>
 
 #include "master/master.hpp"
@@ -49,6 +54,8 @@
 
 using namespace process;
 
+using std::cout;
+using std::endl;
 using std::string;
 using std::vector;
 
@@ -172,6 +179,167 @@ TEST_F(DiskUsageCollectorTest, ExcludeRelativePath)
 #endif
 
 
+// Sets the modification time of the given path to an hour ago, so
+// that the walking collector can reuse the usage of its files.
+static void age(const string& path)
+{
+  struct timeval times[2];
+  times[0].tv_sec = times[1].tv_sec = ::time(nullptr) - 3600;
+  times[0].tv_usec = times[1].tv_usec = 0;
+
+  ASSERT_EQ(0, ::utimes(path.c_str(), times));
+}
+
+
+// This test verifies that walking the directory tree reports the same
+// usage as 'du', counting hard links once and honoring excludes.
+TEST_F(DiskUsageCollectorTest, Walk)
+{
+  string file1 = path::join(os::getcwd(), "file1");
+  string file2 = path::join(os::getcwd(), "file2");
+
+  string dir = path::join(os::getcwd(), "dir");
+  string file3 = path::join(dir, "file3");
+  string link = path::join(dir, "link");
+
+  ASSERT_SOME(os::mkdir(dir));
+
+  ASSERT_SOME(os::write(file1, string(Kilobytes(8).bytes(), 'x')));
+  ASSERT_SOME(os::write(file2, string(Kilobytes(64).bytes(), 'y')));
+  ASSERT_SOME(os::write(file3, string(Kilobytes(16).bytes(), 'z')));
+  ASSERT_EQ(0, ::link(file2.c_str(), link.c_str()));
+
+  DiskUsageCollector du(Milliseconds(1));
+  DiskUsageCollector walk(Milliseconds(1), DiskUsageCollector::Method::WALK);
+
+  Future<Bytes> expected = du.usage(os::getcwd(), {});
+  Future<Bytes> usage = walk.usage(os::getcwd(), {});
+
+  AWAIT_READY(expected);
+  AWAIT_READY(usage);
+
+  // NOTE: 'du' reports the usage in 1K blocks.
+  EXPECT_EQ(expected.get(), Kilobytes((usage->bytes() + 1023) / 1024));
+  EXPECT_LT(usage.get(), Kilobytes(8 + 64 + 16) * 2);
+
+#ifdef __linux__
+  expected = du.usage(os::getcwd(), {"file2", "link"});
+  usage = walk.usage(os::getcwd(), {"file2", "link"});
+
+  AWAIT_READY(expected);
+  AWAIT_READY(usage);
+
+  EXPECT_EQ(expected.get(), Kilobytes((usage->bytes() + 1023) / 1024));
+  EXPECT_LT(usage.get(), Kilobytes(64));
+#endif // __linux__
+}
+
+
+// This test verifies that the walking collector notices changes in
+// directories whose usage it reuses from a previous walk.
+TEST_F(DiskUsageCollectorTest, WalkModifiedDirectory)
+{
+  string dir = path::join(os::getcwd(), "dir");
+  string file1 = path::join(dir, "file1");
+  string file2 = path::join(dir, "file2");
+
+  ASSERT_SOME(os::mkdir(dir));
+  ASSERT_SOME(os::write(file1, string(Kilobytes(8).bytes(), 'x')));
+  age(dir);
+
+  DiskUsageCollector collector(
+      Milliseconds(1),
+      DiskUsageCollector::Method::WALK);
+
+  Future<Bytes> usage1 = collector.usage(dir, {});
+  AWAIT_READY(usage1);
+  EXPECT_GE(usage1.get(), Kilobytes(8));
+
+  // Adding a file updates the modification time of the directory.
+  ASSERT_SOME(os::write(file2, string(Kilobytes(64).bytes(), 'y')));
+
+  Future<Bytes> usage2 = collector.usage(dir, {});
+  AWAIT_READY(usage2);
+  EXPECT_GE(usage2.get(), usage1.get() + Kilobytes(64));
+
+  // Writing to a file does not update the modification time of the
+  // directory. The write is accounted for once the reused usage of the
+  // files of the directory is revalidated, which happens periodically.
+  age(dir);
+
+  Future<Bytes> usage3 = collector.usage(dir, {});
+  AWAIT_READY(usage3);
+  EXPECT_EQ(usage2.get(), usage3.get());
+
+  ASSERT_SOME(os::write(file1, string(Kilobytes(128).bytes(), 'x')));
+
+  Future<Bytes> usage4;
+  for (int i = 0; i < 20; i++) {
+    usage4 = collector.usage(dir, {});
+    AWAIT_READY(usage4);
+
+    if (usage4.get() >= usage3.get() + Kilobytes(120)) {
+      break;
+    }
+  }
+
+  EXPECT_GE(usage4.get(), usage3.get() + Kilobytes(120));
+
+  // Removing a file updates the modification time of the directory.
+  ASSERT_SOME(os::rm(file2));
+
+  Future<Bytes> usage5 = collector.usage(dir, {});
+  AWAIT_READY(usage5);
+  EXPECT_LE(usage5.get(), usage4.get() - Kilobytes(64));
+}
+
+
+// Compares collecting the disk usage of a tree of 1M files with 'du'
+// against walking it, both without and with the directory usages of a
+// previous walk.
+TEST_F(DiskUsageCollectorTest, BENCHMARK_Walk)
+{
+  const size_t directoryCount = 1000;
+  const size_t fileCount = 1000;
+
+  for (size_t i = 0; i < directoryCount; i++) {
+    const string directory = path::join(os::getcwd(), stringify(i));
+    ASSERT_SOME(os::mkdir(directory));
+
+    for (size_t j = 0; j < fileCount; j++) {
+      ASSERT_SOME(os::touch(path::join(directory, stringify(j))));
+    }
+
+    age(directory);
+  }
+
+  DiskUsageCollector du(Milliseconds(1));
+  DiskUsageCollector walk(Milliseconds(1), DiskUsageCollector::Method::WALK);
+
+  Stopwatch watch;
+  watch.start();
+
+  AWAIT_READY_FOR(du.usage(os::getcwd(), {}), Minutes(10));
+
+  cout << "Collected the usage of " << directoryCount * fileCount
+       << " files with 'du' in " << watch.elapsed() << endl;
+
+  watch.start();
+
+  AWAIT_READY_FOR(walk.usage(os::getcwd(), {}), Minutes(10));
+
+  cout << "Collected the usage of " << directoryCount * fileCount
+       << " files with an uncached walk in " << watch.elapsed() << endl;
+
+  watch.start();
+
+  AWAIT_READY_FOR(walk.usage(os::getcwd(), {}), Minutes(10));
+
+  cout << "Collected the usage of " << directoryCount * fileCount
+       << " files with a cached walk in " << watch.elapsed() << endl;
+}
+
+
 class DiskQuotaTest : public MesosTest {};
 
 
@@ -17,6 +17,7 @@
 #include <unistd.h>
 
 #include <list>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -38,6 +39,7 @@
 #include <process/queue.hpp>
 #include <process/subprocess.hpp>
 
+#include <stout/bytes.hpp>
 #include <stout/json.hpp>
 #include <stout/option.hpp>
 #include <stout/os.hpp>
@@ -87,6 +89,7 @@ using process::Subprocess;
 using std::cout;
 using std::endl;
 using std::list;
+using std::shared_ptr;
 using std::string;
 using std::vector;
 
@@ -700,6 +703,16 @@ TEST_F(FetcherCacheTest, LocalCached)
 
     verifyCacheMetrics();
   }
+
+  // The first task downloaded the command into the cache, the second
+  // one retrieved it from there.
+  JSON::Object metrics = Metrics();
+
+  EXPECT_EQ(1, metrics.values["containerizer/fetcher/cache_misses"]);
+  EXPECT_EQ(1, metrics.values["containerizer/fetcher/cache_hits"]);
+  EXPECT_EQ(
+      COMMAND_SCRIPT.size(),
+      metrics.values["containerizer/fetcher/cache_bytes_saved"]);
 }
 
 
@@ -1710,6 +1723,81 @@ TEST_F(FetcherCacheTest, RemoveLRUCacheEntries)
 
   EXPECT_TRUE(cmd1Found);
   EXPECT_TRUE(cmd2Found);
+
+  JSON::Object metrics = Metrics();
+
+  EXPECT_EQ(1, metrics.values["containerizer/fetcher/cache_evictions"]);
+}
+
+
+class FetcherCacheRecoveryTest : public TemporaryDirectoryTest {};
+
+
+// Tests that the completely downloaded cache entries are recovered
+// from the checkpointed cache index, and that all other cache files
+// are deleted.
+TEST_F(FetcherCacheRecoveryTest, RecoverIndex)
+{
+  const string cacheDirectory = path::join(sandbox.get(), "cache");
+  ASSERT_SOME(os::mkdir(cacheDirectory));
+
+  CommandInfo::URI uri1;
+  uri1.set_value("http://example.com/artifact1.tar.gz");
+
+  CommandInfo::URI uri2;
+  uri2.set_value("http://example.com/artifact2.tar.gz");
+
+  const string data = "artifact";
+
+  FetcherProcess::Cache cache(Megabytes(1));
+
+  // A completely downloaded entry.
+  shared_ptr<FetcherProcess::Cache::Entry> entry1 =
+    cache.create(cacheDirectory, None(), uri1);
+
+  ASSERT_SOME(os::write(entry1->path().string(), data));
+  cache.claimSpace(Bytes(data.size()));
+  entry1->size = Bytes(data.size());
+  entry1->complete();
+
+  // An entry that is still being downloaded.
+  shared_ptr<FetcherProcess::Cache::Entry> entry2 =
+    cache.create(cacheDirectory, None(), uri2);
+
+  ASSERT_SOME(os::write(entry2->path().string(), "art"));
+
+  ASSERT_SOME(cache.checkpoint(cacheDirectory));
+
+  FetcherProcess::Cache recovered(Megabytes(1));
+  ASSERT_SOME(recovered.recover(cacheDirectory));
+
+  EXPECT_EQ(1u, recovered.size());
+  EXPECT_TRUE(recovered.contains(None(), uri1.value()));
+  EXPECT_FALSE(recovered.contains(None(), uri2.value()));
+  EXPECT_EQ(Bytes(data.size()), recovered.usedSpace());
+
+  EXPECT_TRUE(os::exists(entry1->path().string()));
+  EXPECT_FALSE(os::exists(entry2->path().string()));
+
+  Option<shared_ptr<FetcherProcess::Cache::Entry>> entry =
+    recovered.get(None(), uri1.value());
+
+  ASSERT_SOME(entry);
+  AWAIT_READY(entry.get()->completion());
+  EXPECT_EQ(entry1->filename, entry.get()->filename);
+
+  // New cache files must not reuse the names of the recovered ones.
+  EXPECT_NE(entry1->filename, recovered.nextFilename(uri1));
+  EXPECT_NE(entry2->filename, recovered.nextFilename(uri2));
+
+  // A cache that is now too small to hold the entry evicts it.
+  FetcherProcess::Cache shrunk(Bytes(data.size() - 1));
+  ASSERT_SOME(shrunk.recover(cacheDirectory));
+
+  EXPECT_EQ(0u, shrunk.size());
+  EXPECT_EQ(1u, shrunk.evictions());
+  EXPECT_EQ(Bytes(0), shrunk.usedSpace());
+  EXPECT_FALSE(os::exists(entry1->path().string()));
 }
 
 } // namespace tests {
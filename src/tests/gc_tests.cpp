@@ -25,6 +25,7 @@
 #include <mesos/resources.hpp>
 #include <mesos/scheduler.hpp>
 
+#include <process/collect.hpp>
 #include <process/dispatch.hpp>
 #include <process/future.hpp>
 #include <process/gmock.hpp>
@@ -39,6 +40,7 @@
 #include <stout/nothing.hpp>
 #include <stout/os.hpp>
 #include <stout/path.hpp>
+#include <stout/stringify.hpp>
 
 #include <stout/os/realpath.hpp>
 
@@ -177,6 +179,120 @@ TEST_F(GarbageCollectorTest, Schedule)
 }
 
 
+// Verifies that paths scheduled for the same time are deleted by
+// multiple workers, and that the freed space and inodes are reported.
+TEST_F(GarbageCollectorTest, ParallelRemoval)
+{
+  GarbageCollector gc(4);
+
+  // Make some temporary directories to gc, each with a couple of
+  // files in a nested directory.
+  list<string> directories;
+  for (int i = 0; i < 8; i++) {
+    const string directory = "directory" + stringify(i);
+
+    ASSERT_SOME(os::mkdir(path::join(directory, "nested")));
+    ASSERT_SOME(os::write(path::join(directory, "file"), string(4096, 'a')));
+    ASSERT_SOME(
+        os::write(path::join(directory, "nested", "file"), string(1, 'b')));
+
+    directories.push_back(directory);
+  }
+
+  Clock::pause();
+
+  list<Future<Nothing>> schedules;
+  foreach (const string& directory, directories) {
+    schedules.push_back(gc.schedule(Seconds(10), directory));
+  }
+
+  Clock::settle();
+  Clock::advance(Seconds(10));
+  Clock::settle();
+
+  AWAIT_READY(collect(schedules));
+
+  foreach (const string& directory, directories) {
+    EXPECT_FALSE(os::exists(directory));
+  }
+
+  JSON::Object metrics = Metrics();
+
+  EXPECT_SOME_EQ(
+      8u,
+      metrics.at<JSON::Number>("gc/path_removals_succeeded"));
+
+#ifndef __WINDOWS__
+  // Each directory consists of 4 inodes: itself, the nested directory
+  // and the two files.
+  EXPECT_SOME_EQ(
+      32u,
+      metrics.at<JSON::Number>("gc/inodes_reclaimed"));
+
+  Result<JSON::Number> bytes =
+    metrics.at<JSON::Number>("gc/bytes_reclaimed");
+
+  ASSERT_SOME(bytes);
+  EXPECT_LT(0u, bytes->as<uint64_t>());
+#endif // __WINDOWS__
+
+  Clock::resume();
+}
+
+
+// Verifies that paths due at different times share the workers, and
+// that each path is accounted for as soon as it is removed.
+TEST_F(GarbageCollectorTest, ParallelRemovalAcrossRemovalTimes)
+{
+  GarbageCollector gc(2);
+
+  list<string> directories;
+  for (int i = 0; i < 6; i++) {
+    const string directory = "directory" + stringify(i);
+    ASSERT_SOME(os::mkdir(path::join(directory, "nested")));
+    directories.push_back(directory);
+  }
+
+  Clock::pause();
+
+  // Half of the paths are due after 10 seconds and the other half
+  // after 20 seconds.
+  list<Future<Nothing>> schedules;
+  int i = 0;
+  foreach (const string& directory, directories) {
+    schedules.push_back(
+        gc.schedule(Seconds(i++ < 3 ? 10 : 20), directory));
+  }
+
+  Clock::settle();
+  Clock::advance(Seconds(10));
+  Clock::settle();
+  Clock::advance(Seconds(10));
+  Clock::settle();
+
+  AWAIT_READY(collect(schedules));
+
+  // Let the bookkeeping of the last removals complete.
+  Clock::settle();
+
+  foreach (const string& directory, directories) {
+    EXPECT_FALSE(os::exists(directory));
+  }
+
+  JSON::Object metrics = Metrics();
+
+  EXPECT_SOME_EQ(
+      6u,
+      metrics.at<JSON::Number>("gc/path_removals_succeeded"));
+
+  EXPECT_SOME_EQ(
+      0u,
+      metrics.at<JSON::Number>("gc/path_removals_pending"));
+
+  Clock::resume();
+}
+
+
 TEST_F(GarbageCollectorTest, Unschedule)
 {
   GarbageCollector gc;
@@ -1919,6 +1919,76 @@ TEST_F(HierarchicalAllocatorTest, RecoverResources)
 }
 
 
+// Checks that resources allocated to multiple roles on multiple agents
+// can be recovered with a single call, and are re-allocated correctly.
+TEST_F(HierarchicalAllocatorTest, BatchRecoverResources)
+{
+  Clock::pause();
+
+  initialize();
+
+  SlaveInfo slave1 = createSlaveInfo("cpus:1;mem:512;disk:0");
+  allocator->addSlave(
+      slave1.id(),
+      slave1,
+      AGENT_CAPABILITIES(),
+      None(),
+      slave1.resources(),
+      {});
+
+  SlaveInfo slave2 = createSlaveInfo("cpus:1;mem:512;disk:0");
+  allocator->addSlave(
+      slave2.id(),
+      slave2,
+      AGENT_CAPABILITIES(),
+      None(),
+      slave2.resources(),
+      {});
+
+  // The agents are allocated to either of the framework's roles.
+  FrameworkInfo framework = createFrameworkInfo({"role1", "role2"});
+  allocator->addFramework(framework.id(), framework, {}, true, {});
+
+  Resources total = slave1.resources() + slave2.resources();
+
+  Future<Allocation> allocation = allocations.get();
+  AWAIT_READY(allocation);
+
+  hashmap<FrameworkID, hashmap<SlaveID, Resources>> recovered;
+
+  Resources allocated;
+  foreachkey (const string& role, allocation->resources) {
+    foreachpair (const SlaveID& slaveId,
+                 const Resources& resources,
+                 allocation->resources.at(role)) {
+      recovered[framework.id()][slaveId] += resources;
+      allocated += resources;
+    }
+  }
+
+  allocated.unallocate();
+  EXPECT_EQ(total, allocated);
+
+  allocator->batchRecoverResources(recovered);
+
+  // Expect all resources to be re-offered.
+  Clock::advance(flags.allocation_interval);
+
+  allocation = allocations.get();
+  AWAIT_READY(allocation);
+
+  allocated = Resources();
+  foreachkey (const string& role, allocation->resources) {
+    foreachvalue (const Resources& resources, allocation->resources.at(role)) {
+      allocated += resources;
+    }
+  }
+
+  allocated.unallocate();
+  EXPECT_EQ(total, allocated);
+}
+
+
 // Checks that resource provider resources can be added to an agent
 // and that the added used resources are correctly taken into account
 // when computing fair share.
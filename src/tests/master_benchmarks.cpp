@@ -17,6 +17,7 @@
 #include <list>
 #include <string>
 #include <tuple>
+#include <vector>
 
 #include <mesos/resources.hpp>
 #include <mesos/version.hpp>
@@ -32,6 +33,8 @@
 
 #include "common/protobuf_utils.hpp"
 
+#include "master/compact_task.hpp"
+
 #include "tests/mesos.hpp"
 
 using process::await;
@@ -46,6 +49,9 @@ using process::spawn;
 using process::terminate;
 using process::UPID;
 
+using mesos::internal::master::CompactTask;
+using mesos::internal::master::TaskShapes;
+
 using std::cout;
 using std::endl;
 using std::list;
@@ -53,6 +59,7 @@ using std::make_tuple;
 using std::string;
 using std::tie;
 using std::tuple;
+using std::vector;
 
 using testing::WithParamInterface;
 
@@ -184,6 +191,25 @@ public:
     return promise.future();
   }
 
+  // Sends a status update transitioning each of the running tasks
+  // to `state`.
+  void updateTasks(const TaskState& state)
+  {
+    foreach (const Task& task, message.tasks()) {
+      StatusUpdateMessage update;
+      *update.mutable_update() = protobuf::createStatusUpdate(
+          task.framework_id(),
+          slaveId,
+          task.task_id(),
+          state,
+          TaskStatus::SOURCE_EXECUTOR,
+          id::UUID::random());
+      update.set_pid(self());
+
+      send(masterPid, update);
+    }
+  }
+
   TestSlaveProcess(const TestSlaveProcess& other) = delete;
   TestSlaveProcess& operator=(const TestSlaveProcess& other) = delete;
 
@@ -243,6 +269,11 @@ public:
     return dispatch(process.get(), &TestSlaveProcess::reregister);
   }
 
+  void updateTasks(const TaskState& state)
+  {
+    dispatch(process.get(), &TestSlaveProcess::updateTasks, state);
+  }
+
 private:
   Owned<TestSlaveProcess> process;
 };
@@ -265,7 +296,8 @@ INSTANTIATE_TEST_CASE_P(
     ::testing::Values(
         make_tuple(2000, 5, 10, 5, 10),
         make_tuple(2000, 5, 20, 0, 0),
-        make_tuple(20000, 1, 5, 0, 0)));
+        make_tuple(20000, 1, 5, 0, 0),
+        make_tuple(50000, 2, 10, 0, 0)));
 
 
 // This test measures the time from all agents start to reregister to
@@ -337,6 +369,194 @@ TEST_P(MasterFailover_BENCHMARK_Test, AgentReregistrationDelay)
        << watch.elapsed() << endl;
 }
 
+
+class StatusUpdate_BENCHMARK_Test
+  : public MesosTest,
+    public WithParamInterface<tuple<size_t, size_t>> {};
+
+
+// The value tuples are defined as:
+// - agentCount
+// - tasksPerAgent
+INSTANTIATE_TEST_CASE_P(
+    AgentAndTaskCount,
+    StatusUpdate_BENCHMARK_Test,
+    ::testing::Values(
+        make_tuple(100, 100),
+        make_tuple(1000, 100),
+        make_tuple(10000, 10)));
+
+
+// This test measures the time for the master (and its allocator) to
+// process a terminal status update for every task in the cluster, as
+// happens when a large job finishes.
+TEST_P(StatusUpdate_BENCHMARK_Test, TerminalStatusUpdates)
+{
+  size_t agentCount;
+  size_t tasksPerAgent;
+
+  tie(agentCount, tasksPerAgent) = GetParam();
+
+  master::Flags masterFlags = CreateMasterFlags();
+  masterFlags.authenticate_agents = false;
+
+  Try<Owned<cluster::Master>> master = StartMaster(masterFlags);
+  ASSERT_SOME(master);
+
+  list<TestSlave> slaves;
+
+  for (size_t i = 0; i < agentCount; i++) {
+    SlaveID slaveId;
+    slaveId.set_value("agent" + stringify(i));
+
+    slaves.emplace_back(master.get()->pid, slaveId, 1, tasksPerAgent, 0, 0);
+  }
+
+  list<Future<Nothing>> reregistered;
+  foreach (TestSlave& slave, slaves) {
+    reregistered.push_back(slave.reregister());
+  }
+
+  AWAIT_READY(process::collect(reregistered));
+
+  // Make sure the master and the allocator are idle before we start
+  // the stopwatch.
+  Clock::pause();
+  Clock::settle();
+  Clock::resume();
+
+  cout << "Sending status updates for " << agentCount * tasksPerAgent
+       << " tasks on " << agentCount << " agents" << endl;
+
+  Stopwatch watch;
+  watch.start();
+
+  foreach (TestSlave& slave, slaves) {
+    slave.updateTasks(TASK_FINISHED);
+  }
+
+  // Wait until the master and the allocator have processed all updates.
+  Clock::pause();
+  Clock::settle();
+  Clock::resume();
+
+  watch.stop();
+
+  JSON::Object metrics = Metrics();
+  EXPECT_EQ(
+      agentCount * tasksPerAgent,
+      metrics.values["master/messages_status_update"]);
+
+  cout << "Processed " << agentCount * tasksPerAgent
+       << " status updates in " << watch.elapsed() << endl;
+}
+
+
+class CompactTask_BENCHMARK_Test
+  : public MesosTest,
+    public WithParamInterface<tuple<size_t, size_t>> {};
+
+
+// The value tuples are defined as:
+// - taskCount
+// - shapeCount (number of distinct task shapes, e.g., applications)
+INSTANTIATE_TEST_CASE_P(
+    TaskAndShapeCount,
+    CompactTask_BENCHMARK_Test,
+    ::testing::Values(
+        make_tuple(100000, 1),
+        make_tuple(100000, 100),
+        make_tuple(100000, 100000)));
+
+
+// This test reports the memory used per completed task when stored as
+// a `Task` and in compact form, as well as the time to compact the
+// tasks and to materialize them again.
+TEST_P(CompactTask_BENCHMARK_Test, BytesPerTask)
+{
+  size_t taskCount;
+  size_t shapeCount;
+
+  tie(taskCount, shapeCount) = GetParam();
+
+  FrameworkID frameworkId;
+  frameworkId.set_value("framework");
+
+  SlaveID slaveId;
+  slaveId.set_value("agent");
+
+  vector<TaskInfo> taskInfos;
+  for (size_t i = 0; i < shapeCount; i++) {
+    taskInfos.push_back(createTaskInfo(slaveId));
+    taskInfos.back().set_name("application-" + stringify(i));
+  }
+
+  const vector<TaskState> states = {TASK_STARTING, TASK_RUNNING, TASK_FINISHED};
+
+  vector<Task> tasks;
+  tasks.reserve(taskCount);
+
+  size_t taskBytes = 0;
+
+  for (size_t i = 0; i < taskCount; i++) {
+    TaskInfo taskInfo = taskInfos[i % shapeCount];
+    taskInfo.mutable_task_id()->set_value("task-" + stringify(i));
+
+    Task task = protobuf::createTask(taskInfo, TASK_FINISHED, frameworkId);
+
+    foreach (const TaskState& state, states) {
+      TaskStatus* status = task.add_statuses();
+      status->mutable_task_id()->CopyFrom(task.task_id());
+      status->mutable_slave_id()->CopyFrom(task.slave_id());
+      status->set_state(state);
+      status->set_source(TaskStatus::SOURCE_EXECUTOR);
+      status->set_timestamp(static_cast<double>(i));
+    }
+
+    taskBytes += task.SpaceUsedLong();
+    tasks.push_back(std::move(task));
+  }
+
+  TaskShapes shapes;
+
+  vector<CompactTask> compactTasks;
+  compactTasks.reserve(taskCount);
+
+  Stopwatch watch;
+  watch.start();
+
+  foreach (Task& task, tasks) {
+    compactTasks.emplace_back(std::move(task), &shapes);
+  }
+
+  watch.stop();
+
+  cout << "Compacted " << taskCount << " tasks with " << shapeCount
+       << " shapes in " << watch.elapsed() << endl;
+
+  size_t compactTaskBytes = shapes.spaceUsed();
+  foreach (const CompactTask& task, compactTasks) {
+    compactTaskBytes += task.spaceUsed();
+  }
+
+  cout << "Bytes per task: " << taskBytes / taskCount << " as Task, "
+       << compactTaskBytes / taskCount << " as CompactTask" << endl;
+
+  watch.start();
+
+  size_t materialized = 0;
+  foreach (const CompactTask& task, compactTasks) {
+    materialized += task.materialize().statuses_size();
+  }
+
+  watch.stop();
+
+  EXPECT_EQ(states.size() * taskCount, materialized);
+
+  cout << "Materialized " << taskCount << " tasks in "
+       << watch.elapsed() << endl;
+}
+
 } // namespace tests {
 } // namespace internal {
 } // namespace mesos {
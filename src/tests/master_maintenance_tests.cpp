@@ -15,9 +15,11 @@
 // limitations under the License.
 
 #include <initializer_list>
+#include <list>
 #include <string>
 
 #include <mesos/maintenance/maintenance.hpp>
+#include <mesos/version.hpp>
 
 #include <mesos/v1/mesos.hpp>
 #include <mesos/v1/resources.hpp>
@@ -26,9 +28,12 @@
 #include <mesos/v1/scheduler/scheduler.hpp>
 
 #include <process/clock.hpp>
+#include <process/collect.hpp>
 #include <process/future.hpp>
 #include <process/http.hpp>
 #include <process/pid.hpp>
+#include <process/process.hpp>
+#include <process/protobuf.hpp>
 #include <process/time.hpp>
 
 #include <stout/duration.hpp>
@@ -37,6 +42,7 @@
 #include <stout/net.hpp>
 #include <stout/option.hpp>
 #include <stout/protobuf.hpp>
+#include <stout/stopwatch.hpp>
 #include <stout/strings.hpp>
 #include <stout/stringify.hpp>
 #include <stout/try.hpp>
@@ -75,6 +81,8 @@ using process::Future;
 using process::Message;
 using process::Owned;
 using process::PID;
+using process::ProcessBase;
+using process::Promise;
 using process::Time;
 using process::UPID;
 
@@ -88,13 +96,18 @@ using mesos::internal::protobuf::maintenance::createSchedule;
 using mesos::internal::protobuf::maintenance::createUnavailability;
 using mesos::internal::protobuf::maintenance::createWindow;
 
+using std::cout;
+using std::endl;
+using std::list;
 using std::string;
 using std::vector;
 
 using testing::AtMost;
 using testing::DoAll;
 using testing::Eq;
+using testing::Invoke;
 using testing::Not;
+using testing::WithParamInterface;
 
 namespace mesos {
 namespace internal {
@@ -1960,6 +1973,186 @@ TEST_F(MasterMaintenanceTest, AcceptInvalidInverseOffer)
   driver.join();
 }
 
+
+// A fake agent which only registers with the master, so that large
+// clusters can be simulated.
+class FakeAgentProcess : public ProtobufProcess<FakeAgentProcess>
+{
+public:
+  FakeAgentProcess(const UPID& _masterPid, const string& hostname)
+    : ProcessBase(process::ID::generate("fake-agent")),
+      masterPid(_masterPid)
+  {
+    // Using a static local variable to avoid the cost of re-parsing.
+    static const Resources resources =
+      Resources::parse("cpus:4;mem:1024").get();
+
+    slaveInfo.set_hostname(hostname);
+    *(slaveInfo.mutable_resources()) = resources;
+  }
+
+  void initialize() override
+  {
+    install<SlaveRegisteredMessage>(&Self::registered);
+    install<PingSlaveMessage>(
+        &Self::ping,
+        &PingSlaveMessage::connected);
+  }
+
+  Future<Nothing> registerWithMaster()
+  {
+    RegisterSlaveMessage message;
+    *(message.mutable_slave()) = slaveInfo;
+    message.set_version(MESOS_VERSION);
+
+    send(masterPid, message);
+    return promise.future();
+  }
+
+  MachineID machineId() const
+  {
+    MachineID machineId;
+    machineId.set_hostname(slaveInfo.hostname());
+    machineId.set_ip(stringify(self().address.ip));
+
+    return machineId;
+  }
+
+private:
+  void registered(const SlaveRegisteredMessage&)
+  {
+    promise.set(Nothing());
+  }
+
+  // We need to answer pings to keep the agent registered.
+  void ping(const UPID& from, bool)
+  {
+    send(from, PongSlaveMessage());
+  }
+
+  const UPID masterPid;
+  SlaveInfo slaveInfo;
+  Promise<Nothing> promise;
+};
+
+
+class MasterMaintenance_BENCHMARK_Test
+  : public MesosTest,
+    public WithParamInterface<size_t> {};
+
+
+INSTANTIATE_TEST_CASE_P(
+    AgentCount,
+    MasterMaintenance_BENCHMARK_Test,
+    ::testing::Values(1000U, 5000U, 10000U));
+
+
+// This test measures the time from posting a maintenance schedule
+// which drains all agents of a cluster to when a framework holding
+// offers on every agent has seen all of them rescinded.
+TEST_P(MasterMaintenance_BENCHMARK_Test, DrainAllAgents)
+{
+  const size_t agentCount = GetParam();
+
+  master::Flags masterFlags = CreateMasterFlags();
+  masterFlags.authenticate_agents = false;
+
+  Try<Owned<cluster::Master>> master = StartMaster(masterFlags);
+  ASSERT_SOME(master);
+
+  vector<Owned<FakeAgentProcess>> agents;
+  list<Future<Nothing>> registered;
+
+  for (size_t i = 0; i < agentCount; i++) {
+    Owned<FakeAgentProcess> agent(
+        new FakeAgentProcess(master.get()->pid, "agent" + stringify(i)));
+
+    spawn(agent.get());
+
+    registered.push_back(
+        dispatch(agent.get(), &FakeAgentProcess::registerWithMaster));
+
+    agents.push_back(agent);
+  }
+
+  AWAIT_READY_FOR(process::collect(registered), Minutes(5));
+
+  MockScheduler sched;
+  MesosSchedulerDriver driver(
+      &sched, DEFAULT_FRAMEWORK_INFO, master.get()->pid, DEFAULT_CREDENTIAL);
+
+  EXPECT_CALL(sched, registered(&driver, _, _));
+
+  // NOTE: The scheduler callbacks are invoked sequentially by the
+  // driver, so the counters below need no synchronization.
+  size_t offered = 0;
+  Promise<Nothing> allOffered;
+
+  EXPECT_CALL(sched, resourceOffers(&driver, _))
+    .WillRepeatedly(Invoke(
+        [&](SchedulerDriver*, const vector<Offer>& offers) {
+          offered += offers.size();
+          if (offered >= agentCount) {
+            allOffered.set(Nothing());
+          }
+        }));
+
+  size_t rescinded = 0;
+  Promise<Nothing> allRescinded;
+
+  EXPECT_CALL(sched, offerRescinded(&driver, _))
+    .WillRepeatedly(Invoke(
+        [&](SchedulerDriver*, const OfferID&) {
+          if (++rescinded >= agentCount) {
+            allRescinded.set(Nothing());
+          }
+        }));
+
+  driver.start();
+
+  AWAIT_READY_FOR(allOffered.future(), Minutes(5));
+
+  // Schedule maintenance for all machines in a single window.
+  maintenance::Schedule schedule;
+  maintenance::Window* window = schedule.add_windows();
+  window->mutable_unavailability()->CopyFrom(
+      createUnavailability(Clock::now()));
+
+  foreach (const Owned<FakeAgentProcess>& agent, agents) {
+    window->add_machine_ids()->CopyFrom(agent->machineId());
+  }
+
+  process::http::Headers headers = createBasicAuthHeaders(DEFAULT_CREDENTIAL);
+  headers["Content-Type"] = "application/json";
+
+  cout << "Scheduling maintenance for " << agentCount << " agents" << endl;
+
+  Stopwatch watch;
+  watch.start();
+
+  Future<Response> response = process::http::post(
+      master.get()->pid,
+      "maintenance/schedule",
+      headers,
+      stringify(JSON::protobuf(schedule)));
+
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ_FOR(OK().status, response, Minutes(5));
+  AWAIT_READY_FOR(allRescinded.future(), Minutes(5));
+
+  watch.stop();
+
+  cout << "Rescinded the offers on " << agentCount << " draining agents in "
+       << watch.elapsed() << endl;
+
+  driver.stop();
+  driver.join();
+
+  foreach (const Owned<FakeAgentProcess>& agent, agents) {
+    terminate(agent.get());
+    process::wait(agent.get());
+  }
+}
+
 } // namespace tests {
 } // namespace internal {
 } // namespace mesos {
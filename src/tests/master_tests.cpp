@@ -17,6 +17,7 @@
 #include <unistd.h>
 
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -105,10 +106,12 @@ using process::PID;
 using process::Promise;
 
 using process::http::Accepted;
+using process::http::BadRequest;
 using process::http::OK;
 using process::http::Response;
 using process::http::Unauthorized;
 
+using std::set;
 using std::shared_ptr;
 using std::string;
 using std::vector;
@@ -2362,6 +2365,169 @@ TEST_F(MasterTest, MetricsInMetricsEndpoint)
 }
 
 
+// This test verifies that the task state metrics of the master drop
+// back to zero once a task finishes.
+TEST_F(MasterTest, TaskMetricsAfterTaskFinished)
+{
+  Try<Owned<cluster::Master>> master = StartMaster();
+  ASSERT_SOME(master);
+
+  MockExecutor exec(DEFAULT_EXECUTOR_ID);
+  TestContainerizer containerizer(&exec);
+
+  Owned<MasterDetector> detector = master.get()->createDetector();
+  Try<Owned<cluster::Slave>> slave = StartSlave(detector.get(), &containerizer);
+  ASSERT_SOME(slave);
+
+  MockScheduler sched;
+  MesosSchedulerDriver driver(
+      &sched, DEFAULT_FRAMEWORK_INFO, master.get()->pid, DEFAULT_CREDENTIAL);
+
+  EXPECT_CALL(sched, registered(&driver, _, _));
+
+  Future<vector<Offer>> offers;
+  EXPECT_CALL(sched, resourceOffers(&driver, _))
+    .WillOnce(FutureArg<1>(&offers))
+    .WillRepeatedly(Return()); // Ignore subsequent offers.
+
+  driver.start();
+
+  AWAIT_READY(offers);
+  ASSERT_FALSE(offers->empty());
+
+  TaskInfo task = createTask(offers.get()[0], "", DEFAULT_EXECUTOR_ID);
+
+  ExecutorDriver* execDriver;
+  EXPECT_CALL(exec, registered(_, _, _, _))
+    .WillOnce(SaveArg<0>(&execDriver));
+
+  EXPECT_CALL(exec, launchTask(_, _))
+    .WillOnce(SendStatusUpdateFromTask(TASK_RUNNING));
+
+  Future<TaskStatus> runningStatus;
+  Future<TaskStatus> finishedStatus;
+  EXPECT_CALL(sched, statusUpdate(&driver, _))
+    .WillOnce(FutureArg<1>(&runningStatus))
+    .WillOnce(FutureArg<1>(&finishedStatus));
+
+  driver.launchTasks(offers.get()[0].id(), {task});
+
+  AWAIT_READY(runningStatus);
+  EXPECT_EQ(TASK_RUNNING, runningStatus->state());
+
+  {
+    JSON::Object stats = Metrics();
+    EXPECT_EQ(0, stats.values["master/tasks_staging"]);
+    EXPECT_EQ(1, stats.values["master/tasks_running"]);
+  }
+
+  TaskStatus status;
+  status.mutable_task_id()->CopyFrom(task.task_id());
+  status.set_state(TASK_FINISHED);
+
+  execDriver->sendStatusUpdate(status);
+
+  AWAIT_READY(finishedStatus);
+  EXPECT_EQ(TASK_FINISHED, finishedStatus->state());
+
+  {
+    JSON::Object stats = Metrics();
+    EXPECT_EQ(0, stats.values["master/tasks_staging"]);
+    EXPECT_EQ(0, stats.values["master/tasks_running"]);
+    EXPECT_EQ(1, stats.values["master/tasks_finished"]);
+  }
+
+  EXPECT_CALL(exec, shutdown(_))
+    .Times(AtMost(1));
+
+  driver.stop();
+  driver.join();
+}
+
+
+// This test verifies that a task which is killed while it is pending
+// authorization is no longer counted as staging.
+TEST_F(MasterTest, TaskMetricsAfterPendingTaskKilled)
+{
+  MockAuthorizer authorizer;
+  Try<Owned<cluster::Master>> master = StartMaster(&authorizer);
+  ASSERT_SOME(master);
+
+  Owned<MasterDetector> detector = master.get()->createDetector();
+  Try<Owned<cluster::Slave>> slave = StartSlave(detector.get());
+  ASSERT_SOME(slave);
+
+  MockScheduler sched;
+  MesosSchedulerDriver driver(
+      &sched, DEFAULT_FRAMEWORK_INFO, master.get()->pid, DEFAULT_CREDENTIAL);
+
+  EXPECT_CALL(sched, registered(&driver, _, _));
+
+  Future<vector<Offer>> offers;
+  EXPECT_CALL(sched, resourceOffers(&driver, _))
+    .WillOnce(FutureArg<1>(&offers))
+    .WillRepeatedly(Return()); // Ignore subsequent offers.
+
+  driver.start();
+
+  AWAIT_READY(offers);
+  ASSERT_FALSE(offers->empty());
+
+  TaskInfo task = createTask(offers.get()[0], "sleep 100");
+
+  // Return a pending future from the authorizer.
+  Future<Nothing> authorize;
+  Promise<bool> promise;
+  EXPECT_CALL(authorizer, authorized(_))
+    .WillOnce(DoAll(FutureSatisfy(&authorize),
+                    Return(promise.future())));
+
+  driver.launchTasks(offers.get()[0].id(), {task});
+
+  // Wait until authorization is in progress.
+  AWAIT_READY(authorize);
+
+  {
+    JSON::Object stats = Metrics();
+    EXPECT_EQ(1, stats.values["master/tasks_staging"]);
+    EXPECT_EQ(0, stats.values["master/tasks_running"]);
+  }
+
+  Future<TaskStatus> status;
+  EXPECT_CALL(sched, statusUpdate(&driver, _))
+    .WillOnce(FutureArg<1>(&status));
+
+  driver.killTask(task.task_id());
+
+  AWAIT_READY(status);
+  EXPECT_EQ(TASK_KILLED, status->state());
+  EXPECT_EQ(TaskStatus::REASON_TASK_KILLED_DURING_LAUNCH, status->reason());
+
+  {
+    JSON::Object stats = Metrics();
+    EXPECT_EQ(0, stats.values["master/tasks_staging"]);
+    EXPECT_EQ(0, stats.values["master/tasks_running"]);
+  }
+
+  Future<Nothing> recoverResources =
+    FUTURE_DISPATCH(_, &MesosAllocatorProcess::recoverResources);
+
+  // Completing the authorization must not count the task again.
+  promise.set(true);
+
+  AWAIT_READY(recoverResources);
+
+  {
+    JSON::Object stats = Metrics();
+    EXPECT_EQ(0, stats.values["master/tasks_staging"]);
+    EXPECT_EQ(0, stats.values["master/tasks_running"]);
+  }
+
+  driver.stop();
+  driver.join();
+}
+
+
 // Ensures that an empty response arrives if information about
 // registered slaves is requested from a master where no slaves
 // have been registered.
@@ -4242,6 +4408,278 @@ TEST_F(MasterTest, TasksEndpoint)
 }
 
 
+// This tests the cursor based pagination, the task state filter and
+// the field projection of the /tasks endpoint.
+TEST_F(MasterTest, TasksEndpointPagination)
+{
+  master::Flags masterFlags = CreateMasterFlags();
+  Try<Owned<cluster::Master>> master = StartMaster(masterFlags);
+  ASSERT_SOME(master);
+
+  MockExecutor exec(DEFAULT_EXECUTOR_ID);
+  TestContainerizer containerizer(&exec);
+
+  Owned<MasterDetector> detector = master.get()->createDetector();
+  Try<Owned<cluster::Slave>> slave = StartSlave(detector.get(), &containerizer);
+  ASSERT_SOME(slave);
+
+  MockScheduler sched;
+  MesosSchedulerDriver driver(
+      &sched, DEFAULT_FRAMEWORK_INFO, master.get()->pid, DEFAULT_CREDENTIAL);
+
+  EXPECT_CALL(sched, registered(&driver, _, _));
+
+  process::Queue<Offer> offers;
+  EXPECT_CALL(sched, resourceOffers(&driver, _))
+    .WillRepeatedly(EnqueueOffers(&offers));
+
+  driver.start();
+
+  Future<Offer> offer = offers.get();
+  AWAIT_READY(offer);
+
+  // Launch three tasks.
+  vector<TaskInfo> tasks;
+  for (int i = 1; i <= 3; i++) {
+    TaskInfo task;
+    task.set_name("test" + stringify(i));
+    task.mutable_task_id()->set_value(stringify(i));
+    task.mutable_slave_id()->MergeFrom(offer->slave_id());
+    task.mutable_resources()->MergeFrom(
+        Resources::parse("cpus:0.1;mem:12").get());
+    task.mutable_executor()->MergeFrom(DEFAULT_EXECUTOR_INFO);
+
+    tasks.push_back(task);
+  }
+
+  EXPECT_CALL(exec, registered(_, _, _, _));
+
+  EXPECT_CALL(exec, launchTask(_, _))
+    .WillRepeatedly(SendStatusUpdateFromTask(TASK_RUNNING));
+
+  Future<TaskStatus> status1, status2, status3;
+  EXPECT_CALL(sched, statusUpdate(&driver, _))
+    .WillOnce(FutureArg<1>(&status1))
+    .WillOnce(FutureArg<1>(&status2))
+    .WillOnce(FutureArg<1>(&status3));
+
+  driver.launchTasks(offer->id(), tasks);
+
+  AWAIT_READY(status1);
+  AWAIT_READY(status2);
+  AWAIT_READY(status3);
+
+  // Page through all tasks one at a time using the cursor.
+  set<string> taskIds;
+  Option<string> cursor;
+  for (int page = 0; page < 3; page++) {
+    string query = "tasks?limit=1;fields=id,state";
+    if (cursor.isSome()) {
+      query += ";cursor=" + cursor.get();
+    }
+
+    Future<Response> response = process::http::get(
+        master.get()->pid,
+        query,
+        None(),
+        createBasicAuthHeaders(DEFAULT_CREDENTIAL));
+
+    AWAIT_EXPECT_RESPONSE_STATUS_EQ(OK().status, response);
+
+    Try<JSON::Object> object = JSON::parse<JSON::Object>(response->body);
+    ASSERT_SOME(object);
+
+    Result<JSON::Array> array = object->find<JSON::Array>("tasks");
+    ASSERT_SOME(array);
+    ASSERT_EQ(1u, array->values.size());
+
+    // Only the requested fields are returned.
+    JSON::Object task = array->values[0].as<JSON::Object>();
+    EXPECT_EQ(2u, task.values.size());
+    EXPECT_EQ(JSON::String("TASK_RUNNING"), task.values["state"]);
+
+    ASSERT_TRUE(task.values["id"].is<JSON::String>());
+    taskIds.insert(task.values["id"].as<JSON::String>().value);
+
+    Result<JSON::String> nextCursor =
+      object->find<JSON::String>("next_cursor");
+
+    if (page < 2) {
+      ASSERT_SOME(nextCursor);
+      cursor = nextCursor->value;
+    } else {
+      EXPECT_NONE(nextCursor);
+    }
+  }
+
+  EXPECT_EQ(set<string>({"1", "2", "3"}), taskIds);
+
+  // No task is in state TASK_FINISHED.
+  {
+    Future<Response> response = process::http::get(
+        master.get()->pid,
+        "tasks?state=TASK_FINISHED",
+        None(),
+        createBasicAuthHeaders(DEFAULT_CREDENTIAL));
+
+    AWAIT_EXPECT_RESPONSE_STATUS_EQ(OK().status, response);
+
+    Try<JSON::Object> object = JSON::parse<JSON::Object>(response->body);
+    ASSERT_SOME(object);
+
+    Result<JSON::Array> array = object->find<JSON::Array>("tasks");
+    ASSERT_SOME(array);
+    EXPECT_TRUE(array->values.empty());
+  }
+
+  // Malformed cursors and unknown states are rejected.
+  {
+    Future<Response> response = process::http::get(
+        master.get()->pid,
+        "tasks?cursor=foo",
+        None(),
+        createBasicAuthHeaders(DEFAULT_CREDENTIAL));
+
+    AWAIT_EXPECT_RESPONSE_STATUS_EQ(BadRequest().status, response);
+
+    response = process::http::get(
+        master.get()->pid,
+        "tasks?state=TASK_FOO",
+        None(),
+        createBasicAuthHeaders(DEFAULT_CREDENTIAL));
+
+    AWAIT_EXPECT_RESPONSE_STATUS_EQ(BadRequest().status, response);
+  }
+
+  EXPECT_CALL(exec, shutdown(_))
+    .Times(AtMost(1));
+
+  driver.stop();
+  driver.join();
+}
+
+
+// This tests that the /tasks endpoint pages through completed tasks,
+// which are only materialized if they are part of the response.
+TEST_F(MasterTest, TasksEndpointCompletedTasksPagination)
+{
+  Try<Owned<cluster::Master>> master = StartMaster();
+  ASSERT_SOME(master);
+
+  MockExecutor exec(DEFAULT_EXECUTOR_ID);
+  TestContainerizer containerizer(&exec);
+
+  Owned<MasterDetector> detector = master.get()->createDetector();
+  Try<Owned<cluster::Slave>> slave = StartSlave(detector.get(), &containerizer);
+  ASSERT_SOME(slave);
+
+  MockScheduler sched;
+  MesosSchedulerDriver driver(
+      &sched, DEFAULT_FRAMEWORK_INFO, master.get()->pid, DEFAULT_CREDENTIAL);
+
+  EXPECT_CALL(sched, registered(&driver, _, _));
+
+  process::Queue<Offer> offers;
+  EXPECT_CALL(sched, resourceOffers(&driver, _))
+    .WillRepeatedly(EnqueueOffers(&offers));
+
+  driver.start();
+
+  Future<Offer> offer = offers.get();
+  AWAIT_READY(offer);
+
+  // Launch three tasks which finish right away.
+  vector<TaskInfo> tasks;
+  for (int i = 1; i <= 3; i++) {
+    TaskInfo task;
+    task.set_name("test" + stringify(i));
+    task.mutable_task_id()->set_value(stringify(i));
+    task.mutable_slave_id()->MergeFrom(offer->slave_id());
+    task.mutable_resources()->MergeFrom(
+        Resources::parse("cpus:0.1;mem:12").get());
+    task.mutable_executor()->MergeFrom(DEFAULT_EXECUTOR_INFO);
+
+    tasks.push_back(task);
+  }
+
+  EXPECT_CALL(exec, registered(_, _, _, _));
+
+  EXPECT_CALL(exec, launchTask(_, _))
+    .WillRepeatedly(SendStatusUpdateFromTask(TASK_FINISHED));
+
+  // The master completes the tasks once their terminal status updates
+  // are acknowledged.
+  Future<Nothing> statusUpdateAck1 = FUTURE_DISPATCH(
+      slave.get()->pid, &Slave::_statusUpdateAcknowledgement);
+  Future<Nothing> statusUpdateAck2 = FUTURE_DISPATCH(
+      slave.get()->pid, &Slave::_statusUpdateAcknowledgement);
+  Future<Nothing> statusUpdateAck3 = FUTURE_DISPATCH(
+      slave.get()->pid, &Slave::_statusUpdateAcknowledgement);
+
+  EXPECT_CALL(sched, statusUpdate(&driver, _))
+    .WillRepeatedly(Return());
+
+  driver.launchTasks(offer->id(), tasks);
+
+  AWAIT_READY(statusUpdateAck1);
+  AWAIT_READY(statusUpdateAck2);
+  AWAIT_READY(statusUpdateAck3);
+
+  // Skip the first task, then page through the remaining ones using the
+  // cursor.
+  vector<string> taskIds;
+  Option<string> cursor;
+  for (int page = 0; page < 2; page++) {
+    string query = "tasks?limit=1;order=asc;fields=id,state";
+    if (cursor.isSome()) {
+      query += ";cursor=" + cursor.get();
+    } else {
+      query += ";offset=1";
+    }
+
+    Future<Response> response = process::http::get(
+        master.get()->pid,
+        query,
+        None(),
+        createBasicAuthHeaders(DEFAULT_CREDENTIAL));
+
+    AWAIT_EXPECT_RESPONSE_STATUS_EQ(OK().status, response);
+
+    Try<JSON::Object> object = JSON::parse<JSON::Object>(response->body);
+    ASSERT_SOME(object);
+
+    Result<JSON::Array> array = object->find<JSON::Array>("tasks");
+    ASSERT_SOME(array);
+    ASSERT_EQ(1u, array->values.size());
+
+    JSON::Object task = array->values[0].as<JSON::Object>();
+    EXPECT_EQ(JSON::String("TASK_FINISHED"), task.values["state"]);
+
+    ASSERT_TRUE(task.values["id"].is<JSON::String>());
+    taskIds.push_back(task.values["id"].as<JSON::String>().value);
+
+    Result<JSON::String> nextCursor =
+      object->find<JSON::String>("next_cursor");
+
+    if (page < 1) {
+      ASSERT_SOME(nextCursor);
+      cursor = nextCursor->value;
+    } else {
+      EXPECT_NONE(nextCursor);
+    }
+  }
+
+  ASSERT_EQ(2u, taskIds.size());
+  EXPECT_NE(taskIds[0], taskIds[1]);
+
+  EXPECT_CALL(exec, shutdown(_))
+    .Times(AtMost(1));
+
+  driver.stop();
+  driver.join();
+}
+
+
 // This test verifies that the master will strip ephemeral ports
 // resource from offers so that frameworks cannot see it.
 TEST_F(MasterTest, IgnoreEphemeralPortsResource)
@@ -4779,6 +5217,198 @@ TEST_F(MasterTest, StateEndpoint)
 }
 
 
+// This test verifies that the '/state' endpoint only includes the
+// top level fields selected by the 'fields' query parameter.
+TEST_F(MasterTest, StateEndpointFields)
+{
+  Try<Owned<cluster::Master>> master = StartMaster();
+  ASSERT_SOME(master);
+
+  Future<Response> response = process::http::get(
+      master.get()->pid,
+      "state?fields=version,frameworks",
+      None(),
+      createBasicAuthHeaders(DEFAULT_CREDENTIAL));
+
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(OK().status, response);
+  AWAIT_EXPECT_RESPONSE_HEADER_EQ(APPLICATION_JSON, "Content-Type", response);
+
+  Try<JSON::Object> state = JSON::parse<JSON::Object>(response->body);
+  ASSERT_SOME(state);
+
+  EXPECT_EQ(2u, state->values.size());
+  EXPECT_EQ(MESOS_VERSION, state->values["version"]);
+
+  ASSERT_TRUE(state->values["frameworks"].is<JSON::Array>());
+  EXPECT_TRUE(state->values["frameworks"].as<JSON::Array>().values.empty());
+}
+
+
+// This test verifies that the agents and frameworks of the master's
+// `/state` endpoint can be paginated using the `limit` and `cursor`
+// query parameters.
+TEST_F(MasterTest, StateEndpointPagination)
+{
+  Try<Owned<cluster::Master>> master = StartMaster();
+  ASSERT_SOME(master);
+
+  Owned<MasterDetector> detector = master.get()->createDetector();
+
+  Future<SlaveRegisteredMessage> slaveRegisteredMessage1 =
+    FUTURE_PROTOBUF(SlaveRegisteredMessage(), _, _);
+
+  Try<Owned<cluster::Slave>> slave1 = StartSlave(detector.get());
+  ASSERT_SOME(slave1);
+
+  AWAIT_READY(slaveRegisteredMessage1);
+
+  Future<SlaveRegisteredMessage> slaveRegisteredMessage2 =
+    FUTURE_PROTOBUF(SlaveRegisteredMessage(), _, _);
+
+  // Create new Flags as we require another work_dir for checkpoints.
+  slave::Flags flags2 = CreateSlaveFlags();
+
+  Try<Owned<cluster::Slave>> slave2 = StartSlave(detector.get(), flags2);
+  ASSERT_SOME(slave2);
+
+  AWAIT_READY(slaveRegisteredMessage2);
+
+  // A limit must be positive.
+  Future<Response> response = process::http::get(
+      master.get()->pid,
+      "state?limit=0",
+      None(),
+      createBasicAuthHeaders(DEFAULT_CREDENTIAL));
+
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(BadRequest().status, response);
+
+  response = process::http::get(
+      master.get()->pid,
+      "state?limit=1&fields=slaves,frameworks",
+      None(),
+      createBasicAuthHeaders(DEFAULT_CREDENTIAL));
+
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(OK().status, response);
+
+  Try<JSON::Object> state = JSON::parse<JSON::Object>(response->body);
+  ASSERT_SOME(state);
+
+  Result<JSON::Array> slaves = state->at<JSON::Array>("slaves");
+  ASSERT_SOME(slaves);
+  ASSERT_EQ(1u, slaves->values.size());
+
+  Result<JSON::String> id1 = slaves->values[0].as<JSON::Object>()
+    .at<JSON::String>("id");
+  ASSERT_SOME(id1);
+
+  Result<JSON::Array> frameworks = state->at<JSON::Array>("frameworks");
+  ASSERT_SOME(frameworks);
+  EXPECT_TRUE(frameworks->values.empty());
+
+  Result<JSON::String> cursor = state->at<JSON::String>("next_cursor");
+  ASSERT_SOME(cursor);
+
+  // The next page contains the other agent and is the last one.
+  response = process::http::get(
+      master.get()->pid,
+      "state?limit=1&fields=slaves,frameworks&cursor=" + cursor->value,
+      None(),
+      createBasicAuthHeaders(DEFAULT_CREDENTIAL));
+
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(OK().status, response);
+
+  state = JSON::parse<JSON::Object>(response->body);
+  ASSERT_SOME(state);
+
+  slaves = state->at<JSON::Array>("slaves");
+  ASSERT_SOME(slaves);
+  ASSERT_EQ(1u, slaves->values.size());
+
+  Result<JSON::String> id2 = slaves->values[0].as<JSON::Object>()
+    .at<JSON::String>("id");
+  ASSERT_SOME(id2);
+
+  EXPECT_NE(id1->value, id2->value);
+  EXPECT_EQ(0u, state->values.count("next_cursor"));
+
+  // An invalid cursor is rejected.
+  response = process::http::get(
+      master.get()->pid,
+      "state?cursor=invalid",
+      None(),
+      createBasicAuthHeaders(DEFAULT_CREDENTIAL));
+
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(BadRequest().status, response);
+}
+
+
+// This test verifies that the master's `/state-summary` responses carry
+// an `ETag` and that conditional requests are answered with `304 Not
+// Modified` until the state of the master changes.
+TEST_F(MasterTest, StateSummaryEndpointNotModified)
+{
+  Try<Owned<cluster::Master>> master = StartMaster();
+  ASSERT_SOME(master);
+
+  process::http::Headers headers = createBasicAuthHeaders(DEFAULT_CREDENTIAL);
+
+  Future<Response> response = process::http::get(
+      master.get()->pid,
+      "state-summary",
+      None(),
+      headers);
+
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(OK().status, response);
+  ASSERT_TRUE(response->headers.contains("ETag"));
+
+  const string etag = response->headers.at("ETag");
+
+  headers["If-None-Match"] = etag;
+
+  response = process::http::get(
+      master.get()->pid,
+      "state-summary",
+      None(),
+      headers);
+
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(
+      process::http::Status::string(process::http::Status::NOT_MODIFIED),
+      response);
+
+  EXPECT_TRUE(response->body.empty());
+  AWAIT_EXPECT_RESPONSE_HEADER_EQ(etag, "ETag", response);
+
+  // Registering an agent changes the state of the master, hence the
+  // cached response must not be served anymore.
+  Owned<MasterDetector> detector = master.get()->createDetector();
+
+  Future<SlaveRegisteredMessage> slaveRegisteredMessage =
+    FUTURE_PROTOBUF(SlaveRegisteredMessage(), _, _);
+
+  Try<Owned<cluster::Slave>> slave = StartSlave(detector.get());
+  ASSERT_SOME(slave);
+
+  AWAIT_READY(slaveRegisteredMessage);
+
+  response = process::http::get(
+      master.get()->pid,
+      "state-summary",
+      None(),
+      headers);
+
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(OK().status, response);
+  ASSERT_TRUE(response->headers.contains("ETag"));
+  EXPECT_NE(etag, response->headers.at("ETag"));
+
+  Try<JSON::Object> stateSummary = JSON::parse<JSON::Object>(response->body);
+  ASSERT_SOME(stateSummary);
+
+  Result<JSON::Array> slaves = stateSummary->at<JSON::Array>("slaves");
+  ASSERT_SOME(slaves);
+  EXPECT_EQ(1u, slaves->values.size());
+}
+
+
 // This test ensures that the framework's information is included in
 // the master's state endpoint.
 //
@@ -5596,6 +6226,117 @@ TEST_F(MasterTest, TaskStatusLabels)
 }
 
 
+// This test verifies that the master only collapses consecutive
+// statuses of the same state, so that a task which returns to an
+// earlier state keeps its first status.
+TEST_F(MasterTest, TaskStatusesKeepNonConsecutiveStates)
+{
+  Try<Owned<cluster::Master>> master = StartMaster();
+  ASSERT_SOME(master);
+
+  MockExecutor exec(DEFAULT_EXECUTOR_ID);
+  TestContainerizer containerizer(&exec);
+
+  Owned<MasterDetector> detector = master.get()->createDetector();
+  Try<Owned<cluster::Slave>> slave = StartSlave(detector.get(), &containerizer);
+  ASSERT_SOME(slave);
+
+  MockScheduler sched;
+  MesosSchedulerDriver driver(
+      &sched, DEFAULT_FRAMEWORK_INFO, master.get()->pid, DEFAULT_CREDENTIAL);
+
+  EXPECT_CALL(sched, registered(&driver, _, _));
+
+  Future<vector<Offer>> offers;
+  EXPECT_CALL(sched, resourceOffers(&driver, _))
+    .WillOnce(FutureArg<1>(&offers))
+    .WillRepeatedly(Return()); // Ignore subsequent offers.
+
+  driver.start();
+
+  AWAIT_READY(offers);
+  ASSERT_FALSE(offers->empty());
+
+  TaskInfo task = createTask(offers.get()[0], "sleep 100", DEFAULT_EXECUTOR_ID);
+
+  ExecutorDriver* execDriver;
+  EXPECT_CALL(exec, registered(_, _, _, _))
+    .WillOnce(SaveArg<0>(&execDriver));
+
+  Future<TaskInfo> execTask;
+  EXPECT_CALL(exec, launchTask(_, _))
+    .WillOnce(FutureArg<1>(&execTask));
+
+  Future<TaskStatus> status1;
+  Future<TaskStatus> status2;
+  Future<TaskStatus> status3;
+  Future<TaskStatus> status4;
+  EXPECT_CALL(sched, statusUpdate(&driver, _))
+    .WillOnce(FutureArg<1>(&status1))
+    .WillOnce(FutureArg<1>(&status2))
+    .WillOnce(FutureArg<1>(&status3))
+    .WillOnce(FutureArg<1>(&status4));
+
+  driver.launchTasks(offers.get()[0].id(), {task});
+
+  AWAIT_READY(execTask);
+
+  // The task goes RUNNING -> STARTING -> RUNNING -> RUNNING. Only the
+  // last two statuses are consecutive duplicates.
+  TaskStatus status;
+  status.mutable_task_id()->MergeFrom(execTask->task_id());
+
+  status.set_state(TASK_RUNNING);
+  execDriver->sendStatusUpdate(status);
+  AWAIT_READY(status1);
+
+  status.set_state(TASK_STARTING);
+  execDriver->sendStatusUpdate(status);
+  AWAIT_READY(status2);
+
+  status.set_state(TASK_RUNNING);
+  execDriver->sendStatusUpdate(status);
+  AWAIT_READY(status3);
+
+  execDriver->sendStatusUpdate(status);
+  AWAIT_READY(status4);
+
+  Future<Response> response = process::http::get(
+      master.get()->pid,
+      "tasks",
+      None(),
+      createBasicAuthHeaders(DEFAULT_CREDENTIAL));
+
+  AWAIT_EXPECT_RESPONSE_STATUS_EQ(OK().status, response);
+  AWAIT_EXPECT_RESPONSE_HEADER_EQ(APPLICATION_JSON, "Content-Type", response);
+
+  Try<JSON::Object> parse = JSON::parse<JSON::Object>(response->body);
+  ASSERT_SOME(parse);
+
+  Result<JSON::Array> statuses =
+    parse->find<JSON::Array>("tasks[0].statuses");
+
+  ASSERT_SOME(statuses);
+  ASSERT_EQ(3u, statuses->values.size());
+
+  EXPECT_SOME_EQ(
+      JSON::String("TASK_RUNNING"),
+      parse->find<JSON::String>("tasks[0].statuses[0].state"));
+  EXPECT_SOME_EQ(
+      JSON::String("TASK_STARTING"),
+      parse->find<JSON::String>("tasks[0].statuses[1].state"));
+  EXPECT_SOME_EQ(
+      JSON::String("TASK_RUNNING"),
+      parse->find<JSON::String>("tasks[0].statuses[2].state"));
+
+  EXPECT_CALL(exec, shutdown(_))
+    .Times(AtMost(1));
+
+  driver.stop();
+  driver.join();
+}
+
+
 // This test verifies that TaskStatus::container_status is exposed over the
 // master state endpoint.
 TEST_F(MasterTest, TaskStatusContainerStatus)
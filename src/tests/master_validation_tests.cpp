@@ -34,6 +34,7 @@
 
 #include <stout/gtest.hpp>
 #include <stout/none.hpp>
+#include <stout/stopwatch.hpp>
 #include <stout/strings.hpp>
 #include <stout/uuid.hpp>
 
@@ -69,6 +70,8 @@ using process::Message;
 using process::Owned;
 using process::PID;
 
+using std::cout;
+using std::endl;
 using std::string;
 using std::vector;
 
@@ -76,6 +79,7 @@ using testing::_;
 using testing::AtMost;
 using testing::Eq;
 using testing::Return;
+using testing::WithParamInterface;
 
 namespace mesos {
 namespace internal {
@@ -1736,6 +1740,77 @@ TEST_F(TaskValidationTest, TaskUsesNoResources)
 }
 
 
+// This test verifies that the error of invalid task resources, which
+// the master caches per framework, is also returned for a second task
+// with the same resources.
+TEST_F(TaskValidationTest, TaskUsesCachedInvalidResources)
+{
+  Try<Owned<cluster::Master>> master = StartMaster();
+  ASSERT_SOME(master);
+
+  Owned<MasterDetector> detector = master.get()->createDetector();
+  Try<Owned<cluster::Slave>> slave = StartSlave(detector.get());
+  ASSERT_SOME(slave);
+
+  MockScheduler sched;
+  MesosSchedulerDriver driver(
+      &sched, DEFAULT_FRAMEWORK_INFO, master.get()->pid, DEFAULT_CREDENTIAL);
+
+  EXPECT_CALL(sched, registered(&driver, _, _));
+
+  Future<vector<Offer>> offers;
+  EXPECT_CALL(sched, resourceOffers(&driver, _))
+    .WillOnce(FutureArg<1>(&offers))
+    .WillRepeatedly(Return()); // Ignore subsequent offers.
+
+  driver.start();
+
+  AWAIT_READY(offers);
+  ASSERT_FALSE(offers->empty());
+
+  Resource cpus;
+  cpus.set_name("cpus");
+  cpus.set_type(Value::SCALAR);
+  cpus.mutable_scalar()->set_value(-1);
+
+  TaskInfo task1;
+  task1.set_name("");
+  task1.mutable_task_id()->set_value("1");
+  task1.mutable_slave_id()->MergeFrom(offers.get()[0].slave_id());
+  task1.mutable_command()->set_value("exit 0");
+  task1.add_resources()->CopyFrom(cpus);
+
+  TaskInfo task2 = task1;
+  task2.mutable_task_id()->set_value("2");
+
+  Future<TaskStatus> status1;
+  Future<TaskStatus> status2;
+  EXPECT_CALL(sched, statusUpdate(&driver, _))
+    .WillOnce(FutureArg<1>(&status1))
+    .WillOnce(FutureArg<1>(&status2));
+
+  driver.launchTasks(offers.get()[0].id(), {task1, task2});
+
+  AWAIT_READY(status1);
+  AWAIT_READY(status2);
+
+  EXPECT_NE(status1->task_id().value(), status2->task_id().value());
+
+  EXPECT_EQ(TASK_ERROR, status1->state());
+  EXPECT_EQ(TaskStatus::REASON_TASK_INVALID, status1->reason());
+  EXPECT_TRUE(strings::startsWith(
+      status1->message(), "Task uses invalid resources")) << status1->message();
+
+  // The second task is rejected with the cached error.
+  EXPECT_EQ(TASK_ERROR, status2->state());
+  EXPECT_EQ(TaskStatus::REASON_TASK_INVALID, status2->reason());
+  EXPECT_EQ(status1->message(), status2->message());
+
+  driver.stop();
+  driver.join();
+}
+
+
 TEST_F(TaskValidationTest, TaskUsesMoreResourcesThanOffered)
 {
   Try<Owned<cluster::Master>> master = StartMaster();
@@ -3587,6 +3662,106 @@ TEST_F(TaskGroupValidationTest, TaskEnvironmentInvalid)
 }
 
 
+class TaskGroupValidation_BENCHMARK_Test
+  : public MesosTest,
+    public WithParamInterface<size_t> {};
+
+
+INSTANTIATE_TEST_CASE_P(
+    TasksPerGroup,
+    TaskGroupValidation_BENCHMARK_Test,
+    ::testing::Values(10U, 100U, 1000U));
+
+
+// This test measures the time the master takes to validate and launch
+// a task group whose tasks all use the same resources, from accepting
+// the offer to sending the task group to the agent.
+TEST_P(TaskGroupValidation_BENCHMARK_Test, LaunchGroup)
+{
+  const size_t tasksPerGroup = GetParam();
+
+  Try<Owned<cluster::Master>> master = StartMaster();
+  ASSERT_SOME(master);
+
+  slave::Flags slaveFlags = CreateSlaveFlags();
+  slaveFlags.resources = "cpus:32;mem:8192;disk:8192";
+
+  Owned<MasterDetector> detector = master.get()->createDetector();
+  Try<Owned<cluster::Slave>> slave = StartSlave(detector.get(), slaveFlags);
+  ASSERT_SOME(slave);
+
+  MockScheduler sched;
+  MesosSchedulerDriver driver(
+      &sched, DEFAULT_FRAMEWORK_INFO, master.get()->pid, DEFAULT_CREDENTIAL);
+
+  Future<FrameworkID> frameworkId;
+  EXPECT_CALL(sched, registered(&driver, _, _))
+    .WillOnce(FutureArg<1>(&frameworkId));
+
+  Future<vector<Offer>> offers;
+  EXPECT_CALL(sched, resourceOffers(&driver, _))
+    .WillOnce(FutureArg<1>(&offers))
+    .WillRepeatedly(Return()); // Ignore subsequent offers.
+
+  driver.start();
+
+  AWAIT_READY(frameworkId);
+  AWAIT_READY(offers);
+  ASSERT_FALSE(offers->empty());
+
+  const Offer& offer = offers->front();
+
+  ExecutorInfo executor;
+  executor.mutable_executor_id()->set_value("default");
+  executor.set_type(ExecutorInfo::DEFAULT);
+  executor.mutable_framework_id()->CopyFrom(frameworkId.get());
+  executor.mutable_resources()->CopyFrom(allocatedResources(
+      Resources::parse("cpus:0.1;mem:32;disk:32").get(),
+      DEFAULT_FRAMEWORK_INFO.roles(0)));
+
+  const Resources resources = allocatedResources(
+      Resources::parse("cpus:0.01;mem:1").get(),
+      DEFAULT_FRAMEWORK_INFO.roles(0));
+
+  TaskGroupInfo taskGroup;
+  for (size_t i = 0; i < tasksPerGroup; i++) {
+    TaskInfo* task = taskGroup.add_tasks();
+    task->set_name(stringify(i));
+    task->mutable_task_id()->set_value(stringify(i));
+    task->mutable_slave_id()->CopyFrom(offer.slave_id());
+    task->mutable_resources()->CopyFrom(resources);
+    task->mutable_command()->set_value("sleep 1000");
+  }
+
+  // Drop the task group so that the agent does not launch it.
+  Future<RunTaskGroupMessage> runTaskGroupMessage =
+    DROP_PROTOBUF(RunTaskGroupMessage(), _, _);
+
+  cout << "Launching a task group with " << tasksPerGroup << " tasks" << endl;
+
+  Stopwatch watch;
+  watch.start();
+
+  driver.acceptOffers(
+      {offer.id()},
+      {LAUNCH_GROUP(executor, taskGroup)});
+
+  AWAIT_READY(runTaskGroupMessage);
+
+  watch.stop();
+
+  EXPECT_EQ(
+      static_cast<int>(tasksPerGroup),
+      runTaskGroupMessage->task_group().tasks_size());
+
+  cout << "Validated and launched " << tasksPerGroup << " tasks in "
+       << watch.elapsed() << endl;
+
+  driver.stop();
+  driver.join();
+}
+
+
 class FrameworkInfoValidationTest : public MesosTest {};
 
 
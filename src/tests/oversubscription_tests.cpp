@@ -44,8 +44,11 @@
 
 #include "slave/flags.hpp"
 #include "slave/slave.hpp"
+#include "slave/qos_controllers/contention.hpp"
 #include "slave/qos_controllers/load.hpp"
 
+#include "slave/resource_estimators/usage.hpp"
+
 #include "tests/flags.hpp"
 #include "tests/containerizer.hpp"
 #include "tests/mesos.hpp"
@@ -59,8 +62,10 @@ using mesos::internal::master::Master;
 
 using mesos::internal::protobuf::createLabel;
 
+using mesos::internal::slave::ContentionQoSController;
 using mesos::internal::slave::LoadQoSController;
 using mesos::internal::slave::Slave;
+using mesos::internal::slave::UsageResourceEstimator;
 
 using mesos::master::detector::MasterDetector;
 using mesos::master::detector::StandaloneMasterDetector;
@@ -1507,6 +1512,251 @@ TEST_F(OversubscriptionTest, LoadQoSController)
 }
 
 
+// This test verifies that the contention QoS controller evicts only
+// the revocable executor using the most of the contended resource,
+// and only while a non-revocable executor shows contention:
+// 1. No contention is reported. No eviction should appear.
+// 2. The non-revocable executor reports cpu pressure above the
+//    threshold. The revocable executor which used the most cpu since
+//    the previous round should be evicted.
+// 3. The non-revocable executor is throttled in more than the
+//    configured ratio of cpu periods. The same executor is evicted.
+// 4. The non-revocable executor reports memory pressure above the
+//    threshold. The revocable executor using the most memory should
+//    be evicted.
+TEST_F(OversubscriptionTest, ContentionQoSController)
+{
+  const double cpuPressureThreshold = 20;
+  const double memoryPressureThreshold = 10;
+  const double throttledRatioThreshold = 0.3;
+
+  ContentionQoSController controller(
+      cpuPressureThreshold,
+      memoryPressureThreshold,
+      throttledRatioThreshold);
+
+  ResourceUsage usage;
+
+  // Prepare a non-revocable executor.
+  ResourceUsage::Executor* executor = usage.add_executors();
+  executor->mutable_executor_info()->CopyFrom(
+      createExecutorInfo("framework", "executor1"));
+  executor->mutable_allocated()->CopyFrom(
+      Resources::parse("cpus:2;mem:512").get());
+  executor->mutable_statistics()->CopyFrom(createResourceStatistics());
+
+  // Prepare two revocable executors. The first uses more memory and
+  // the second uses more cpu.
+  Resources resources = Resources::parse("mem:128").get();
+  resources += createRevocableResources("cpus", "1");
+
+  executor = usage.add_executors();
+  executor->mutable_executor_info()->CopyFrom(
+      createExecutorInfo("framework", "executor2"));
+  executor->mutable_allocated()->CopyFrom(resources);
+  executor->mutable_statistics()->CopyFrom(createResourceStatistics());
+  executor->mutable_statistics()->set_mem_total_bytes(Megabytes(100).bytes());
+
+  executor = usage.add_executors();
+  executor->mutable_executor_info()->CopyFrom(
+      createExecutorInfo("framework", "executor3"));
+  executor->mutable_allocated()->CopyFrom(resources);
+  executor->mutable_statistics()->CopyFrom(createResourceStatistics());
+  executor->mutable_statistics()->set_mem_total_bytes(Megabytes(10).bytes());
+
+  controller.initialize([&usage]() -> Future<ResourceUsage> {
+    return usage;
+  });
+
+  // Advances the synthetic usage by 10 seconds, in which 'executor2'
+  // uses 0.1 cpus and 'executor3' uses 1 cpu.
+  auto advance = [&usage]() {
+    for (int i = 0; i < usage.executors_size(); i++) {
+      ResourceStatistics* statistics =
+        usage.mutable_executors(i)->mutable_statistics();
+
+      statistics->set_timestamp(statistics->timestamp() + 10);
+      statistics->set_cpus_nr_periods(statistics->cpus_nr_periods() + 100);
+    }
+
+    ResourceStatistics* statistics =
+      usage.mutable_executors(1)->mutable_statistics();
+    statistics->set_cpus_user_time_secs(
+        statistics->cpus_user_time_secs() + 1);
+
+    statistics = usage.mutable_executors(2)->mutable_statistics();
+    statistics->set_cpus_user_time_secs(
+        statistics->cpus_user_time_secs() + 10);
+  };
+
+  // First correction iteration. There is no contention.
+  usage.mutable_executors(0)->mutable_statistics()
+    ->set_cpus_pressure_some_avg10(cpuPressureThreshold - 1);
+
+  Future<list<QoSCorrection>> qosCorrections = controller.corrections();
+  AWAIT_READY(qosCorrections);
+  EXPECT_TRUE(qosCorrections->empty());
+
+  // Second correction iteration. The non-revocable executor reports
+  // cpu pressure above the threshold.
+  advance();
+  usage.mutable_executors(0)->mutable_statistics()
+    ->set_cpus_pressure_some_avg10(cpuPressureThreshold + 1);
+
+  qosCorrections = controller.corrections();
+  AWAIT_READY(qosCorrections);
+  ASSERT_EQ(1u, qosCorrections->size());
+  EXPECT_EQ(mesos::slave::QoSCorrection::KILL, qosCorrections->front().type());
+  EXPECT_EQ("executor3",
+            qosCorrections->front().kill().executor_id().value());
+
+  // Third correction iteration. The non-revocable executor has no cpu
+  // pressure, but was throttled in half of the periods.
+  advance();
+  ResourceStatistics* statistics =
+    usage.mutable_executors(0)->mutable_statistics();
+  statistics->set_cpus_pressure_some_avg10(0);
+  statistics->set_cpus_nr_throttled(statistics->cpus_nr_throttled() + 50);
+
+  qosCorrections = controller.corrections();
+  AWAIT_READY(qosCorrections);
+  ASSERT_EQ(1u, qosCorrections->size());
+  EXPECT_EQ("executor3",
+            qosCorrections->front().kill().executor_id().value());
+
+  // Fourth correction iteration. The non-revocable executor reports
+  // memory pressure above the threshold.
+  advance();
+  statistics->set_mem_pressure_some_avg10(memoryPressureThreshold + 1);
+
+  qosCorrections = controller.corrections();
+  AWAIT_READY(qosCorrections);
+  ASSERT_EQ(1u, qosCorrections->size());
+  EXPECT_EQ("executor2",
+            qosCorrections->front().kill().executor_id().value());
+}
+
+
+// This test verifies that the usage resource estimator reports the
+// configured percentile of the unused resources of the non-revocable
+// executors once it has a full window of samples, less the revocable
+// resources already allocated.
+TEST_F(OversubscriptionTest, UsageResourceEstimator)
+{
+  // Use the minimum of the last 3 samples.
+  UsageResourceEstimator estimator(3, 0);
+
+  ResourceUsage usage;
+
+  // Prepare a non-revocable executor which uses 256MB of memory.
+  ResourceUsage::Executor* executor = usage.add_executors();
+  executor->mutable_executor_info()->CopyFrom(
+      createExecutorInfo("framework", "executor1"));
+  executor->mutable_allocated()->CopyFrom(
+      Resources::parse("cpus:4;mem:1024").get());
+
+  ResourceStatistics* statistics = executor->mutable_statistics();
+  statistics->set_timestamp(0);
+  statistics->set_cpus_user_time_secs(0);
+  statistics->set_cpus_system_time_secs(0);
+  statistics->set_mem_total_bytes(Megabytes(256).bytes());
+
+  // Prepare a revocable executor which is allocated 1 revocable cpu.
+  Resources resources = Resources::parse("mem:128").get();
+  resources += createRevocableResources("cpus", "1");
+
+  executor = usage.add_executors();
+  executor->mutable_executor_info()->CopyFrom(
+      createExecutorInfo("framework", "executor2"));
+  executor->mutable_allocated()->CopyFrom(resources);
+  executor->mutable_statistics()->CopyFrom(createResourceStatistics());
+
+  estimator.initialize([&usage]() -> Future<ResourceUsage> {
+    return usage;
+  });
+
+  // Advances the non-revocable executor by 1 second in which it uses
+  // the given amount of cpus.
+  auto advance = [statistics](double cpus) {
+    statistics->set_timestamp(statistics->timestamp() + 1);
+    statistics->set_cpus_user_time_secs(
+        statistics->cpus_user_time_secs() + cpus);
+  };
+
+  // The first sample only provides the memory usage.
+  Future<Resources> oversubscribable = estimator.oversubscribable();
+  AWAIT_READY(oversubscribable);
+  EXPECT_TRUE(oversubscribable->empty());
+
+  advance(1);
+  oversubscribable = estimator.oversubscribable();
+  AWAIT_READY(oversubscribable);
+  EXPECT_TRUE(oversubscribable->empty());
+
+  // The memory window is full, the cpu window has 2 samples.
+  advance(2);
+  oversubscribable = estimator.oversubscribable();
+  AWAIT_READY(oversubscribable);
+  EXPECT_EQ(createRevocableResources("mem", "768"), oversubscribable.get());
+
+  // The cpu window is full. The minimum of the unused cpus is 2, of
+  // which 1 is already allocated to the revocable executor.
+  advance(1);
+  oversubscribable = estimator.oversubscribable();
+  AWAIT_READY(oversubscribable);
+  EXPECT_EQ(
+      createRevocableResources("cpus", "1") +
+        createRevocableResources("mem", "768"),
+      oversubscribable.get());
+
+  // Once the non-revocable executor terminates, nothing is
+  // oversubscribable until a new window of samples is collected.
+  usage.mutable_executors()->DeleteSubrange(0, 1);
+
+  oversubscribable = estimator.oversubscribable();
+  AWAIT_READY(oversubscribable);
+  EXPECT_TRUE(oversubscribable->empty());
+}
+
+
+// This test verifies that the usage resource estimator does not treat
+// the cpus of an executor as unused if its statistics do not include
+// the cpu times.
+TEST_F(OversubscriptionTest, UsageResourceEstimatorWithoutCpuTimes)
+{
+  // Use the minimum of the last 2 samples.
+  UsageResourceEstimator estimator(2, 0);
+
+  ResourceUsage usage;
+
+  // Prepare an executor whose statistics only include its memory usage.
+  ResourceUsage::Executor* executor = usage.add_executors();
+  executor->mutable_executor_info()->CopyFrom(
+      createExecutorInfo("framework", "executor"));
+  executor->mutable_allocated()->CopyFrom(
+      Resources::parse("cpus:4;mem:1024").get());
+
+  ResourceStatistics* statistics = executor->mutable_statistics();
+  statistics->set_timestamp(0);
+  statistics->set_mem_total_bytes(Megabytes(256).bytes());
+
+  estimator.initialize([&usage]() -> Future<ResourceUsage> {
+    return usage;
+  });
+
+  for (int i = 0; i < 3; i++) {
+    statistics->set_timestamp(i);
+
+    Future<Resources> oversubscribable = estimator.oversubscribable();
+    AWAIT_READY(oversubscribable);
+
+    if (i > 0) {
+      EXPECT_EQ(createRevocableResources("mem", "768"), oversubscribable.get());
+    }
+  }
+}
+
+
 } // namespace tests {
 } // namespace internal {
 } // namespace mesos {
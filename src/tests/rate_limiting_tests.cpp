@@ -50,6 +50,7 @@ using process::PID;
 using std::string;
 
 using testing::_;
+using testing::AtMost;
 using testing::Eq;
 using testing::Return;
 
@@ -528,6 +529,17 @@ TEST_F_TEMP_DISABLED_ON_WINDOWS(RateLimitingTest, DifferentPrincipalFrameworks)
         2,
         metrics.values["frameworks/framework2/messages_processed"]
           .as<JSON::Number>().as<int64_t>());
+
+    // Messages are counted as throttled both for the RateLimiter of
+    // framework1's principal and for the default RateLimiter.
+    EXPECT_EQ(
+        2,
+        metrics.values["frameworks/framework1/messages_throttled"]
+          .as<JSON::Number>().as<int64_t>());
+    EXPECT_EQ(
+        2,
+        metrics.values["frameworks/framework2/messages_throttled"]
+          .as<JSON::Number>().as<int64_t>());
   }
 
   // 3. Remove a framework and its message counters are deleted while
@@ -1055,6 +1067,112 @@ TEST_F_TEMP_DISABLED_ON_WINDOWS(RateLimitingTest, CapacityReached)
       metrics.values[messages_processed].as<JSON::Number>().as<int64_t>());
 }
 
+
+// Verifies that calls from an HTTP framework go through the rate
+// limiter of its principal and are rejected once its capacity is
+// reached.
+TEST_F_TEMP_DISABLED_ON_WINDOWS(RateLimitingTest, HttpCapacityReached)
+{
+  master::Flags flags = CreateMasterFlags();
+  RateLimits limits;
+  RateLimit* limit = limits.mutable_limits()->Add();
+  limit->set_principal(DEFAULT_CREDENTIAL.principal());
+  limit->set_qps(1);
+  limit->set_capacity(2);
+  flags.rate_limits = limits;
+
+  Try<Owned<cluster::Master>> master = StartMaster(flags);
+  ASSERT_SOME(master);
+
+  Clock::pause();
+
+  auto scheduler = std::make_shared<v1::MockHTTPScheduler>();
+
+  EXPECT_CALL(*scheduler, connected(_))
+    .WillOnce(v1::scheduler::SendSubscribe(v1::DEFAULT_FRAMEWORK_INFO));
+
+  Future<v1::scheduler::Event::Subscribed> subscribed;
+  EXPECT_CALL(*scheduler, subscribed(_, _))
+    .WillOnce(FutureArg<1>(&subscribed));
+
+  EXPECT_CALL(*scheduler, heartbeat(_))
+    .WillRepeatedly(Return()); // Ignore heartbeats.
+
+  EXPECT_CALL(*scheduler, disconnected(_))
+    .Times(AtMost(1));
+
+  // A dropped call is answered with '503 Service Unavailable', which
+  // the scheduler library logs without surfacing an error.
+  EXPECT_CALL(*scheduler, error(_, _))
+    .Times(0);
+
+  v1::scheduler::TestMesos mesos(
+      master.get()->pid,
+      ContentType::PROTOBUF,
+      scheduler);
+
+  AWAIT_READY(subscribed);
+
+  v1::scheduler::Call call;
+  call.mutable_framework_id()->CopyFrom(subscribed->framework_id());
+  call.set_type(v1::scheduler::Call::REVIVE);
+
+  // The first call passes the limiter right away.
+  mesos.send(call);
+  Clock::settle();
+
+  // The next two calls fill up the capacity of the limiter and the
+  // last one is dropped.
+  for (int i = 0; i < 3; i++) {
+    mesos.send(call);
+  }
+  Clock::settle();
+
+  JSON::Object metrics = Metrics();
+
+  const string& messages_throttled =
+    "frameworks/" + DEFAULT_CREDENTIAL.principal() + "/messages_throttled";
+  EXPECT_EQ(1u, metrics.values.count(messages_throttled));
+  EXPECT_EQ(
+      3,
+      metrics.values[messages_throttled].as<JSON::Number>().as<int64_t>());
+
+  const string& messages_dropped =
+    "frameworks/" + DEFAULT_CREDENTIAL.principal() + "/messages_dropped";
+  EXPECT_EQ(1u, metrics.values.count(messages_dropped));
+  EXPECT_EQ(
+      1,
+      metrics.values[messages_dropped].as<JSON::Number>().as<int64_t>());
+
+  // Let the queued calls through. The scheduler library does not
+  // retry the dropped call, so it is neither throttled nor dropped
+  // again.
+  Clock::advance(Seconds(2));
+  Clock::settle();
+
+  metrics = Metrics();
+
+  EXPECT_EQ(
+      3,
+      metrics.values[messages_throttled].as<JSON::Number>().as<int64_t>());
+  EXPECT_EQ(
+      1,
+      metrics.values[messages_dropped].as<JSON::Number>().as<int64_t>());
+
+  // The subscription is not affected by the dropped call, and the
+  // framework can send further calls.
+  mesos.send(call);
+  Clock::settle();
+
+  metrics = Metrics();
+
+  EXPECT_EQ(
+      4,
+      metrics.values[messages_throttled].as<JSON::Number>().as<int64_t>());
+
+  Clock::resume();
+}
+
 } // namespace tests {
 } // namespace internal {
 } // namespace mesos {
@@ -30,10 +30,12 @@
 #include <process/pid.hpp>
 #include <process/process.hpp>
 
+#include <stout/stringify.hpp>
 #include <stout/uuid.hpp>
 
 #include "common/protobuf_utils.hpp"
 
+#include "master/constants.hpp"
 #include "master/flags.hpp"
 #include "master/master.hpp"
 #include "master/registry_operations.hpp"
@@ -275,6 +277,58 @@ TEST_F(ReconciliationTest, UnknownSlave)
 }
 
 
+// This test verifies that the master answers an explicit
+// reconciliation of more tasks than it sends in a single batch.
+TEST_F(ReconciliationTest, LargeExplicitReconciliation)
+{
+  Try<Owned<cluster::Master>> master = StartMaster();
+  ASSERT_SOME(master);
+
+  MockScheduler sched;
+  MesosSchedulerDriver driver(
+    &sched, DEFAULT_FRAMEWORK_INFO, master.get()->pid, DEFAULT_CREDENTIAL);
+
+  Future<FrameworkID> frameworkId;
+  EXPECT_CALL(sched, registered(&driver, _, _))
+    .WillOnce(FutureArg<1>(&frameworkId));
+
+  driver.start();
+
+  // Wait until the framework is registered.
+  AWAIT_READY(frameworkId);
+
+  // Reconcile enough unknown tasks to span three batches.
+  const size_t taskCount = 2 * master::RECONCILIATION_BATCH_SIZE + 1;
+
+  vector<TaskStatus> statuses;
+  for (size_t i = 0; i < taskCount; i++) {
+    TaskStatus status;
+    status.mutable_task_id()->set_value(stringify(i));
+    status.set_state(TASK_STAGING); // Dummy value.
+    statuses.push_back(status);
+  }
+
+  EXPECT_CALL(sched, statusUpdate(&driver, _))
+    .Times(taskCount - 1);
+
+  Future<TaskStatus> update;
+  EXPECT_CALL(
+      sched, statusUpdate(&driver, TaskStatusTaskIdEq(statuses.back())))
+    .WillOnce(FutureArg<1>(&update));
+
+  driver.reconcileTasks(statuses);
+
+  // Framework should receive TASK_LOST for the last task because it
+  // is not partition-aware and the task is unknown.
+  AWAIT_READY(update);
+  EXPECT_EQ(TASK_LOST, update->state());
+  EXPECT_EQ(TaskStatus::REASON_RECONCILIATION, update->reason());
+
+  driver.stop();
+  driver.join();
+}
+
+
 // This test verifies that reconciliation of an unknown task that
 // belongs to a known slave results in TASK_LOST if the framework is
 // not partition-aware.
@@ -351,6 +351,55 @@ TEST_F(RegistrarTest, MarkReachable)
 }
 
 
+// Verify that multiple slaves can be marked reachable with a single
+// operation, which preserves the order of the remaining unreachable
+// slaves.
+TEST_F(RegistrarTest, MarkReachableBatch)
+{
+  vector<SlaveInfo> infos;
+
+  {
+    Registrar registrar(flags, state);
+    AWAIT_READY(registrar.recover(master));
+
+    for (int i = 0; i < 4; i++) {
+      SlaveInfo info;
+      info.set_hostname("localhost");
+      info.mutable_id()->set_value(stringify(i));
+
+      AWAIT_TRUE(registrar.apply(Owned<RegistryOperation>(
+          new AdmitSlave(info))));
+
+      AWAIT_TRUE(registrar.apply(Owned<RegistryOperation>(
+          new MarkSlaveUnreachable(info, protobuf::getCurrentTime()))));
+
+      infos.push_back(info);
+    }
+
+    // Mark the slaves "0" and "2" reachable along with an unknown slave.
+    SlaveInfo unknown;
+    unknown.set_hostname("localhost");
+    unknown.mutable_id()->set_value("unknown");
+
+    AWAIT_TRUE(registrar.apply(Owned<RegistryOperation>(
+        new MarkSlaveReachable({infos[0], infos[2], unknown}))));
+  }
+
+  Registrar registrar(flags, state);
+  Future<Registry> registry = registrar.recover(master);
+  AWAIT_READY(registry);
+
+  ASSERT_EQ(3, registry->slaves().slaves().size());
+  EXPECT_EQ(infos[0].id(), registry->slaves().slaves(0).info().id());
+  EXPECT_EQ(infos[2].id(), registry->slaves().slaves(1).info().id());
+  EXPECT_EQ("unknown", registry->slaves().slaves(2).info().id().value());
+
+  ASSERT_EQ(2, registry->unreachable().slaves().size());
+  EXPECT_EQ(infos[1].id(), registry->unreachable().slaves(0).id());
+  EXPECT_EQ(infos[3].id(), registry->unreachable().slaves(1).id());
+}
+
+
 TEST_F(RegistrarTest, MarkUnreachable)
 {
   Registrar registrar(flags, state);
@@ -16,6 +16,8 @@
 
 #include <unistd.h>
 
+#include <iostream>
+#include <list>
 #include <string>
 
 #include <gtest/gtest.h>
@@ -37,12 +39,16 @@
 #include <process/owned.hpp>
 #include <process/reap.hpp>
 
+#include <stout/foreach.hpp>
+#include <stout/fs.hpp>
 #include <stout/hashset.hpp>
 #include <stout/none.hpp>
 #include <stout/numify.hpp>
 #include <stout/option.hpp>
 #include <stout/os.hpp>
 #include <stout/path.hpp>
+#include <stout/stopwatch.hpp>
+#include <stout/stringify.hpp>
 #include <stout/uuid.hpp>
 
 #include "common/protobuf_utils.hpp"
@@ -53,11 +59,13 @@
 
 #include "master/detector/standalone.hpp"
 
+#include "slave/checkpointer.hpp"
 #include "slave/gc.hpp"
 #include "slave/gc_process.hpp"
 #include "slave/paths.hpp"
 #include "slave/slave.hpp"
 #include "slave/state.hpp"
+#include "slave/task_status_update_manager.hpp"
 
 #include "slave/containerizer/containerizer.hpp"
 #include "slave/containerizer/fetcher.hpp"
@@ -89,6 +97,9 @@ using mesos::slave::ContainerTermination;
 
 using mesos::v1::executor::Call;
 
+using std::cout;
+using std::endl;
+using std::list;
 using std::map;
 using std::string;
 using std::vector;
@@ -152,6 +163,457 @@ TEST_F(SlaveStateTest, CheckpointRepeatedProtobufMessages)
   EXPECT_SOME_EQ(expected, actual);
 }
 
+TEST_F(SlaveStateTest, Checkpointer)
+{
+  slave::Checkpointer checkpointer;
+
+  SlaveID slaveId;
+  slaveId.set_value("agent1");
+
+  // Checkpoints issued together are committed as one batch, and
+  // checkpoints to the same path are applied in order.
+  Future<Nothing> checkpoint1 = checkpointer.checkpoint("dir/id", slaveId);
+  Future<Nothing> checkpoint2 = checkpointer.checkpoint("dir/test", "old");
+  Future<Nothing> checkpoint3 = checkpointer.checkpoint("dir/test", "new");
+
+  AWAIT_READY(checkpoint1);
+  AWAIT_READY(checkpoint2);
+  AWAIT_READY(checkpoint3);
+
+  EXPECT_SOME_EQ(slaveId, ::protobuf::read<SlaveID>("dir/id"));
+  EXPECT_SOME_EQ("new", os::read("dir/test"));
+
+  // The checkpoint fails if its directory cannot be created, without
+  // affecting the other checkpoints of the batch.
+  ASSERT_SOME(os::write("file", "content"));
+
+  checkpoint1 = checkpointer.checkpoint("file/test", "test");
+  checkpoint2 = checkpointer.checkpoint("dir/test", "newer");
+
+  AWAIT_FAILED(checkpoint1);
+  AWAIT_READY(checkpoint2);
+
+  EXPECT_SOME_EQ("content", os::read("file"));
+  EXPECT_SOME_EQ("newer", os::read("dir/test"));
+
+  // No temporary files are left behind.
+  Try<list<string>> entries = os::ls("dir");
+  ASSERT_SOME(entries);
+  EXPECT_EQ(2u, entries->size());
+}
+
+// This benchmark measures the time to recover the checkpointed state
+// of an agent whose executors have many historical (completed) runs,
+// each with a task that sent a couple of status updates.
+TEST_F(SlaveStateTest, BENCHMARK_Recover)
+{
+  struct Parameters
+  {
+    size_t executors;
+    size_t runs;
+  };
+
+  vector<Parameters> parameters = {{100, 10}, {100, 100}, {1000, 10}};
+
+  const vector<TaskState> taskStates = {TASK_RUNNING, TASK_FINISHED};
+
+  foreach (const Parameters& parameter, parameters) {
+    const string rootDir = path::join(
+        os::getcwd(),
+        "meta-" + stringify(parameter.executors) +
+        "-" + stringify(parameter.runs));
+
+    SlaveID slaveId;
+    slaveId.set_value("agent");
+
+    SlaveInfo slaveInfo;
+    slaveInfo.set_hostname("localhost");
+    slaveInfo.mutable_id()->CopyFrom(slaveId);
+
+    ASSERT_SOME(slave::state::checkpoint(
+        paths::getSlaveInfoPath(rootDir, slaveId), slaveInfo));
+
+    ASSERT_SOME(fs::symlink(
+        paths::getSlavePath(rootDir, slaveId),
+        paths::getLatestSlavePath(rootDir)));
+
+    FrameworkInfo frameworkInfo = DEFAULT_FRAMEWORK_INFO;
+    frameworkInfo.mutable_id()->set_value("framework");
+
+    const FrameworkID& frameworkId = frameworkInfo.id();
+
+    ASSERT_SOME(slave::state::checkpoint(
+        paths::getFrameworkInfoPath(rootDir, slaveId, frameworkId),
+        frameworkInfo));
+
+    ASSERT_SOME(slave::state::checkpoint(
+        paths::getFrameworkPidPath(rootDir, slaveId, frameworkId),
+        "scheduler@127.0.0.1:5050"));
+
+    for (size_t i = 0; i < parameter.executors; i++) {
+      ExecutorInfo executorInfo = createExecutorInfo(
+          "executor-" + stringify(i), "sleep 1000");
+
+      const ExecutorID& executorId = executorInfo.executor_id();
+
+      ASSERT_SOME(slave::state::checkpoint(
+          paths::getExecutorInfoPath(
+              rootDir, slaveId, frameworkId, executorId),
+          executorInfo));
+
+      // The last created run becomes the latest run of the executor.
+      for (size_t j = 0; j < parameter.runs; j++) {
+        ContainerID containerId;
+        containerId.set_value("run-" + stringify(j));
+
+        paths::createExecutorDirectory(
+            rootDir, slaveId, frameworkId, executorId, containerId);
+
+        ASSERT_SOME(slave::state::checkpoint(
+            paths::getForkedPidPath(
+                rootDir, slaveId, frameworkId, executorId, containerId),
+            "1"));
+
+        TaskInfo taskInfo = createTask(
+            slaveId, Resources::parse("cpus:0.1;mem:32").get(), "exit 0");
+
+        const Task task = mesos::internal::protobuf::createTask(
+            taskInfo, TASK_STAGING, frameworkId);
+
+        ASSERT_SOME(slave::state::checkpoint(
+            paths::getTaskInfoPath(
+                rootDir,
+                slaveId,
+                frameworkId,
+                executorId,
+                containerId,
+                task.task_id()),
+            task));
+
+        RepeatedPtrField<StatusUpdateRecord> records;
+        foreach (const TaskState& taskState, taskStates) {
+          const StatusUpdate update =
+            mesos::internal::protobuf::createStatusUpdate(
+                frameworkId,
+                slaveId,
+                task.task_id(),
+                taskState,
+                TaskStatus::SOURCE_EXECUTOR,
+                id::UUID::random());
+
+          StatusUpdateRecord* record = records.Add();
+          record->set_type(StatusUpdateRecord::UPDATE);
+          record->mutable_update()->CopyFrom(update);
+
+          record = records.Add();
+          record->set_type(StatusUpdateRecord::ACK);
+          record->set_uuid(update.uuid());
+        }
+
+        ASSERT_SOME(slave::state::checkpoint(
+            paths::getTaskUpdatesPath(
+                rootDir,
+                slaveId,
+                frameworkId,
+                executorId,
+                containerId,
+                task.task_id()),
+            records));
+
+        if (j + 1 < parameter.runs) {
+          ASSERT_SOME(os::touch(paths::getExecutorSentinelPath(
+              rootDir, slaveId, frameworkId, executorId, containerId)));
+        }
+      }
+    }
+
+    Stopwatch watch;
+    watch.start();
+
+    Try<slave::state::State> state = slave::state::recover(rootDir, true);
+
+    watch.stop();
+
+    ASSERT_SOME(state);
+    ASSERT_SOME(state->slave);
+    ASSERT_EQ(0u, state->errors);
+
+    const slave::state::FrameworkState& framework =
+      state->slave->frameworks.at(frameworkId);
+
+    ASSERT_EQ(parameter.executors, framework.executors.size());
+
+    foreachvalue (const slave::state::ExecutorState& executor,
+                  framework.executors) {
+      ASSERT_SOME(executor.latest);
+      ASSERT_EQ(parameter.runs, executor.runs.size());
+      EXPECT_EQ(1u, executor.runs.at(executor.latest.get()).tasks.size());
+    }
+
+    cout << "Recovered " << parameter.executors << " executors with "
+         << parameter.runs << " runs each in " << watch.elapsed() << endl;
+  }
+}
+
+
+// Checkpoints the state of an agent running a single task in the
+// latest run of its executor, with the given status update records.
+static void checkpointTask(
+    const string& rootDir,
+    const RepeatedPtrField<StatusUpdateRecord>& records)
+{
+  SlaveID slaveId;
+  slaveId.set_value("agent");
+
+  SlaveInfo slaveInfo;
+  slaveInfo.set_hostname("localhost");
+  slaveInfo.mutable_id()->CopyFrom(slaveId);
+
+  ASSERT_SOME(slave::state::checkpoint(
+      paths::getSlaveInfoPath(rootDir, slaveId), slaveInfo));
+
+  ASSERT_SOME(fs::symlink(
+      paths::getSlavePath(rootDir, slaveId),
+      paths::getLatestSlavePath(rootDir)));
+
+  FrameworkInfo frameworkInfo = DEFAULT_FRAMEWORK_INFO;
+  frameworkInfo.mutable_id()->set_value("framework");
+
+  const FrameworkID& frameworkId = frameworkInfo.id();
+
+  ASSERT_SOME(slave::state::checkpoint(
+      paths::getFrameworkInfoPath(rootDir, slaveId, frameworkId),
+      frameworkInfo));
+
+  ASSERT_SOME(slave::state::checkpoint(
+      paths::getFrameworkPidPath(rootDir, slaveId, frameworkId),
+      "scheduler@127.0.0.1:5050"));
+
+  const ExecutorInfo executorInfo = createExecutorInfo("executor", "sleep 1");
+  const ExecutorID& executorId = executorInfo.executor_id();
+
+  ASSERT_SOME(slave::state::checkpoint(
+      paths::getExecutorInfoPath(rootDir, slaveId, frameworkId, executorId),
+      executorInfo));
+
+  ContainerID containerId;
+  containerId.set_value("run");
+
+  paths::createExecutorDirectory(
+      rootDir, slaveId, frameworkId, executorId, containerId);
+
+  ASSERT_SOME(slave::state::checkpoint(
+      paths::getForkedPidPath(
+          rootDir, slaveId, frameworkId, executorId, containerId),
+      "1"));
+
+  ASSERT_FALSE(records.empty());
+  const TaskID& taskId = records.Get(0).update().status().task_id();
+
+  TaskInfo taskInfo = createTask(
+      slaveId, Resources::parse("cpus:0.1;mem:32").get(), "sleep 1");
+  taskInfo.mutable_task_id()->CopyFrom(taskId);
+
+  ASSERT_SOME(slave::state::checkpoint(
+      paths::getTaskInfoPath(
+          rootDir, slaveId, frameworkId, executorId, containerId, taskId),
+      mesos::internal::protobuf::createTask(
+          taskInfo, TASK_STAGING, frameworkId)));
+
+  ASSERT_SOME(slave::state::checkpoint(
+      paths::getTaskUpdatesPath(
+          rootDir, slaveId, frameworkId, executorId, containerId, taskId),
+      records));
+}
+
+
+// Returns the single task of the state checkpointed by `checkpointTask`.
+static Try<slave::state::TaskState> recoverTask(const string& rootDir)
+{
+  Try<slave::state::State> state = slave::state::recover(rootDir, true);
+  if (state.isError()) {
+    return Error(state.error());
+  }
+
+  CHECK_SOME(state->slave);
+  CHECK_EQ(1u, state->slave->frameworks.size());
+
+  const slave::state::FrameworkState& framework =
+    state->slave->frameworks.begin()->second;
+
+  CHECK_EQ(1u, framework.executors.size());
+
+  const slave::state::ExecutorState& executor =
+    framework.executors.begin()->second;
+
+  CHECK_SOME(executor.latest);
+
+  const slave::state::RunState& run = executor.runs.at(executor.latest.get());
+
+  CHECK_EQ(1u, run.tasks.size());
+
+  return run.tasks.begin()->second;
+}
+
+
+// Adds a status update of the given task to 'records', along with
+// its acknowledgement if 'acknowledged' is set.
+static StatusUpdate addStatusUpdate(
+    RepeatedPtrField<StatusUpdateRecord>* records,
+    const TaskID& taskId,
+    const TaskState& state,
+    bool acknowledged)
+{
+  FrameworkID frameworkId;
+  frameworkId.set_value("framework");
+
+  SlaveID slaveId;
+  slaveId.set_value("agent");
+
+  const StatusUpdate update = mesos::internal::protobuf::createStatusUpdate(
+      frameworkId,
+      slaveId,
+      taskId,
+      state,
+      TaskStatus::SOURCE_EXECUTOR,
+      id::UUID::random());
+
+  StatusUpdateRecord* record = records->Add();
+  record->set_type(StatusUpdateRecord::UPDATE);
+  record->mutable_update()->CopyFrom(update);
+
+  if (acknowledged) {
+    record = records->Add();
+    record->set_type(StatusUpdateRecord::ACK);
+    record->set_uuid(update.uuid());
+  }
+
+  return update;
+}
+
+
+// This test verifies that recovering the task status update manager
+// compacts the acknowledged status updates of a task, and that the
+// compacted updates are recovered to the same state: the latest
+// acknowledged update followed by the pending updates.
+TEST_F(SlaveStateTest, RecoverCompactedTaskStatusUpdates)
+{
+  const string rootDir = path::join(os::getcwd(), "meta");
+
+  TaskID taskId;
+  taskId.set_value("task");
+
+  RepeatedPtrField<StatusUpdateRecord> records;
+  addStatusUpdate(&records, taskId, TASK_STARTING, true);
+  addStatusUpdate(&records, taskId, TASK_RUNNING, true);
+
+  const StatusUpdate acknowledged =
+    addStatusUpdate(&records, taskId, TASK_RUNNING, true);
+  const StatusUpdate pending1 =
+    addStatusUpdate(&records, taskId, TASK_RUNNING, false);
+  const StatusUpdate pending2 =
+    addStatusUpdate(&records, taskId, TASK_FINISHED, false);
+
+  checkpointTask(rootDir, records);
+
+  Try<slave::state::State> state = slave::state::recover(rootDir, true);
+  ASSERT_SOME(state);
+
+  Try<slave::state::TaskState> task = recoverTask(rootDir);
+  ASSERT_SOME(task);
+  ASSERT_EQ(5u, task->updates.size());
+  ASSERT_EQ(3u, task->acks.size());
+
+  {
+    slave::Flags flags;
+    TaskStatusUpdateManager manager(flags);
+    manager.initialize([](const StatusUpdate&) {});
+
+    AWAIT_READY(manager.recover(rootDir, state->slave));
+  }
+
+  task = recoverTask(rootDir);
+  ASSERT_SOME(task);
+
+  ASSERT_EQ(3u, task->updates.size());
+  EXPECT_EQ(acknowledged.uuid(), task->updates[0].uuid());
+  EXPECT_EQ(pending1.uuid(), task->updates[1].uuid());
+  EXPECT_EQ(pending2.uuid(), task->updates[2].uuid());
+
+  EXPECT_EQ(
+      hashset<id::UUID>({id::UUID::fromBytes(acknowledged.uuid()).get()}),
+      task->acks);
+
+  // Recovering the compacted updates does not change them any further.
+  state = slave::state::recover(rootDir, true);
+  ASSERT_SOME(state);
+
+  {
+    slave::Flags flags;
+    TaskStatusUpdateManager manager(flags);
+    manager.initialize([](const StatusUpdate&) {});
+
+    AWAIT_READY(manager.recover(rootDir, state->slave));
+  }
+
+  Try<slave::state::TaskState> recovered = recoverTask(rootDir);
+  ASSERT_SOME(recovered);
+  ASSERT_EQ(task->updates.size(), recovered->updates.size());
+
+  for (size_t i = 0; i < task->updates.size(); i++) {
+    EXPECT_EQ(task->updates[i].uuid(), recovered->updates[i].uuid());
+  }
+
+  EXPECT_EQ(task->acks, recovered->acks);
+}
+
+
+// This test verifies that compacting the status updates of a task
+// never drops a terminal update, even if it is acknowledged.
+TEST_F(SlaveStateTest, CompactTaskStatusUpdatesKeepsTerminalUpdate)
+{
+  const string rootDir = path::join(os::getcwd(), "meta");
+
+  TaskID taskId;
+  taskId.set_value("task");
+
+  RepeatedPtrField<StatusUpdateRecord> records;
+  addStatusUpdate(&records, taskId, TASK_STARTING, true);
+
+  const StatusUpdate running =
+    addStatusUpdate(&records, taskId, TASK_RUNNING, true);
+  const StatusUpdate finished =
+    addStatusUpdate(&records, taskId, TASK_FINISHED, true);
+
+  checkpointTask(rootDir, records);
+
+  Try<slave::state::State> state = slave::state::recover(rootDir, true);
+  ASSERT_SOME(state);
+
+  {
+    slave::Flags flags;
+    TaskStatusUpdateManager manager(flags);
+    manager.initialize([](const StatusUpdate&) {});
+
+    AWAIT_READY(manager.recover(rootDir, state->slave));
+  }
+
+  Try<slave::state::TaskState> task = recoverTask(rootDir);
+  ASSERT_SOME(task);
+
+  // Only the acknowledged updates preceding the terminal update are
+  // compacted.
+  ASSERT_EQ(2u, task->updates.size());
+  EXPECT_EQ(running.uuid(), task->updates[0].uuid());
+  EXPECT_EQ(finished.uuid(), task->updates[1].uuid());
+  EXPECT_EQ(TASK_FINISHED, task->updates[1].status().state());
+
+  EXPECT_EQ(
+      hashset<id::UUID>({id::UUID::fromBytes(running.uuid()).get(),
+                         id::UUID::fromBytes(finished.uuid()).get()}),
+      task->acks);
+}
+
 
 template <typename T>
 class SlaveRecoveryTest : public ContainerizerTest<T>
@@ -3105,6 +3567,140 @@ TYPED_TEST(SlaveRecoveryTest, GCExecutor)
 }
 
 
+// The slave is stopped while an executor with a completed earlier run
+// is running. Recovery does not replay the tasks of the completed run,
+// but the run must still be garbage collected.
+TYPED_TEST(SlaveRecoveryTest, GCCompletedExecutorRun)
+{
+  Try<Owned<cluster::Master>> master = this->StartMaster();
+  ASSERT_SOME(master);
+
+  slave::Flags flags = this->CreateSlaveFlags();
+
+  Fetcher fetcher(flags);
+
+  Try<TypeParam*> _containerizer = TypeParam::create(flags, true, &fetcher);
+  ASSERT_SOME(_containerizer);
+  Owned<slave::Containerizer> containerizer(_containerizer.get());
+
+  Owned<MasterDetector> detector = master.get()->createDetector();
+
+  Try<Owned<cluster::Slave>> slave =
+    this->StartSlave(detector.get(), containerizer.get(), flags);
+  ASSERT_SOME(slave);
+
+  // Enable checkpointing for the framework.
+  FrameworkInfo frameworkInfo = DEFAULT_FRAMEWORK_INFO;
+  frameworkInfo.set_checkpoint(true);
+
+  MockScheduler sched;
+  MesosSchedulerDriver driver(
+      &sched, frameworkInfo, master.get()->pid, DEFAULT_CREDENTIAL);
+
+  EXPECT_CALL(sched, registered(_, _, _));
+
+  Future<vector<Offer>> offers;
+  EXPECT_CALL(sched, resourceOffers(_, _))
+    .WillOnce(FutureArg<1>(&offers))
+    .WillRepeatedly(Return()); // Ignore subsequent offers.
+
+  driver.start();
+
+  AWAIT_READY(offers);
+  ASSERT_FALSE(offers->empty());
+
+  TaskInfo task = createTask(offers.get()[0], "sleep 1000");
+
+  // Capture the slave and framework ids.
+  SlaveID slaveId = offers.get()[0].slave_id();
+  FrameworkID frameworkId = offers.get()[0].framework_id();
+
+  Future<RegisterExecutorMessage> registerExecutor =
+    FUTURE_PROTOBUF(RegisterExecutorMessage(), _, _);
+
+  Future<Nothing> status;
+  EXPECT_CALL(sched, statusUpdate(_, _))
+    .WillOnce(FutureSatisfy(&status))
+    .WillRepeatedly(Return()); // Ignore subsequent updates.
+
+  driver.launchTasks(offers.get()[0].id(), {task});
+
+  // Capture the executor id.
+  AWAIT_READY(registerExecutor);
+  ExecutorID executorId = registerExecutor->executor_id();
+
+  // Wait for TASK_STARTING update.
+  AWAIT_READY(status);
+
+  slave.get()->terminate();
+
+  // Add a completed earlier run of the executor, i.e., a run which is
+  // not the latest one and has a sentinel.
+  const string metaDir = paths::getMetaRootDir(flags.work_dir);
+
+  ContainerID completedId;
+  completedId.set_value(id::UUID::random().toString());
+
+  const string completedMetaDir = paths::getExecutorRunPath(
+      metaDir, slaveId, frameworkId, executorId, completedId);
+  const string completedWorkDir = paths::getExecutorRunPath(
+      flags.work_dir, slaveId, frameworkId, executorId, completedId);
+
+  ASSERT_SOME(os::mkdir(completedMetaDir));
+  ASSERT_SOME(os::mkdir(completedWorkDir));
+  ASSERT_SOME(os::touch(paths::getExecutorSentinelPath(
+      metaDir, slaveId, frameworkId, executorId, completedId)));
+
+  Future<Nothing> _recover = FUTURE_DISPATCH(_, &Slave::_recover);
+
+  Future<ReregisterExecutorMessage> reregisterExecutor =
+    FUTURE_PROTOBUF(ReregisterExecutorMessage(), _, _);
+
+  Future<SlaveReregisteredMessage> slaveReregisteredMessage =
+    FUTURE_PROTOBUF(SlaveReregisteredMessage(), _, _);
+
+  // Restart the slave (use same flags) with a new containerizer.
+  _containerizer = TypeParam::create(flags, true, &fetcher);
+  ASSERT_SOME(_containerizer);
+  containerizer.reset(_containerizer.get());
+
+  slave = this->StartSlave(detector.get(), containerizer.get(), flags);
+  ASSERT_SOME(slave);
+
+  // Ensure the executor re-registers, so that it is not killed once
+  // the slave considers itself recovered.
+  AWAIT_READY(reregisterExecutor);
+
+  Clock::pause();
+
+  AWAIT_READY(_recover);
+
+  Clock::settle(); // Wait for slave to schedule reregister timeout.
+
+  // Ensure the slave considers itself recovered.
+  Clock::advance(flags.executor_reregistration_timeout);
+
+  AWAIT_READY(slaveReregisteredMessage);
+
+  Clock::advance(flags.gc_delay);
+
+  Clock::settle();
+
+  // The completed run should be gc'ed by now, while the executor and
+  // its latest run are still around.
+  EXPECT_FALSE(os::exists(completedMetaDir));
+  EXPECT_FALSE(os::exists(completedWorkDir));
+
+  EXPECT_TRUE(os::exists(paths::getExecutorLatestRunPath(
+      metaDir, slaveId, frameworkId, executorId)));
+
+  Clock::resume();
+
+  driver.stop();
+  driver.join();
+}
+
+
 // The slave is asked to shutdown. When it comes back up, it should
 // re-register as the same agent.
 TYPED_TEST(SlaveRecoveryTest, ShutdownSlave)
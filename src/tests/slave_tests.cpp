@@ -2360,6 +2360,118 @@ TEST_F(SlaveTest, StatisticsEndpointMissingStatistics)
 }
 
 
+// This test verifies that the statistics endpoint is served from the
+// most recent usage sample when `--container_usage_sampling_interval`
+// is set, instead of querying the containerizer for every request.
+TEST_F(SlaveTest, StatisticsEndpointSampledUsage)
+{
+  Try<Owned<cluster::Master>> master = StartMaster();
+  ASSERT_SOME(master);
+
+  MockExecutor exec(DEFAULT_EXECUTOR_ID);
+  TestContainerizer containerizer(&exec);
+  StandaloneMasterDetector detector(master.get()->pid);
+
+  slave::Flags flags = CreateSlaveFlags();
+  flags.container_usage_sampling_interval = Seconds(10);
+
+  Try<Owned<cluster::Slave>> slave = StartSlave(
+      &detector,
+      &containerizer,
+      flags);
+
+  ASSERT_SOME(slave);
+
+  MockScheduler sched;
+  MesosSchedulerDriver driver(
+      &sched, DEFAULT_FRAMEWORK_INFO, master.get()->pid, DEFAULT_CREDENTIAL);
+
+  EXPECT_CALL(sched, registered(_, _, _));
+  EXPECT_CALL(exec, registered(_, _, _, _));
+
+  Future<vector<Offer>> offers;
+
+  EXPECT_CALL(sched, resourceOffers(&driver, _))
+    .WillOnce(FutureArg<1>(&offers))
+    .WillRepeatedly(Return()); // Ignore subsequent offers.
+
+  driver.start();
+
+  AWAIT_READY(offers);
+  ASSERT_FALSE(offers->empty());
+
+  const Offer& offer = offers.get()[0];
+
+  TaskInfo task = createTask(
+      offer.slave_id(),
+      Resources::parse("cpus:0.1;mem:32").get(),
+      SLEEP_COMMAND(1000),
+      exec.id);
+
+  EXPECT_CALL(exec, launchTask(_, _))
+    .WillOnce(SendStatusUpdateFromTask(TASK_RUNNING));
+
+  Future<TaskStatus> status;
+  EXPECT_CALL(sched, statusUpdate(&driver, _))
+    .WillOnce(FutureArg<1>(&status));
+
+  driver.launchTasks(offer.id(), {task});
+
+  AWAIT_READY(status);
+  EXPECT_EQ(TASK_RUNNING, status->state());
+
+  ResourceStatistics statistics;
+  statistics.set_timestamp(Clock::now().secs());
+  statistics.set_cpus_limit(2.5);
+
+  // The containerizer is only queried once, when the usage is sampled.
+  Future<Nothing> usage;
+  EXPECT_CALL(containerizer, usage(_))
+    .WillOnce(DoAll(FutureSatisfy(&usage),
+                    Return(statistics)));
+
+  Clock::pause();
+  Clock::advance(flags.container_usage_sampling_interval.get());
+
+  AWAIT_READY(usage);
+  Clock::settle();
+
+  for (int i = 0; i < 2; i++) {
+    Future<Response> response = process::http::get(
+        slave.get()->pid,
+        "monitor/statistics",
+        None(),
+        createBasicAuthHeaders(DEFAULT_CREDENTIAL));
+
+    AWAIT_EXPECT_RESPONSE_STATUS_EQ(OK().status, response);
+
+    Try<JSON::Value> value = JSON::parse(response->body);
+    ASSERT_SOME(value);
+
+    Try<JSON::Value> expected = JSON::parse(
+        "[{"
+            "\"statistics\":{"
+                "\"cpus_limit\":2.5"
+            "}"
+        "}]");
+
+    ASSERT_SOME(expected);
+    EXPECT_TRUE(value->contains(expected.get()));
+
+    // Let the statistics endpoint rate limiter admit the next request.
+    Clock::advance(Seconds(1));
+  }
+
+  Clock::resume();
+
+  EXPECT_CALL(exec, shutdown(_))
+    .Times(AtMost(1));
+
+  driver.stop();
+  driver.join();
+}
+
+
 // This test verifies the correct response of /monitor/statistics endpoint
 // when ResourceUsage collection fails.
 TEST_F(SlaveTest, StatisticsEndpointGetResourceUsageFailed)